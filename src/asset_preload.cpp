@@ -0,0 +1,75 @@
+#include "asset_preload.hpp"
+#include <unordered_map>
+
+struct PreloadedFile {
+    JobHandle job;
+    bool isSound;
+    Image image;
+    Wave wave;
+};
+
+// Entries are only added and looked up on the window thread; each job writes the image or wave of its own entry,
+// which stays put while the map grows
+static std::unordered_map<std::string, PreloadedFile> preloaded;
+static JobSystem* preloadJobs = nullptr;
+
+static void Preload(JobSystem& jobs, const std::string& fileName, bool isSound) {
+    if (preloaded.count(fileName)) return;
+    preloadJobs = &jobs;
+    PreloadedFile& file = preloaded[fileName];
+    file.isSound = isSound;
+    file.image = Image{};
+    file.wave = Wave{};
+
+    PreloadedFile* target = &file;
+    std::string path = fileName;
+    file.job = jobs.Run(fileName, [target, path, isSound]() {
+        if (isSound) target->wave = LoadWave(path.c_str());
+        else target->image = LoadImage(path.c_str());
+    });
+}
+
+static PreloadedFile* FindPreloaded(const char* fileName) {
+    auto found = preloaded.find(fileName);
+    if (found == preloaded.end()) return nullptr;
+    preloadJobs->Wait(found->second.job);
+    return &found->second;
+}
+
+void PreloadImages(JobSystem& jobs, const char* directory) {
+    FilePathList files = LoadDirectoryFilesEx(directory, ".png", true);
+    for (unsigned int i = 0; i < files.count; i++) Preload(jobs, files.paths[i], false);
+    TraceLog(LOG_INFO, "PRELOAD: Decoding %u images from %s on %i workers", files.count, directory, jobs.GetThreadCount());
+    UnloadDirectoryFiles(files);
+}
+
+void PreloadSounds(JobSystem& jobs, const std::vector<std::string>& fileNames) {
+    for (const std::string& fileName : fileNames) Preload(jobs, fileName, true);
+}
+
+Image LoadPreloadedImage(const char* fileName) {
+    PreloadedFile* file = FindPreloaded(fileName);
+    if (file == nullptr || file->isSound || !IsImageReady(file->image)) return LoadImage(fileName);
+    return ImageCopy(file->image);
+}
+
+Texture2D LoadPreloadedTexture(const char* fileName) {
+    PreloadedFile* file = FindPreloaded(fileName);
+    if (file == nullptr || file->isSound || !IsImageReady(file->image)) return LoadTexture(fileName);
+    return LoadTextureFromImage(file->image);
+}
+
+Sound LoadPreloadedSound(const char* fileName) {
+    PreloadedFile* file = FindPreloaded(fileName);
+    if (file == nullptr || !file->isSound || !IsWaveReady(file->wave)) return LoadSound(fileName);
+    return LoadSoundFromWave(file->wave);
+}
+
+void UnloadPreloaded(void) {
+    for (auto& entry : preloaded) {
+        preloadJobs->Wait(entry.second.job);
+        if (entry.second.isSound) UnloadWave(entry.second.wave);
+        else UnloadImage(entry.second.image);
+    }
+    preloaded.clear();
+}
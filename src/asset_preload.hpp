@@ -0,0 +1,20 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include "work_stealing.hpp"
+
+// Decodes images and sound effects on the job system while the game starts. Only the decoding runs on the workers:
+// textures and sounds are still created on the window thread, which owns the GL context and the audio device. A
+// file that was not preloaded is decoded on the spot, so the Load* calls below work either way.
+//
+// Window thread only.
+void PreloadImages(JobSystem& jobs, const char* directory);    // Every .png below directory
+void PreloadSounds(JobSystem& jobs, const std::vector<std::string>& fileNames);
+
+Image LoadPreloadedImage(const char* fileName);        // A copy, unload it as usual
+Texture2D LoadPreloadedTexture(const char* fileName);
+Sound LoadPreloadedSound(const char* fileName);
+
+// Waits for the decodes still running and frees them all, once the textures and sounds are loaded
+void UnloadPreloaded(void);
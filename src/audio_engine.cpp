@@ -0,0 +1,119 @@
+#include "audio_engine.hpp"
+#include <chrono>
+#include <cmath>
+
+AudioEngine::AudioEngine() : desiredTrack(TRACK_NONE), sounds(nullptr), running(false) {
+    for (int i = 0; i < TRACK_COUNT; i++) {
+        tracks[i] = Music{};
+        loaded[i] = false;
+        playing[i] = false;
+        levels[i] = 0.0f;
+    }
+}
+
+AudioEngine::~AudioEngine() {
+    Stop();
+}
+
+bool AudioEngine::LoadTrack(MusicTrack track, const char* fileName) {
+    if (track < 0 || track >= TRACK_COUNT || running) return false;
+    if (loaded[track]) {
+        DetachFromBus(tracks[track].stream, BUS_MUSIC);
+        UnloadMusicStream(tracks[track]);
+    }
+
+    // Only music streams get the large buffers, the default applies to every stream created while it is set
+    SetAudioStreamBufferSizeDefault(AUDIO_STREAM_BUFFER_FRAMES);
+    tracks[track] = LoadMusicStream(fileName);
+    SetAudioStreamBufferSizeDefault(0);
+
+    fileNames[track] = fileName;
+    loaded[track] = IsMusicReady(tracks[track]);
+    if (loaded[track]) AttachToBus(tracks[track].stream, BUS_MUSIC);
+    else TraceLog(LOG_WARNING, "AUDIO: Could not load %s", fileName);
+    return loaded[track];
+}
+
+void AudioEngine::LogMemoryReport() const {
+    size_t total = 0;
+    for (int i = 0; i < TRACK_COUNT; i++) {
+        if (!loaded[i]) continue;
+        const AudioStream& stream = tracks[i].stream;
+        size_t bytes = (size_t) 2 * AUDIO_STREAM_BUFFER_FRAMES * stream.channels * (stream.sampleSize / 8);
+        TraceLog(LOG_INFO, "AUDIO: %-40s %9zu bytes PCM in stream buffers", fileNames[i].c_str(), bytes);
+        total += bytes;
+    }
+    TraceLog(LOG_INFO, "AUDIO: Music streams, %zu bytes", total);
+}
+
+void AudioEngine::Start() {
+    if (running) return;
+    running = true;
+    thread = std::thread(&AudioEngine::Run, this);
+}
+
+void AudioEngine::Stop() {
+    if (running) {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            running = false;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    for (int i = 0; i < TRACK_COUNT; i++) {
+        if (!loaded[i]) continue;
+        if (playing[i]) StopMusicStream(tracks[i]);
+        DetachFromBus(tracks[i].stream, BUS_MUSIC);
+        UnloadMusicStream(tracks[i]);
+        loaded[i] = false;
+        playing[i] = false;
+        levels[i] = 0.0f;
+    }
+}
+
+void AudioEngine::Run() {
+    auto last = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running) {
+        wake.wait_for(lock, std::chrono::milliseconds(AUDIO_TICK_MS));
+        if (!running) break;
+        lock.unlock();
+
+        auto now = std::chrono::steady_clock::now();
+        Step(std::chrono::duration<float>(now - last).count());
+        last = now;
+
+        lock.lock();
+    }
+}
+
+void AudioEngine::Step(float seconds) {
+    int desired = desiredTrack.load(std::memory_order_relaxed);
+    float fadeStep = seconds * 1000.0f / AUDIO_CROSSFADE_MS;
+
+    for (int i = 0; i < TRACK_COUNT; i++) {
+        if (!loaded[i]) continue;
+        float target = (i == desired) ? 1.0f : 0.0f;
+        if (levels[i] < target) levels[i] = std::fmin(target, levels[i] + fadeStep);
+        else if (levels[i] > target) levels[i] = std::fmax(target, levels[i] - fadeStep);
+
+        if (levels[i] > 0.0f && !playing[i]) {
+            PlayMusicStream(tracks[i]);
+            playing[i] = true;
+        }
+        else if (levels[i] == 0.0f && playing[i]) {
+            StopMusicStream(tracks[i]);    // Also rewinds, a track comes back from its start
+            playing[i] = false;
+        }
+        if (!playing[i]) continue;
+
+        // Equal-power curve, so the crossfade does not dip in loudness halfway
+        SetMusicVolume(tracks[i], std::sin(levels[i] * 1.5707964f));
+        UpdateMusicStream(tracks[i]);
+    }
+
+    if (sounds != nullptr) sounds->Update();
+    UpdateMixer(seconds, sounds != nullptr && sounds->IsDuckingPlaying());
+}
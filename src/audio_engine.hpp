@@ -0,0 +1,65 @@
+#pragma once
+#include <raylib.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "sound_bank.hpp"
+
+// Music runs on its own thread, so a slow frame never starves a stream. Every track plays through BUS_MUSIC, see
+// mixer.hpp. The game only says which track should be playing; the audio thread fades the old one out and the new
+// one in, refills the decode buffers and stops (and rewinds) tracks once they are silent.
+//
+// Stream buffers are sized to ride out stalls of the audio thread itself: raylib keeps two sub-buffers per stream
+// and refills one while the other plays, so each holds more than AUDIO_STALL_MS of sound.
+#define AUDIO_STREAM_BUFFER_FRAMES 16384    // Per sub-buffer, 340 ms at 48 kHz
+#define AUDIO_STALL_MS 200
+#define AUDIO_TICK_MS 10                    // How often the audio thread refills and steps the fades
+#define AUDIO_CROSSFADE_MS 800
+
+enum MusicTrack {
+    TRACK_NONE = -1,
+    TRACK_MAIN_MENU = 0,
+    TRACK_SINGLEPLAYER,
+    TRACK_MULTIPLAYER,
+    TRACK_LOW_HEALTH,
+    TRACK_COUNT
+};
+
+class AudioEngine {
+    public:
+        AudioEngine();
+        ~AudioEngine();
+
+        // Before Start(), after InitAudioDevice()
+        bool LoadTrack(MusicTrack track, const char* fileName);
+        // Its compressed voices are refilled every tick, and its ducking sounds duck the music bus
+        void AttachSounds(SoundBank* bank) { sounds = bank; }
+
+        // Logs the stream buffers of every track, music decodes from the file so these are all it keeps in memory
+        void LogMemoryReport() const;
+
+        void Start();
+        void Stop();    // Joins the thread and unloads the tracks, call it before CloseAudioDevice()
+
+        // Game thread, lock-free. Picked up on the next tick, so calling it every frame costs nothing.
+        void SetDesiredTrack(MusicTrack track) { desiredTrack.store(track, std::memory_order_relaxed); }
+        MusicTrack GetDesiredTrack() const { return (MusicTrack) desiredTrack.load(std::memory_order_relaxed); }
+
+    private:
+        void Run();
+        void Step(float seconds);
+
+        Music tracks[TRACK_COUNT];
+        std::string fileNames[TRACK_COUNT];
+        bool loaded[TRACK_COUNT];
+        bool playing[TRACK_COUNT];
+        float levels[TRACK_COUNT];    // Fade position, 0 silent to 1 full volume
+        std::atomic<int> desiredTrack;
+        SoundBank* sounds;
+        std::thread thread;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        bool running;
+};
@@ -0,0 +1,230 @@
+#include "bots.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#define BOT_MAX_ROUNDS 10000    // Safety stop for profiles that never miss
+
+GameRules GetDefaultGameRules(void) {
+    return GameRules{20, PLAYER_START_HEALTH, true};
+}
+
+BotProfile GetBotProfile(BotLevel level) {
+    switch (level) {
+        case BOT_EASY:   return BotProfile{BOT_EASY,   {0.55f, 0.50f, 0.45f, 0.40f, 0.60f}, 7.0f, 0.45f};
+        case BOT_HARD:   return BotProfile{BOT_HARD,   {0.92f, 0.95f, 0.88f, 0.90f, 0.93f}, 2.5f, 0.30f};
+        default:         return BotProfile{BOT_MEDIUM, {0.75f, 0.72f, 0.68f, 0.65f, 0.78f}, 4.5f, 0.40f};
+    }
+}
+
+const char* GetBotLevelName(BotLevel level) {
+    static const char* names[BOT_LEVEL_COUNT] = {"easy", "medium", "hard"};
+    return (level >= 0 && level < BOT_LEVEL_COUNT) ? names[level] : "unknown";
+}
+
+bool ParseBotLevel(const char* text, BotLevel& level) {
+    for (int i = 0; i < BOT_LEVEL_COUNT; i++) {
+        if (strcmp(text, GetBotLevelName((BotLevel) i)) == 0) {
+            level = (BotLevel) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+BotPlayer::BotPlayer(const BotProfile& profile, uint64_t seed)
+    : profile(profile), random(seed), correctAnswerIndex(0), removedMask(0), knowsAnswer(false), answer(-1),
+      answerTimeNs(0), pending(false) {}
+
+void BotPlayer::StartQuestion(QuestionCategory category, int correctAnswerIndex, uint64_t startNs) {
+    // accuracy = known + (1 - known) / 4, a blind guess among four choices is right a quarter of the time
+    float accuracy = profile.accuracy[category];
+    float known = std::max(0.0f, (4.0f * accuracy - 1.0f) / 3.0f);
+
+    this->correctAnswerIndex = correctAnswerIndex;
+    removedMask = 0;
+    knowsAnswer = random.NextUnit() < known;
+    answer = knowsAnswer ? correctAnswerIndex : random.Range(0, 3);
+
+    // Box-Muller gives one standard normal sample, exp() of the scaled sample is log-normal around the median
+    double u1 = 1.0 - random.NextUnit();
+    double u2 = random.NextUnit();
+    double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    double seconds = profile.reactionMedianSeconds * std::exp(profile.reactionSigma * normal);
+
+    answerTimeNs = startNs + (uint64_t) (seconds * 1e9);
+    pending = true;
+}
+
+void BotPlayer::RemoveAnswers(int mask) {
+    removedMask |= mask & ~(1 << correctAnswerIndex);
+    if (knowsAnswer || !(removedMask & (1 << answer))) return;
+
+    int remaining[4];
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        if (!(removedMask & (1 << i))) remaining[count++] = i;
+    }
+    answer = remaining[random.NextBelow((uint32_t) count)];
+}
+
+bool BotPlayer::PollAction(int player, uint64_t nowNs, InputActionEvent& event) {
+    if (!pending || nowNs < answerTimeNs) return false;
+    pending = false;
+    event = InputActionEvent{(InputAction) (ACTION_ANSWER_1 + answer), player, answerTimeNs};
+    return true;
+}
+
+void ResetQuestionStats(std::vector<QuestionStats>& stats, size_t questionCount) {
+    stats.assign(questionCount, QuestionStats{0, 0, 0, 0});
+}
+
+void MergeQuestionStats(std::vector<QuestionStats>& into, const std::vector<QuestionStats>& from) {
+    if (into.size() < from.size()) into.resize(from.size(), QuestionStats{0, 0, 0, 0});
+    for (size_t i = 0; i < from.size(); i++) {
+        into[i].asked += from[i].asked;
+        into[i].correct += from[i].correct;
+        into[i].timeouts += from[i].timeouts;
+        into[i].correctReactionNs += from[i].correctReactionNs;
+    }
+}
+
+BotMatchStats SimulateBotMatch(std::vector<BotPlayer*>& bots, std::vector<Player>& players, const std::vector<Question>& questions,
+                               SessionRandom& random, const GameRules& rules, uint64_t timeResolutionNs,
+                               std::vector<QuestionStats>* questionStats) {
+    BotMatchStats stats{0, 0, 0, -1};
+    ResetPlayers(players, (int) bots.size());
+    for (Player& player : players) player.healthPoints = rules.startHealth;
+
+    uint64_t countdownNs = (uint64_t) rules.countdownSeconds * 1000000000ULL;
+    uint64_t roundStartNs = 0;
+    if (timeResolutionNs == 0) timeResolutionNs = 1;
+
+    while (!IsAnyPlayerOutOfHealth(players) && stats.rounds < BOT_MAX_ROUNDS) {
+        int questionIndex = random.Range(0, (int) questions.size() - 1);
+        int correctAnswerIndex = questions[questionIndex].correctAnswerIndex;
+        QuestionStats* questionStat = questionStats ? &(*questionStats)[questionIndex] : nullptr;
+        ResetPlayerAnswers(players);
+        stats.rounds++;
+
+        bool everyoneAnswered = true;
+        for (size_t i = 0; i < bots.size(); i++) {
+            bots[i]->StartQuestion(GetQuestionCategory(questionIndex), correctAnswerIndex, 0);
+            uint64_t reactionNs = bots[i]->GetAnswerTimeNs() / timeResolutionNs * timeResolutionNs;
+            if (questionStat) questionStat->asked++;
+            if (reactionNs >= countdownNs) {
+                everyoneAnswered = false;
+                if (questionStat) questionStat->timeouts++;
+                continue;
+            }
+            players[i].answer = bots[i]->GetAnswer();
+            players[i].selected = true;
+            players[i].answerTimeNs = roundStartNs + reactionNs;
+            if (questionStat && players[i].answer == correctAnswerIndex) {
+                questionStat->correct++;
+                questionStat->correctReactionNs += reactionNs;
+            }
+        }
+
+        if (!everyoneAnswered) {
+            for (Player& player : players) player.healthPoints--;
+            stats.timeouts++;
+        } else {
+            uint64_t fastestNs = UINT64_MAX;
+            int fastestCount = 0;
+            for (const Player& player : players) {
+                if (player.answer != correctAnswerIndex) continue;
+                if (player.answerTimeNs < fastestNs) fastestNs = player.answerTimeNs, fastestCount = 1;
+                else if (player.answerTimeNs == fastestNs) fastestCount++;
+            }
+            if (fastestCount > 1) stats.tiedFastest++;
+            EvaluateRound(players, correctAnswerIndex);
+        }
+        roundStartNs += countdownNs;
+    }
+
+    stats.winner = GetWinningPlayer(players);
+    return stats;
+}
+
+SingleplayerStats SimulateSingleplayerGame(BotPlayer& bot, const std::vector<Question>& questions, SessionRandom& questionOrder,
+                                           const GameRules& rules, std::vector<QuestionStats>* questionStats) {
+    SingleplayerStats stats{};
+    int health = rules.startHealth;
+    stats.maxHealth = health;
+
+    uint64_t countdownNs = (uint64_t) rules.countdownSeconds * 1000000000ULL;
+    bool available[ABILITY_COUNT];
+    for (int i = 0; i < ABILITY_COUNT; i++) available[i] = rules.abilities;
+
+    while (health > 0 && stats.questions < BOT_MAX_ROUNDS) {
+        int questionIndex = questionOrder.Range(0, (int) questions.size() - 1);
+        int correctAnswerIndex = questions[questionIndex].correctAnswerIndex;
+        QuestionStats* questionStat = questionStats ? &(*questionStats)[questionIndex] : nullptr;
+        stats.questions++;
+        if (questionStat) questionStat->asked++;
+
+        bot.StartQuestion(GetQuestionCategory(questionIndex), correctAnswerIndex, 0);
+        uint64_t reactionNs = bot.GetAnswerTimeNs();
+        bool bonusHealth = false;
+        int usedRemoval = -1;
+
+        if (bot.KnowsAnswer()) {
+            if (available[ABILITY_BONUS_HEALTH] && health < rules.startHealth) {
+                available[ABILITY_BONUS_HEALTH] = false;
+                stats.abilityUsed[ABILITY_BONUS_HEALTH] = true;
+                bonusHealth = true;
+            }
+        } else if (available[ABILITY_SKIP] && health <= 2) {
+            // Close to game over a free point beats a guess
+            available[ABILITY_SKIP] = false;
+            stats.abilityUsed[ABILITY_SKIP] = true;
+            if (reactionNs < countdownNs) {
+                stats.score++;
+                stats.abilityPaidOff[ABILITY_SKIP] = true;
+                stats.elapsedNs += reactionNs;
+                continue;
+            }
+        } else if (available[ABILITY_REMOVE_TWO] || available[ABILITY_REMOVE_ONE]) {
+            usedRemoval = available[ABILITY_REMOVE_TWO] ? ABILITY_REMOVE_TWO : ABILITY_REMOVE_ONE;
+            available[usedRemoval] = false;
+            stats.abilityUsed[usedRemoval] = true;
+
+            // Same draws as GetTwoWrongAnswersIndices and GetOneWrongAnswerIndex
+            int wrongAnswers[3];
+            int count = 0;
+            for (int i = 0; i < 4; i++) {
+                if (i != correctAnswerIndex) wrongAnswers[count++] = i;
+            }
+            questionOrder.SampleInPlace(wrongAnswers, count, usedRemoval == ABILITY_REMOVE_TWO ? 2 : 1);
+            int mask = 1 << wrongAnswers[0];
+            if (usedRemoval == ABILITY_REMOVE_TWO) mask |= 1 << wrongAnswers[1];
+            bot.RemoveAnswers(mask);
+        }
+
+        if (reactionNs >= countdownNs) {
+            health--;
+            stats.elapsedNs += countdownNs;
+            if (questionStat) questionStat->timeouts++;
+            continue;
+        }
+
+        stats.elapsedNs += reactionNs;
+        if (bot.GetAnswer() == correctAnswerIndex) {
+            stats.score++;
+            if (bonusHealth) {
+                health++;
+                stats.abilityPaidOff[ABILITY_BONUS_HEALTH] = true;
+            }
+            if (usedRemoval >= 0) stats.abilityPaidOff[usedRemoval] = true;
+            if (questionStat) {
+                questionStat->correct++;
+                questionStat->correctReactionNs += reactionNs;
+            }
+        } else {
+            health--;
+        }
+        stats.maxHealth = std::max(stats.maxHealth, health);
+    }
+    return stats;
+}
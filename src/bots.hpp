@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "input.hpp"
+#include "players.hpp"
+#include "questions.hpp"
+#include "session_random.hpp"
+
+enum BotLevel { BOT_EASY = 0, BOT_MEDIUM, BOT_HARD, BOT_LEVEL_COUNT };
+
+// The knobs of the game rules that balance testing turns, defaults match the game
+struct GameRules {
+    int countdownSeconds;    // Time to answer each question
+    int startHealth;         // Health every player starts with
+    bool abilities;          // Singleplayer's four once-per-game abilities (A, S, D, F)
+};
+
+GameRules GetDefaultGameRules(void);
+
+// Per-question counters collected by the simulations, indexed like the question table
+struct QuestionStats {
+    uint32_t asked;
+    uint32_t correct;
+    uint32_t timeouts;
+    uint64_t correctReactionNs;    // Sum over correct answers
+};
+
+// How a bot plays: the chance to pick the right answer per question category, and a log-normal reaction time
+struct BotProfile {
+    BotLevel level;
+    float accuracy[CATEGORY_COUNT];
+    float reactionMedianSeconds;    // exp(mu) of the log-normal
+    float reactionSigma;            // Spread of ln(reaction time)
+};
+
+BotProfile GetBotProfile(BotLevel level);
+const char* GetBotLevelName(BotLevel level);
+
+// Accepts "easy", "medium" or "hard"
+bool ParseBotLevel(const char* text, BotLevel& level);
+
+class BotPlayer {
+    public:
+        BotPlayer(const BotProfile& profile, uint64_t seed);
+
+        void Seed(uint64_t seed) { random.Seed(seed); }
+        const BotProfile& GetProfile() const { return profile; }
+
+        // Decides the answer and when it will be pressed as soon as the question is shown. A bot either knows the
+        // answer or guesses among the choices still on screen, tuned so the overall hit rate equals the accuracy.
+        void StartQuestion(QuestionCategory category, int correctAnswerIndex, uint64_t startNs);
+
+        // An ability took the answers in `removedMask` off the screen, a guessing bot re-picks among the rest
+        void RemoveAnswers(int removedMask);
+
+        bool KnowsAnswer() const { return knowsAnswer; }
+        int GetAnswer() const { return answer; }
+        uint64_t GetAnswerTimeNs() const { return answerTimeNs; }
+
+        // Hands out the answer press for `player` once it is due, at most once per question.
+        // The event carries the planned press time, so a bot is never penalized for the frame it is polled in.
+        bool PollAction(int player, uint64_t nowNs, InputActionEvent& event);
+
+    private:
+        BotProfile profile;
+        SessionRandom random;
+        int correctAnswerIndex;
+        int removedMask;
+        bool knowsAnswer;
+        int answer;
+        uint64_t answerTimeNs;
+        bool pending;
+};
+
+void ResetQuestionStats(std::vector<QuestionStats>& stats, size_t questionCount);
+void MergeQuestionStats(std::vector<QuestionStats>& into, const std::vector<QuestionStats>& from);
+
+struct BotMatchStats {
+    int rounds;
+    int timeouts;
+    int tiedFastest;    // Rounds where several correct answers shared the fastest time and the tie-break decided
+    int winner;         // GetWinningPlayer() at the end, -1 for a shared top score
+};
+
+// Plays one local multiplayer match between bots in simulated time with the game's rules: answers go through
+// EvaluateRound, and when someone has not answered before the countdown ends every player loses a health point.
+// Reaction times are rounded to `timeResolutionNs` so tie-breaks actually occur. `questionStats` may be null.
+BotMatchStats SimulateBotMatch(std::vector<BotPlayer*>& bots, std::vector<Player>& players, const std::vector<Question>& questions,
+                               SessionRandom& random, const GameRules& rules, uint64_t timeResolutionNs,
+                               std::vector<QuestionStats>* questionStats);
+
+enum BotAbility { ABILITY_REMOVE_TWO = 0, ABILITY_SKIP, ABILITY_BONUS_HEALTH, ABILITY_REMOVE_ONE, ABILITY_COUNT };
+
+struct SingleplayerStats {
+    int score;
+    int questions;
+    int maxHealth;
+    uint64_t elapsedNs;               // Simulated play time, breaks ties between equal scores
+    bool abilityUsed[ABILITY_COUNT];
+    bool abilityPaidOff[ABILITY_COUNT];    // Removal led to a correct answer, skip saved a point, bonus health landed
+};
+
+// Plays one singleplayer game until health runs out, with the same scoring as the SINGLEPLAYER screen: a correct
+// answer or a skip scores, a wrong answer or a timeout costs a health point, the bonus ability adds one back when
+// the round goes well. Bots use the abilities when unsure (removals, then skip when low on health) and the bonus
+// when they know the answer.
+SingleplayerStats SimulateSingleplayerGame(BotPlayer& bot, const std::vector<Question>& questions, SessionRandom& questionOrder,
+                                           const GameRules& rules, std::vector<QuestionStats>* questionStats);
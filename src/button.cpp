@@ -1,8 +1,9 @@
 #include "button.hpp"
+#include "asset_preload.hpp"
 
 Button::Button(const char* imagePath, Vector2 imagePosition, float scale)
 {
-    Image img = LoadImage(imagePath);
+    Image img = LoadPreloadedImage(imagePath);    // Usually decoded during startup already, see asset_preload.hpp
 
     int origWidth = img.width;
     int origHeight = img.height;
@@ -34,9 +35,15 @@ void Button::DrawButton(void) {
 
 // Draw Button and Center it Horizontally
 void Button::DrawButtonHorizontal(void) {
+    float x = (float) ((GetScreenWidth() - width * imgScale) / 2);
+    DrawTextureEx(texture, {x, position.y}, 0.0f, imgScale, WHITE);
+}
+
+// Moves the button to where DrawButtonHorizontal() draws it, so isClicked() matches before the first draw. Drawing
+// does not move the button, the game thread hit-tests it while the window thread draws.
+void Button::CenterHorizontally(void) {
     isDrawnHorizontal = true;
     position.x = (float) ((GetScreenWidth() - width * imgScale) / 2);
-    DrawTextureEx(texture, {position.x, position.y}, 0.0f, imgScale, WHITE);
 }
 
 bool Button::isClicked(Vector2 mousePos, bool mousePressed)
@@ -7,6 +7,7 @@ class Button {
         ~Button();
         void DrawButton();
         void DrawButtonHorizontal();
+        void CenterHorizontally();    // Once, before the button is drawn with DrawButtonHorizontal() or clicked
         bool isClicked(Vector2 mousePos, bool mousePressed), isDrawnHorizontal;
         float imgScale, width, height;
         Vector2 position;
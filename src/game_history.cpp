@@ -0,0 +1,353 @@
+#include "game_history.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "math_generator.hpp"
+#include "replay.hpp"
+#include "score_store.hpp"
+
+#define GAME_HISTORY_FRAME_SIZE 12       // Magic, payload length, CRC-32
+#define GAME_HISTORY_COUNTS_SIZE 9       // Version, result rows, answer rows
+#define GAME_HISTORY_RESULT_ROW_SIZE 23  // Bytes per result row over all result columns
+#define GAME_HISTORY_ANSWER_ROW_SIZE 9   // Bytes per answer row over all answer columns
+#define GAME_HISTORY_LATENCY_BINS 65536  // Milliseconds, longer answers land in the last bin
+#define SECONDS_PER_WEEK 604800
+#define FIRST_MONDAY 345600              // 1970-01-05 00:00 UTC
+
+void GameHistoryColumns::Clear() {
+    *this = GameHistoryColumns();
+}
+
+void GameHistoryColumns::Reserve(size_t resultRows, size_t answerRows) {
+    timestamp.reserve(resultRows);
+    mode.reserve(resultRows);
+    playerCount.reserve(resultRows);
+    score.reserve(resultRows);
+    health.reserve(resultRows);
+    abilities.reserve(resultRows);
+    answerCount.reserve(resultRows);
+    question.reserve(answerRows);
+    category.reserve(answerRows);
+    answer.reserve(answerRows);
+    correct.reserve(answerRows);
+    latencyMs.reserve(answerRows);
+}
+
+void GameHistoryColumns::Append(const GameHistoryGame& game) {
+    // Answer rows are stored grouped by player, right after each other for every result row
+    for (size_t player = 0; player < game.results.size(); player++) {
+        const GameHistoryResult& result = game.results[player];
+        uint32_t count = 0;
+        for (const GameHistoryAnswer& row : game.answers) {
+            if (row.player != player) continue;
+            question.push_back(row.question);
+            category.push_back((uint8_t) (row.question == GAME_HISTORY_GENERATED ? CATEGORY_MATH : GetQuestionCategory(row.question)));
+            answer.push_back(row.answer);
+            correct.push_back(row.correct ? 1 : 0);
+            latencyMs.push_back(row.latencyMs);
+            count++;
+        }
+        timestamp.push_back(game.timestamp);
+        mode.push_back(game.mode);
+        playerCount.push_back((uint8_t) game.results.size());
+        score.push_back(result.score);
+        health.push_back(result.health);
+        abilities.push_back(result.abilities);
+        answerCount.push_back(count);
+    }
+}
+
+bool BuildGameHistoryGame(const std::vector<uint8_t>& replayData, const std::vector<Question>& questions,
+                          int64_t timestamp, GameHistoryGame& game) {
+    ReplayReader reader(replayData);
+    if (!reader.IsValid()) return false;
+
+    game = GameHistoryGame{timestamp, REPLAY_SINGLEPLAYER, {}, {}};
+    std::vector<GameHistoryAnswer> round;    // This question's row per player, filled in as answers arrive
+    int correctAnswer = -1;
+    Question generated;
+    uint64_t questionNs = 0;
+    bool finished = false;
+
+    ReplayEvent event;
+    while (reader.Next(event)) {
+        bool hasPlayer = event.player < (int) game.results.size();
+        switch (event.type) {
+            case REPLAY_SESSION: {
+                game.mode = (uint8_t) (event.value & 1);
+                int players = (game.mode == REPLAY_SINGLEPLAYER) ? 1 : (int) (event.value >> 1);
+                game.results.assign(players, GameHistoryResult{0, 0, 0});
+                break;
+            }
+            case REPLAY_QUESTION: {
+                const Question* question = ResolveQuestion(questions, event.value, generated);
+                if (!question) return false;
+                correctAnswer = question->correctAnswerIndex;
+                uint16_t id = IsGeneratedQuestion(event.value) ? GAME_HISTORY_GENERATED : (uint16_t) event.value;
+                questionNs = event.timeNs;
+                round.clear();
+                for (size_t i = 0; i < game.results.size(); i++) {
+                    round.push_back(GameHistoryAnswer{(uint8_t) i, id, GAME_HISTORY_NO_ANSWER, false, 0});
+                }
+                break;
+            }
+            case REPLAY_ANSWER:
+                // The first press during the round counts, like in the game
+                if (event.player < (int) round.size() && event.value >= 0 && event.value < 4 &&
+                    round[event.player].answer == GAME_HISTORY_NO_ANSWER) {
+                    GameHistoryAnswer& row = round[event.player];
+                    row.answer = (int8_t) event.value;
+                    row.correct = event.value == correctAnswer;
+                    row.latencyMs = event.timeNs > questionNs ? (uint32_t) ((event.timeNs - questionNs) / 1000000) : 0;
+                }
+                break;
+            case REPLAY_ABILITY:
+                if (hasPlayer && event.value >= 0 && event.value < 8) game.results[event.player].abilities |= 1 << event.value;
+                break;
+            case REPLAY_ROUND_END:
+                game.answers.insert(game.answers.end(), round.begin(), round.end());
+                round.clear();
+                break;
+            case REPLAY_FINAL_SCORE:
+                if (hasPlayer) game.results[event.player].score = (int32_t) event.value;
+                break;
+            case REPLAY_FINAL_HEALTH:
+                if (hasPlayer) game.results[event.player].health = (int32_t) event.value;
+                finished = true;
+                break;
+            default:
+                break;
+        }
+    }
+    return finished;
+}
+
+template <typename T>
+static void AppendColumn(std::vector<uint8_t>& data, const std::vector<T>& column, size_t first, size_t count) {
+    for (size_t i = first; i < first + count; i++) {
+        uint64_t value = (uint64_t) column[i];
+        for (size_t byte = 0; byte < sizeof(T); byte++) data.push_back((uint8_t) (value >> (8 * byte)));
+    }
+}
+
+template <typename T>
+static const uint8_t* ReadColumn(const uint8_t* data, std::vector<T>& column, size_t count) {
+    size_t first = column.size();
+    column.resize(first + count);
+    T* values = column.data() + first;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = 0;
+        for (size_t byte = 0; byte < sizeof(T); byte++) value |= (uint64_t) data[byte] << (8 * byte);    // One load once optimized
+        values[i] = (T) value;
+        data += sizeof(T);
+    }
+    return data;
+}
+
+// One framed row group holding result rows [firstResult, firstResult + results) and their answer rows
+static void EncodeGroup(std::vector<uint8_t>& data, const GameHistoryColumns& columns, size_t firstResult, size_t results,
+                        size_t firstAnswer, size_t answers) {
+    std::vector<uint8_t> payload;
+    payload.reserve(GAME_HISTORY_COUNTS_SIZE + results * GAME_HISTORY_RESULT_ROW_SIZE + answers * GAME_HISTORY_ANSWER_ROW_SIZE);
+    payload.push_back(GAME_HISTORY_VERSION);
+    AppendU32(payload, (uint32_t) results);
+    AppendU32(payload, (uint32_t) answers);
+    AppendColumn(payload, columns.timestamp, firstResult, results);
+    AppendColumn(payload, columns.mode, firstResult, results);
+    AppendColumn(payload, columns.playerCount, firstResult, results);
+    AppendColumn(payload, columns.score, firstResult, results);
+    AppendColumn(payload, columns.health, firstResult, results);
+    AppendColumn(payload, columns.abilities, firstResult, results);
+    AppendColumn(payload, columns.answerCount, firstResult, results);
+    AppendColumn(payload, columns.question, firstAnswer, answers);
+    AppendColumn(payload, columns.category, firstAnswer, answers);
+    AppendColumn(payload, columns.answer, firstAnswer, answers);
+    AppendColumn(payload, columns.correct, firstAnswer, answers);
+    AppendColumn(payload, columns.latencyMs, firstAnswer, answers);
+
+    data.insert(data.end(), GAME_HISTORY_MAGIC, GAME_HISTORY_MAGIC + 4);
+    AppendU32(data, (uint32_t) payload.size());
+    AppendU32(data, Crc32(payload.data(), payload.size()));
+    data.insert(data.end(), payload.begin(), payload.end());
+}
+
+std::vector<uint8_t> EncodeGameHistoryGame(const GameHistoryGame& game) {
+    GameHistoryColumns columns;
+    columns.Append(game);
+    std::vector<uint8_t> data;
+    EncodeGroup(data, columns, 0, columns.ResultRows(), 0, columns.AnswerRows());
+    return data;
+}
+
+std::vector<uint8_t> EncodeGameHistory(const GameHistoryColumns& columns) {
+    std::vector<uint8_t> data;
+    data.reserve(columns.ResultRows() * GAME_HISTORY_RESULT_ROW_SIZE + columns.AnswerRows() * GAME_HISTORY_ANSWER_ROW_SIZE +
+                 (columns.ResultRows() / GAME_HISTORY_GROUP_ROWS + 1) * (GAME_HISTORY_FRAME_SIZE + GAME_HISTORY_COUNTS_SIZE));
+    size_t firstAnswer = 0;
+    for (size_t first = 0; first < columns.ResultRows(); first += GAME_HISTORY_GROUP_ROWS) {
+        size_t results = std::min((size_t) GAME_HISTORY_GROUP_ROWS, columns.ResultRows() - first);
+        size_t answers = 0;
+        for (size_t i = first; i < first + results; i++) answers += columns.answerCount[i];
+        EncodeGroup(data, columns, first, results, firstAnswer, answers);
+        firstAnswer += answers;
+    }
+    return data;
+}
+
+// Appends the row group at `offset` to `columns` when it is complete, consistent and matches its checksum
+static bool DecodeGroup(const uint8_t* data, size_t size, size_t offset, GameHistoryColumns& columns, size_t& groupSize) {
+    if (size - offset < GAME_HISTORY_FRAME_SIZE + GAME_HISTORY_COUNTS_SIZE) return false;
+    if (memcmp(data + offset, GAME_HISTORY_MAGIC, 4) != 0) return false;
+    uint32_t length = ReadU32(data + offset + 4);
+    if (length < GAME_HISTORY_COUNTS_SIZE || size - offset - GAME_HISTORY_FRAME_SIZE < length) return false;
+
+    const uint8_t* payload = data + offset + GAME_HISTORY_FRAME_SIZE;
+    if (payload[0] != GAME_HISTORY_VERSION) return false;
+    uint64_t results = ReadU32(payload + 1);
+    uint64_t answers = ReadU32(payload + 5);
+    if (length != GAME_HISTORY_COUNTS_SIZE + results * GAME_HISTORY_RESULT_ROW_SIZE + answers * GAME_HISTORY_ANSWER_ROW_SIZE) return false;
+    if (Crc32(payload, length) != ReadU32(data + offset + 8)) return false;
+
+    // Checked before anything is appended, so a bad group leaves the columns untouched
+    const uint8_t* answerCounts = payload + GAME_HISTORY_COUNTS_SIZE + results * (GAME_HISTORY_RESULT_ROW_SIZE - 4);
+    const uint8_t* categories = payload + GAME_HISTORY_COUNTS_SIZE + results * GAME_HISTORY_RESULT_ROW_SIZE + answers * 2;
+    uint64_t countedAnswers = 0;
+    for (uint64_t i = 0; i < results; i++) countedAnswers += ReadU32(answerCounts + 4 * i);
+    if (countedAnswers != answers) return false;
+    for (uint64_t i = 0; i < answers; i++) if (categories[i] >= CATEGORY_COUNT) return false;
+
+    const uint8_t* column = payload + GAME_HISTORY_COUNTS_SIZE;
+    column = ReadColumn(column, columns.timestamp, results);
+    column = ReadColumn(column, columns.mode, results);
+    column = ReadColumn(column, columns.playerCount, results);
+    column = ReadColumn(column, columns.score, results);
+    column = ReadColumn(column, columns.health, results);
+    column = ReadColumn(column, columns.abilities, results);
+    column = ReadColumn(column, columns.answerCount, results);
+    column = ReadColumn(column, columns.question, answers);
+    column = ReadColumn(column, columns.category, answers);
+    column = ReadColumn(column, columns.answer, answers);
+    column = ReadColumn(column, columns.correct, answers);
+    ReadColumn(column, columns.latencyMs, answers);
+
+    groupSize = GAME_HISTORY_FRAME_SIZE + length;
+    return true;
+}
+
+GameHistoryContents ParseGameHistory(const uint8_t* data, size_t size) {
+    GameHistoryContents contents{GameHistoryColumns(), 0, 0};
+
+    // Size the columns from the frame headers first, regrowing hundreds of megabytes of columns costs more than
+    // decoding them. Corrupt frames are only found below, so this stops at the first frame that looks wrong.
+    size_t resultRows = 0, answerRows = 0;
+    for (size_t offset = 0; size - offset >= GAME_HISTORY_FRAME_SIZE + GAME_HISTORY_COUNTS_SIZE;) {
+        uint32_t length = ReadU32(data + offset + 4);
+        if (memcmp(data + offset, GAME_HISTORY_MAGIC, 4) != 0 || size - offset - GAME_HISTORY_FRAME_SIZE < length) break;
+        resultRows += ReadU32(data + offset + GAME_HISTORY_FRAME_SIZE + 1);
+        answerRows += ReadU32(data + offset + GAME_HISTORY_FRAME_SIZE + 5);
+        offset += GAME_HISTORY_FRAME_SIZE + length;
+    }
+    contents.columns.Reserve(std::min(resultRows, size / GAME_HISTORY_RESULT_ROW_SIZE), std::min(answerRows, size / GAME_HISTORY_ANSWER_ROW_SIZE));
+
+    size_t offset = 0;
+    while (offset < size) {
+        size_t groupSize = 0;
+        if (DecodeGroup(data, size, offset, contents.columns, groupSize)) {
+            offset += groupSize;
+            contents.groups++;
+            continue;
+        }
+
+        // Skip to the next magic, a torn or corrupt group costs only itself
+        const uint8_t* next = nullptr;
+        for (size_t i = offset + 1; i + 4 <= size && !next; i++) {
+            if (memcmp(data + i, GAME_HISTORY_MAGIC, 4) == 0) next = data + i;
+        }
+        size_t resume = next ? (size_t) (next - data) : size;
+        contents.droppedBytes += resume - offset;
+        offset = resume;
+    }
+    return contents;
+}
+
+static int64_t WeekIndex(int64_t timestamp) {
+    int64_t sinceMonday = timestamp - FIRST_MONDAY;
+    return (sinceMonday >= 0) ? sinceMonday / SECONDS_PER_WEEK : -((-sinceMonday + SECONDS_PER_WEEK - 1) / SECONDS_PER_WEEK);
+}
+
+std::vector<WeeklyScore> AverageScorePerWeek(const GameHistoryColumns& columns, int mode) {
+    size_t rows = columns.ResultRows();
+    const int64_t* timestamps = columns.timestamp.data();
+    const uint8_t* modes = columns.mode.data();
+    const int32_t* scores = columns.score.data();
+
+    int64_t newest = INT64_MIN;
+    for (size_t i = 0; i < rows; i++) {
+        if ((mode < 0 || modes[i] == mode) && timestamps[i] > newest) newest = timestamps[i];
+    }
+    if (newest == INT64_MIN) return {};
+
+    // Dense per-week sums: one division and two adds per row, no lookups
+    int64_t lastWeek = WeekIndex(newest);
+    std::vector<int64_t> sums(GAME_HISTORY_MAX_WEEKS, 0);
+    std::vector<uint32_t> counts(GAME_HISTORY_MAX_WEEKS, 0);
+    for (size_t i = 0; i < rows; i++) {
+        int64_t slot = WeekIndex(timestamps[i]) - lastWeek + GAME_HISTORY_MAX_WEEKS - 1;
+        if ((mode >= 0 && modes[i] != mode) || slot < 0) continue;
+        sums[slot] += scores[i];
+        counts[slot]++;
+    }
+
+    std::vector<WeeklyScore> weeks;
+    for (int slot = 0; slot < GAME_HISTORY_MAX_WEEKS; slot++) {
+        if (counts[slot] == 0) continue;
+        int64_t week = lastWeek - (GAME_HISTORY_MAX_WEEKS - 1) + slot;
+        weeks.push_back(WeeklyScore{FIRST_MONDAY + week * SECONDS_PER_WEEK, counts[slot], (double) sums[slot] / counts[slot]});
+    }
+    return weeks;
+}
+
+CategoryAccuracy AccuracyPerCategory(const GameHistoryColumns& columns) {
+    // One histogram over (category, correct) pairs instead of a branch per row
+    uint64_t histogram[CATEGORY_COUNT * 2] = {};
+    size_t rows = columns.AnswerRows();
+    const uint8_t* categories = columns.category.data();
+    const uint8_t* correct = columns.correct.data();
+    for (size_t i = 0; i < rows; i++) histogram[categories[i] * 2 + (correct[i] != 0)]++;
+
+    CategoryAccuracy accuracy;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        accuracy.asked[i] = histogram[i * 2] + histogram[i * 2 + 1];
+        accuracy.correct[i] = histogram[i * 2 + 1];
+    }
+    return accuracy;
+}
+
+std::vector<uint32_t> AnswerTimePercentiles(const GameHistoryColumns& columns, const std::vector<double>& percentiles) {
+    // A histogram at millisecond resolution gives exact percentiles in one pass, without sorting. Unanswered rows
+    // are counted in an extra bin past the end instead of branching on them.
+    std::vector<uint64_t> bins(GAME_HISTORY_LATENCY_BINS + 1, 0);
+    size_t rows = columns.AnswerRows();
+    const int8_t* answers = columns.answer.data();
+    const uint32_t* latencies = columns.latencyMs.data();
+    for (size_t i = 0; i < rows; i++) {
+        uint32_t bin = std::min(latencies[i], (uint32_t) GAME_HISTORY_LATENCY_BINS - 1);
+        bins[answers[i] == GAME_HISTORY_NO_ANSWER ? GAME_HISTORY_LATENCY_BINS : bin]++;
+    }
+    uint64_t answered = rows - bins[GAME_HISTORY_LATENCY_BINS];
+
+    // Nearest rank: the smallest time with at least `percentile` percent of the answers at or below it
+    std::vector<uint32_t> times;
+    for (double percentile : percentiles) {
+        if (answered == 0) {
+            times.push_back(0);
+            continue;
+        }
+        uint64_t rank = std::max((uint64_t) 1, (uint64_t) std::ceil(percentile / 100.0 * answered));
+        uint64_t seen = 0;
+        uint32_t ms = 0;
+        while (ms < GAME_HISTORY_LATENCY_BINS - 1 && seen + bins[ms] < rank) seen += bins[ms++];
+        times.push_back(ms);
+    }
+    return times;
+}
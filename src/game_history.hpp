@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "questions.hpp"
+
+// Append-only history of every finished local game, stored by column. The file is a sequence of row groups:
+//   "BBGH" | u32 payload length | u32 CRC-32 of the payload | payload
+// and the payload is u8 version, u32 result rows, u32 answer rows, then each column below as one contiguous
+// little endian array in declaration order. A game over appends one small row group; "history-query --compact"
+// merges them into large ones. Each row group carries its own magic, so a torn or corrupt group is skipped by
+// scanning to the next one and appending never needs a file header.
+#define GAME_HISTORY_FILE_PATH "data/game-history.bgh"
+#define GAME_HISTORY_MAGIC "BBGH"
+#define GAME_HISTORY_VERSION 1
+#define GAME_HISTORY_GROUP_ROWS 65536    // Result rows per row group after compaction
+#define GAME_HISTORY_NO_ANSWER -1        // Answer column value for timeouts and skipped questions
+#define GAME_HISTORY_GENERATED 0xFFFF    // Question column value of generated math questions, see math_generator.hpp
+#define GAME_HISTORY_MAX_WEEKS 65536
+
+struct GameHistoryResult {
+    int32_t score;
+    int32_t health;
+    uint8_t abilities;    // Bit n set when ability n (A, S, D, F) was used
+};
+
+struct GameHistoryAnswer {
+    uint8_t player;
+    uint16_t question;
+    int8_t answer;
+    bool correct;
+    uint32_t latencyMs;    // From the question appearing to the press, 0 without an answer
+};
+
+struct GameHistoryGame {
+    int64_t timestamp;    // Unix seconds at game over
+    uint8_t mode;         // ReplayMode
+    std::vector<GameHistoryResult> results;    // One per player
+    std::vector<GameHistoryAnswer> answers;    // One per player per question that ended, in question order
+};
+
+// The whole history in memory, one vector per column so aggregates scan only the columns they need
+struct GameHistoryColumns {
+    // One row per player per game
+    std::vector<int64_t> timestamp;
+    std::vector<uint8_t> mode;
+    std::vector<uint8_t> playerCount;
+    std::vector<int32_t> score;
+    std::vector<int32_t> health;
+    std::vector<uint8_t> abilities;
+    std::vector<uint32_t> answerCount;    // Answer rows belonging to this result row, in order
+
+    // One row per player per question
+    std::vector<uint16_t> question;
+    std::vector<uint8_t> category;        // QuestionCategory, stored so queries need no question table
+    std::vector<int8_t> answer;
+    std::vector<uint8_t> correct;
+    std::vector<uint32_t> latencyMs;
+
+    size_t ResultRows() const { return score.size(); }
+    size_t AnswerRows() const { return latencyMs.size(); }
+    void Clear();
+    void Reserve(size_t resultRows, size_t answerRows);
+    void Append(const GameHistoryGame& game);
+};
+
+struct GameHistoryContents {
+    GameHistoryColumns columns;
+    size_t groups;
+    size_t droppedBytes;    // Bytes outside a good row group (torn tail, corruption)
+};
+
+// Builds the history row of a finished game from its replay log. Only questions whose round ended are counted,
+// so the question drawn after the final round is left out. Returns false for a log without a final state.
+bool BuildGameHistoryGame(const std::vector<uint8_t>& replayData, const std::vector<Question>& questions,
+                          int64_t timestamp, GameHistoryGame& game);
+
+std::vector<uint8_t> EncodeGameHistoryGame(const GameHistoryGame& game);    // One row group to append
+
+// The whole table as row groups of GAME_HISTORY_GROUP_ROWS result rows, used for compaction
+std::vector<uint8_t> EncodeGameHistory(const GameHistoryColumns& columns);
+
+// Bounds- and checksum-checks every row group, whatever the input
+GameHistoryContents ParseGameHistory(const uint8_t* data, size_t size);
+
+// Aggregates for the operator dashboard. Each one reads only the columns it needs, in tight loops over the arrays.
+struct WeeklyScore {
+    int64_t weekStart;    // Unix seconds, Monday 00:00 UTC
+    uint32_t results;
+    double averageScore;
+};
+
+// `mode` is a ReplayMode, or -1 for every game. Weeks without results are left out, and so are results more than
+// GAME_HISTORY_MAX_WEEKS weeks older than the newest one.
+std::vector<WeeklyScore> AverageScorePerWeek(const GameHistoryColumns& columns, int mode);
+
+struct CategoryAccuracy {
+    uint64_t asked[CATEGORY_COUNT];
+    uint64_t correct[CATEGORY_COUNT];
+};
+
+CategoryAccuracy AccuracyPerCategory(const GameHistoryColumns& columns);
+
+// Answer times at each of `percentiles` (0-100) over answered questions, exact to the millisecond. 0 without answers.
+std::vector<uint32_t> AnswerTimePercentiles(const GameHistoryColumns& columns, const std::vector<double>& percentiles);
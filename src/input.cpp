@@ -0,0 +1,236 @@
+#include "input.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "raylib.h"
+
+#define MAX_KEY_CODE 350     // GLFW key codes stop at KEY_KB_MENU (348)
+#define MAX_MOUSE_CODE 8
+
+struct ActionName {
+    InputAction action;
+    const char* name;
+};
+
+static const ActionName actionNames[] = {
+    {ACTION_ANSWER_1, "ANSWER_1"}, {ACTION_ANSWER_2, "ANSWER_2"}, {ACTION_ANSWER_3, "ANSWER_3"}, {ACTION_ANSWER_4, "ANSWER_4"},
+    {ACTION_ABILITY_1, "ABILITY_1"}, {ACTION_ABILITY_2, "ABILITY_2"}, {ACTION_ABILITY_3, "ABILITY_3"}, {ACTION_ABILITY_4, "ABILITY_4"},
+    {ACTION_CLICK, "CLICK"}, {ACTION_BACK, "BACK"}, {ACTION_CONFIRM, "CONFIRM"}, {ACTION_ERASE, "ERASE"},
+    {ACTION_NEXT_PLAYER, "NEXT_PLAYER"}, {ACTION_ADD_PLAYER, "ADD_PLAYER"}, {ACTION_REMOVE_PLAYER, "REMOVE_PLAYER"},
+    {ACTION_PREVIOUS_PAGE, "PREVIOUS_PAGE"}, {ACTION_NEXT_PAGE, "NEXT_PAGE"},
+    {ACTION_PRACTICE, "PRACTICE"}
+};
+
+static void AddGamepadAnswerBindings(std::vector<InputBinding>& bindings) {
+    // Gamepad N plays as player N with the four face buttons
+    for (int gamepad = 0; gamepad < 8; gamepad++) {
+        bindings.push_back(InputBinding{ACTION_ANSWER_1, gamepad, DEVICE_GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_UP, gamepad});
+        bindings.push_back(InputBinding{ACTION_ANSWER_2, gamepad, DEVICE_GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, gamepad});
+        bindings.push_back(InputBinding{ACTION_ANSWER_3, gamepad, DEVICE_GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_LEFT, gamepad});
+        bindings.push_back(InputBinding{ACTION_ANSWER_4, gamepad, DEVICE_GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, gamepad});
+    }
+}
+
+std::vector<InputBinding> GetDefaultInputBindings(void) {
+    std::vector<InputBinding> bindings = {
+        // Keyboard zones: Player 1 answers on Q-W-E-R, Player 2 on U-I-O-P, Player 3 on Z-X-C-V, Player 4 on numpad 1-4
+        {ACTION_ANSWER_1, 0, DEVICE_KEYBOARD, KEY_Q, 0}, {ACTION_ANSWER_2, 0, DEVICE_KEYBOARD, KEY_W, 0},
+        {ACTION_ANSWER_3, 0, DEVICE_KEYBOARD, KEY_E, 0}, {ACTION_ANSWER_4, 0, DEVICE_KEYBOARD, KEY_R, 0},
+        {ACTION_ANSWER_1, 1, DEVICE_KEYBOARD, KEY_U, 0}, {ACTION_ANSWER_2, 1, DEVICE_KEYBOARD, KEY_I, 0},
+        {ACTION_ANSWER_3, 1, DEVICE_KEYBOARD, KEY_O, 0}, {ACTION_ANSWER_4, 1, DEVICE_KEYBOARD, KEY_P, 0},
+        {ACTION_ANSWER_1, 2, DEVICE_KEYBOARD, KEY_Z, 0}, {ACTION_ANSWER_2, 2, DEVICE_KEYBOARD, KEY_X, 0},
+        {ACTION_ANSWER_3, 2, DEVICE_KEYBOARD, KEY_C, 0}, {ACTION_ANSWER_4, 2, DEVICE_KEYBOARD, KEY_V, 0},
+        {ACTION_ANSWER_1, 3, DEVICE_KEYBOARD, KEY_KP_1, 0}, {ACTION_ANSWER_2, 3, DEVICE_KEYBOARD, KEY_KP_2, 0},
+        {ACTION_ANSWER_3, 3, DEVICE_KEYBOARD, KEY_KP_3, 0}, {ACTION_ANSWER_4, 3, DEVICE_KEYBOARD, KEY_KP_4, 0},
+
+        // Singleplayer abilities on A-S-D-F
+        {ACTION_ABILITY_1, 0, DEVICE_KEYBOARD, KEY_A, 0}, {ACTION_ABILITY_2, 0, DEVICE_KEYBOARD, KEY_S, 0},
+        {ACTION_ABILITY_3, 0, DEVICE_KEYBOARD, KEY_D, 0}, {ACTION_ABILITY_4, 0, DEVICE_KEYBOARD, KEY_F, 0},
+
+        {ACTION_BACK, 0, DEVICE_KEYBOARD, KEY_ESCAPE, 0},
+        {ACTION_CONFIRM, 0, DEVICE_KEYBOARD, KEY_ENTER, 0},
+        {ACTION_ERASE, 0, DEVICE_KEYBOARD, KEY_BACKSPACE, 0},
+        {ACTION_NEXT_PLAYER, 0, DEVICE_KEYBOARD, KEY_TAB, 0},
+        {ACTION_ADD_PLAYER, 0, DEVICE_KEYBOARD, KEY_UP, 0},
+        {ACTION_REMOVE_PLAYER, 0, DEVICE_KEYBOARD, KEY_DOWN, 0},
+        {ACTION_PREVIOUS_PAGE, 0, DEVICE_KEYBOARD, KEY_LEFT, 0}, {ACTION_PREVIOUS_PAGE, 0, DEVICE_KEYBOARD, KEY_PAGE_UP, 0},
+        {ACTION_NEXT_PAGE, 0, DEVICE_KEYBOARD, KEY_RIGHT, 0}, {ACTION_NEXT_PAGE, 0, DEVICE_KEYBOARD, KEY_PAGE_DOWN, 0},
+        {ACTION_PRACTICE, 0, DEVICE_KEYBOARD, KEY_TAB, 0},
+        {ACTION_CLICK, 0, DEVICE_MOUSE, MOUSE_BUTTON_LEFT, 0},
+
+        {ACTION_BACK, 0, DEVICE_GAMEPAD, GAMEPAD_BUTTON_MIDDLE_RIGHT, 0},
+        {ACTION_CONFIRM, 0, DEVICE_GAMEPAD, GAMEPAD_BUTTON_MIDDLE_LEFT, 0},
+        {ACTION_PREVIOUS_PAGE, 0, DEVICE_GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_LEFT, 0},
+        {ACTION_NEXT_PAGE, 0, DEVICE_GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_RIGHT, 0},
+        {ACTION_PRACTICE, 0, DEVICE_GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_UP, 0}
+    };
+
+    AddGamepadAnswerBindings(bindings);
+    return bindings;
+}
+
+std::vector<InputBinding> LoadInputBindings(const char* filename) {
+    std::vector<InputBinding> bindings;
+    std::ifstream file(filename);
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string actionName, deviceName;
+        InputBinding binding{ACTION_NONE, 0, DEVICE_KEYBOARD, 0, 0};
+        if (!(fields >> actionName >> binding.player >> deviceName >> binding.code)) continue;
+        fields >> binding.gamepad;
+
+        for (const ActionName& entry : actionNames) {
+            if (actionName == entry.name) binding.action = entry.action;
+        }
+        if (deviceName == "KEY") binding.device = DEVICE_KEYBOARD;
+        else if (deviceName == "MOUSE") binding.device = DEVICE_MOUSE;
+        else if (deviceName == "GAMEPAD") binding.device = DEVICE_GAMEPAD;
+        else continue;
+
+        if (binding.action != ACTION_NONE && binding.player >= 0) bindings.push_back(binding);
+    }
+
+    if (bindings.empty()) return GetDefaultInputBindings();
+    TraceLog(LOG_INFO, "INPUT: Loaded %i input bindings from %s", (int) bindings.size(), filename);
+    return bindings;
+}
+
+void ClearInputFrame(InputFrame& frame) {
+    frame.actionCount = 0;
+    frame.charCount = 0;
+    frame.anyInputPressed = false;
+    frame.clicked = false;
+    frame.mouseX = 0.0f;
+    frame.mouseY = 0.0f;
+}
+
+void AppendInputFrame(InputFrame& frame, const InputFrame& later) {
+    for (int i = 0; i < later.actionCount && frame.actionCount < INPUT_FRAME_ACTIONS; i++) {
+        frame.actions[frame.actionCount++] = later.actions[i];
+    }
+    for (int i = 0; i < later.charCount && frame.charCount < INPUT_FRAME_CHARS; i++) {
+        frame.chars[frame.charCount++] = later.chars[i];
+    }
+    frame.anyInputPressed = frame.anyInputPressed || later.anyInputPressed;
+    if (!frame.clicked) {
+        frame.clicked = later.clicked;
+        frame.mouseX = later.mouseX;
+        frame.mouseY = later.mouseY;
+    }
+}
+
+InputDispatcher::InputDispatcher(const std::vector<InputBinding>& bindings) {
+    anyInputPressed = false;
+    actions.reserve(64);
+    SetBindings(bindings);
+}
+
+void InputDispatcher::SetBindings(const std::vector<InputBinding>& newBindings) {
+    bindings = newBindings;
+    keyboardHeads.assign(MAX_KEY_CODE, -1);
+    mouseHeads.assign(MAX_MOUSE_CODE, -1);
+    nextBinding.assign(bindings.size(), -1);
+    gamepadBindings.clear();
+
+    // Build per-code chains so one raw event resolves to its actions without scanning the whole table
+    for (int i = (int) bindings.size() - 1; i >= 0; i--) {
+        const InputBinding& binding = bindings[i];
+        std::vector<int>* heads = nullptr;
+        if (binding.device == DEVICE_KEYBOARD && binding.code >= 0 && binding.code < MAX_KEY_CODE) heads = &keyboardHeads;
+        else if (binding.device == DEVICE_MOUSE && binding.code >= 0 && binding.code < MAX_MOUSE_CODE) heads = &mouseHeads;
+        else if (binding.device == DEVICE_GAMEPAD) gamepadBindings.push_back(i);
+
+        if (heads != nullptr) {
+            nextBinding[i] = (*heads)[binding.code];
+            (*heads)[binding.code] = i;
+        }
+    }
+}
+
+void InputDispatcher::Dispatch(int device, int code, uint64_t timestampNs) {
+    const std::vector<int>& heads = (device == DEVICE_MOUSE) ? mouseHeads : keyboardHeads;
+    if (code < 0 || code >= (int) heads.size()) return;
+
+    for (int i = heads[code]; i != -1; i = nextBinding[i]) {
+        actions.push_back(InputActionEvent{bindings[i].action, bindings[i].player, timestampNs});
+    }
+}
+
+void InputDispatcher::Update() {
+    actions.clear();
+    anyInputPressed = false;
+
+    if (IsInputEventHookInstalled()) {
+        RawInputEvent event;
+        while (PollRawInputEvent(event)) {
+            if (event.action != INPUT_EVENT_PRESS) continue;
+            anyInputPressed = true;
+            Dispatch(event.device, event.code, event.timestampNs);
+        }
+    } else {
+        // No event hook: poll only the bound keys and buttons instead of every keycode
+        for (size_t i = 0; i < bindings.size(); i++) {
+            const InputBinding& binding = bindings[i];
+            bool pressed = (binding.device == DEVICE_KEYBOARD && IsKeyPressed(binding.code)) ||
+                           (binding.device == DEVICE_MOUSE && IsMouseButtonPressed(binding.code));
+            if (pressed) actions.push_back(InputActionEvent{binding.action, binding.player, GetMonotonicTimeNs()});
+        }
+        anyInputPressed = !actions.empty() || GetKeyPressed() != 0 || IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
+    }
+
+    for (int i : gamepadBindings) {
+        const InputBinding& binding = bindings[i];
+        if (IsGamepadAvailable(binding.gamepad) && IsGamepadButtonPressed(binding.gamepad, binding.code)) {
+            actions.push_back(InputActionEvent{binding.action, binding.player, GetMonotonicTimeNs()});
+            anyInputPressed = true;
+        }
+    }
+}
+
+void InputDispatcher::Capture(InputFrame& frame) const {
+    for (const InputActionEvent& action : actions) {
+        if (frame.actionCount == INPUT_FRAME_ACTIONS) break;
+        frame.actions[frame.actionCount++] = action;
+    }
+    frame.anyInputPressed = frame.anyInputPressed || anyInputPressed;
+
+    int key = GetCharPressed();
+    while (key > 0) {
+        if (frame.charCount < INPUT_FRAME_CHARS) frame.chars[frame.charCount++] = key;
+        key = GetCharPressed();
+    }
+
+    // Keep the first click where it happened, buttons are hit-tested against it
+    if (!frame.clicked) {
+        Vector2 mouse = GetMousePosition();
+        frame.mouseX = mouse.x;
+        frame.mouseY = mouse.y;
+        frame.clicked = IsActionPressed(ACTION_CLICK);
+    }
+}
+
+void InputDispatcher::Update(const InputFrame& frame) {
+    actions.assign(frame.actions, frame.actions + frame.actionCount);
+    anyInputPressed = frame.anyInputPressed;
+}
+
+void InputDispatcher::InjectAction(const InputActionEvent& event) {
+    auto position = std::upper_bound(actions.begin(), actions.end(), event,
+        [](const InputActionEvent& a, const InputActionEvent& b) { return a.timestampNs < b.timestampNs; });
+    actions.insert(position, event);
+}
+
+const InputActionEvent* InputDispatcher::FindAction(InputAction action, int player) const {
+    for (const InputActionEvent& event : actions) {
+        if (event.action == action && event.player == player) return &event;
+    }
+    return nullptr;
+}
+
+bool InputDispatcher::IsActionPressed(InputAction action, int player) const {
+    return FindAction(action, player) != nullptr;
+}
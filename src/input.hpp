@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "input_queue.hpp"
+
+#define INPUT_BINDINGS_FILE_PATH "data/input-bindings.txt"
+#define INPUT_FRAME_ACTIONS 64    // Per frame handed to the game thread, later presses in a frame are dropped
+#define INPUT_FRAME_CHARS 32
+
+// Everything the game reacts to, independent of which key, mouse or gamepad button produced it
+typedef enum InputAction {
+    ACTION_NONE = 0,
+    ACTION_ANSWER_1, ACTION_ANSWER_2, ACTION_ANSWER_3, ACTION_ANSWER_4,
+    ACTION_ABILITY_1, ACTION_ABILITY_2, ACTION_ABILITY_3, ACTION_ABILITY_4,
+    ACTION_CLICK,       // Primary pointer press, used together with the mouse position for on-screen buttons
+    ACTION_BACK,        // Pause / leave the current screen
+    ACTION_CONFIRM,
+    ACTION_ERASE,       // Delete the last typed character
+    ACTION_NEXT_PLAYER, ACTION_ADD_PLAYER, ACTION_REMOVE_PLAYER,    // Player name screen
+    ACTION_PREVIOUS_PAGE, ACTION_NEXT_PAGE,    // Leaderboard paging
+    ACTION_PRACTICE,    // Starts the practice mode from the singleplayer rules
+    ACTION_COUNT
+} InputAction;
+
+// One row of the binding table: pressing `code` on `device` (gamepad number `gamepad`) triggers `action` for `player`
+struct InputBinding {
+    InputAction action;
+    int player;
+    InputDevice device;
+    int code;
+    int gamepad;
+};
+
+struct InputActionEvent {
+    InputAction action;
+    int player;
+    uint64_t timestampNs;
+};
+
+// What the window thread saw since it last handed input to the game thread: actions in press order, typed
+// characters and the mouse. Plain data, so it fits through an SpscQueue.
+struct InputFrame {
+    InputActionEvent actions[INPUT_FRAME_ACTIONS];
+    int actionCount;
+    int chars[INPUT_FRAME_CHARS];    // Unicode code points, as from GetCharPressed()
+    int charCount;
+    bool anyInputPressed;
+    bool clicked;          // mouseX, mouseY are where the first click was, when there was one
+    float mouseX, mouseY;
+};
+
+void ClearInputFrame(InputFrame& frame);
+
+// Adds a later frame to `frame`, for when the game thread takes several window frames in one tick
+void AppendInputFrame(InputFrame& frame, const InputFrame& later);
+
+std::vector<InputBinding> GetDefaultInputBindings(void);
+
+// Reads "ACTION player DEVICE code [gamepad]" lines, e.g. "ANSWER_1 0 KEY 81". Falls back to the defaults when the
+// file is missing or has no valid line.
+std::vector<InputBinding> LoadInputBindings(const char* filename);
+
+class InputDispatcher {
+    public:
+        InputDispatcher(const std::vector<InputBinding>& bindings);
+        void SetBindings(const std::vector<InputBinding>& bindings);
+
+        // Drains the raw event queue once per frame and translates it through the binding table, O(events)
+        void Update();
+
+        // Adds this frame's actions, typed characters and mouse position to `frame`. Window thread, after Update().
+        void Capture(InputFrame& frame) const;
+
+        // Takes the actions from a frame captured on the window thread instead of polling, for the game thread
+        void Update(const InputFrame& frame);
+
+        // Adds an action from a non-hardware source (bots) to this frame's list, kept in timestamp order.
+        // Call it after Update().
+        void InjectAction(const InputActionEvent& event);
+
+        bool IsActionPressed(InputAction action, int player = 0) const;
+        const InputActionEvent* FindAction(InputAction action, int player = 0) const;
+        bool IsAnyInputPressed() const { return anyInputPressed; }
+        const std::vector<InputActionEvent>& GetActions() const { return actions; }
+
+    private:
+        void Dispatch(int device, int code, uint64_t timestampNs);
+
+        std::vector<InputBinding> bindings;
+        std::vector<int> keyboardHeads, mouseHeads;    // First binding index per code, -1 when unbound
+        std::vector<int> nextBinding;                  // Next binding index sharing the same code
+        std::vector<int> gamepadBindings;              // Gamepad buttons have no callback and are polled per binding
+        std::vector<InputActionEvent> actions;         // Actions triggered this frame, in press order
+        bool anyInputPressed;
+};
@@ -0,0 +1,73 @@
+#include "input_queue.hpp"
+#include <chrono>
+#include "raylib.h"
+
+// raylib links GLFW statically (rglfw), so only the few entry points used here are declared
+extern "C" {
+    typedef struct GLFWwindow GLFWwindow;
+    typedef void (*GLFWkeyfun)(GLFWwindow* window, int key, int scancode, int action, int mods);
+    typedef void (*GLFWmousebuttonfun)(GLFWwindow* window, int button, int action, int mods);
+    GLFWwindow* glfwGetCurrentContext(void);
+    GLFWkeyfun glfwSetKeyCallback(GLFWwindow* window, GLFWkeyfun callback);
+    GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow* window, GLFWmousebuttonfun callback);
+}
+
+static SpscQueue<RawInputEvent, 256> inputEvents;
+static GLFWkeyfun raylibKeyCallback = nullptr;
+static GLFWmousebuttonfun raylibMouseButtonCallback = nullptr;
+static bool hookInstalled = false;
+static uint64_t lastTimestampNs = 0;    // Only touched by the producer (the thread polling GLFW events)
+
+uint64_t GetMonotonicTimeNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t NextInputTimestampNs(void) {
+    uint64_t now = GetMonotonicTimeNs();
+    lastTimestampNs = (now > lastTimestampNs) ? now : lastTimestampNs + 1;    // Keep stamps strictly increasing
+    return lastTimestampNs;
+}
+
+static void PushInputEvent(int device, int code, int action) {
+    if (!inputEvents.Push(RawInputEvent{device, code, action, NextInputTimestampNs()})) {
+        TraceLog(LOG_WARNING, "INPUT: Input event queue full, dropping code %i", code);
+    }
+}
+
+// GLFW delivers callbacks in OS arrival order while events are polled, so the stamps keep the real press order
+// even when several presses land inside the same frame
+static void KeyEventCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    PushInputEvent(DEVICE_KEYBOARD, key, action);
+
+    // Let raylib keep its own key state so IsKeyPressed() and GetCharPressed() still work
+    if (raylibKeyCallback != nullptr) raylibKeyCallback(window, key, scancode, action, mods);
+}
+
+static void MouseButtonEventCallback(GLFWwindow* window, int button, int action, int mods) {
+    PushInputEvent(DEVICE_MOUSE, button, action);
+    if (raylibMouseButtonCallback != nullptr) raylibMouseButtonCallback(window, button, action, mods);
+}
+
+bool InstallInputEventHook(void) {
+    if (hookInstalled) return true;
+
+    GLFWwindow* window = glfwGetCurrentContext();
+    if (window == nullptr) {
+        TraceLog(LOG_WARNING, "INPUT: No GLFW window found, input event hook not installed");
+        return false;
+    }
+
+    raylibKeyCallback = glfwSetKeyCallback(window, KeyEventCallback);
+    raylibMouseButtonCallback = glfwSetMouseButtonCallback(window, MouseButtonEventCallback);
+    hookInstalled = true;
+    return true;
+}
+
+bool IsInputEventHookInstalled(void) {
+    return hookInstalled;
+}
+
+bool PollRawInputEvent(RawInputEvent& event) {
+    return inputEvents.Pop(event);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer ring buffer. Capacity must be a power of two.
+// One thread may call Push() and one (other) thread may call Pop(), without locking.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    public:
+        SpscQueue() : head(0), tail(0) {}
+
+        // Returns false (and drops the item) when the queue is full
+        bool Push(const T& item) {
+            size_t currentTail = tail.load(std::memory_order_relaxed);
+            if (currentTail - head.load(std::memory_order_acquire) == Capacity) return false;
+            buffer[currentTail & (Capacity - 1)] = item;
+            tail.store(currentTail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Pop(T& item) {
+            size_t currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead == tail.load(std::memory_order_acquire)) return false;
+            item = buffer[currentHead & (Capacity - 1)];
+            head.store(currentHead + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool IsEmpty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+        // Items waiting, exact on the producer or consumer thread
+        size_t GetSize() const {
+            size_t currentHead = head.load(std::memory_order_acquire);
+            return tail.load(std::memory_order_acquire) - currentHead;
+        }
+
+    private:
+        T buffer[Capacity];
+        alignas(64) std::atomic<size_t> head;    // Only written by the consumer
+        alignas(64) std::atomic<size_t> tail;    // Only written by the producer
+};
+
+enum InputDevice { DEVICE_KEYBOARD = 0, DEVICE_MOUSE, DEVICE_GAMEPAD };
+
+// A single press/release captured straight from the GLFW key and mouse button callbacks
+struct RawInputEvent {
+    int device;              // InputDevice
+    int code;                // Key, mouse button or gamepad button
+    int action;              // INPUT_EVENT_PRESS, INPUT_EVENT_RELEASE or INPUT_EVENT_REPEAT
+    uint64_t timestampNs;    // Monotonic and strictly increasing, so two events never tie
+};
+
+enum { INPUT_EVENT_RELEASE = 0, INPUT_EVENT_PRESS = 1, INPUT_EVENT_REPEAT = 2 };
+
+// Monotonic clock in nanoseconds, independent of the frame rate
+uint64_t GetMonotonicTimeNs(void);
+
+// Returns a timestamp later than every stamp handed out so far. Only call it from the event producer thread.
+uint64_t NextInputTimestampNs(void);
+
+// Chains timestamping key and mouse button callbacks in front of raylib's own GLFW callbacks. Call once after InitWindow().
+// Returns false if the GLFW window could not be found, in which case PollRawInputEvent() never returns events.
+bool InstallInputEventHook(void);
+bool IsInputEventHookInstalled(void);
+
+// Consumes the next captured event in press order, returns false when the queue is empty
+bool PollRawInputEvent(RawInputEvent& event);
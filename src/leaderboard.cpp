@@ -0,0 +1,233 @@
+#include "leaderboard.hpp"
+#include <algorithm>
+
+static uint64_t HashName(const std::string& name) {
+    uint64_t hash = 0xCBF29CE484222325ULL;    // FNV-1a
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+RankedLeaderboard::RankedLeaderboard() {
+    Clear();
+}
+
+void RankedLeaderboard::Clear() {
+    nodes.clear();
+    slots.assign(16, -1);
+    root = -1;
+    nextSequence = 0;
+    priorityState = 0x853C49E6748FEA9BULL;
+}
+
+bool RankedLeaderboard::Before(int a, int b) const {
+    if (nodes[a].score != nodes[b].score) return nodes[a].score > nodes[b].score;
+    return nodes[a].sequence < nodes[b].sequence;
+}
+
+void RankedLeaderboard::Update(int node) {
+    nodes[node].size = 1 + SizeOf(nodes[node].left) + SizeOf(nodes[node].right);
+}
+
+void RankedLeaderboard::Split(int current, int pivot, int& before, int& after) {
+    if (current < 0) {
+        before = after = -1;
+        return;
+    }
+    if (Before(current, pivot)) {
+        Split(nodes[current].right, pivot, nodes[current].right, after);
+        before = current;
+    } else {
+        Split(nodes[current].left, pivot, before, nodes[current].left);
+        after = current;
+    }
+    Update(current);
+}
+
+void RankedLeaderboard::SplitFirst(int current, size_t count, int& first, int& rest) {
+    if (current < 0) {
+        first = rest = -1;
+        return;
+    }
+    size_t leftSize = SizeOf(nodes[current].left);
+    if (count > leftSize) {
+        SplitFirst(nodes[current].right, count - leftSize - 1, nodes[current].right, rest);
+        first = current;
+    } else {
+        SplitFirst(nodes[current].left, count, first, nodes[current].left);
+        rest = current;
+    }
+    Update(current);
+}
+
+int RankedLeaderboard::Merge(int before, int after) {
+    if (before < 0) return after;
+    if (after < 0) return before;
+    if (nodes[before].priority > nodes[after].priority) {
+        nodes[before].right = Merge(nodes[before].right, after);
+        Update(before);
+        return before;
+    }
+    nodes[after].left = Merge(before, nodes[after].left);
+    Update(after);
+    return after;
+}
+
+void RankedLeaderboard::Insert(int node) {
+    int before, after;
+    Split(root, node, before, after);
+    root = Merge(Merge(before, node), after);
+}
+
+void RankedLeaderboard::Erase(int node) {
+    // Everything ahead of the node, then the node itself alone, then everything behind it
+    int before, rest, self, after;
+    SplitFirst(root, CountAhead(node), before, rest);
+    SplitFirst(rest, 1, self, after);
+    root = Merge(before, after);
+}
+
+size_t RankedLeaderboard::CountAhead(int target) const {
+    size_t ahead = 0;
+    int current = root;
+    while (current >= 0 && current != target) {
+        if (Before(current, target)) {
+            ahead += SizeOf(nodes[current].left) + 1;
+            current = nodes[current].right;
+        } else {
+            current = nodes[current].left;
+        }
+    }
+    return ahead + SizeOf(nodes[target].left);
+}
+
+int RankedLeaderboard::FindNode(const std::string& playerName, uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    for (size_t slot = hash & mask; slots[slot] >= 0; slot = (slot + 1) & mask) {
+        const Node& node = nodes[slots[slot]];
+        if (node.nameHash == hash && node.name == playerName) return slots[slot];
+    }
+    return -1;
+}
+
+void RankedLeaderboard::IndexNode(int node) {
+    // Keep the index at most half full, linear probing stays short
+    if ((nodes.size() + 1) * 2 > slots.size()) {
+        slots.assign(slots.size() * 2, -1);
+        for (int i = 0; i < (int) nodes.size(); i++) {
+            if (i != node) IndexNode(i);
+        }
+    }
+    size_t mask = slots.size() - 1;
+    size_t slot = nodes[node].nameHash & mask;
+    while (slots[slot] >= 0) slot = (slot + 1) & mask;
+    slots[slot] = node;
+}
+
+uint32_t RankedLeaderboard::NextPriority() {
+    // xorshift: the tree shape only has to look random to keep its expected depth logarithmic
+    priorityState ^= priorityState << 13;
+    priorityState ^= priorityState >> 7;
+    priorityState ^= priorityState << 17;
+    return (uint32_t) (priorityState >> 32);
+}
+
+void RankedLeaderboard::Rebuild(const std::vector<LeaderboardEntry>& results) {
+    Clear();
+    nodes.reserve(results.size());
+    size_t slotCount = slots.size();
+    while (slotCount < results.size() * 2 + 2) slotCount *= 2;
+    slots.assign(slotCount, -1);
+
+    for (const LeaderboardEntry& result : results) {
+        uint64_t hash = HashName(result.playerName);
+        int node = FindNode(result.playerName, hash);
+        if (node < 0) {
+            nodes.push_back(Node{result.playerName, hash, result.score, nextSequence++, NextPriority(), -1, -1, 1});
+            IndexNode((int) nodes.size() - 1);
+        } else if (result.score > nodes[node].score) {
+            nodes[node].score = result.score;
+            nodes[node].sequence = nextSequence++;
+        }
+    }
+
+    std::vector<int> order(nodes.size());
+    for (int i = 0; i < (int) order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return Before(a, b); });
+
+    // Cartesian tree over the sorted nodes: the right spine lives on a stack, popped while priorities are lower
+    std::vector<int> spine;
+    for (int node : order) {
+        int last = -1;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[node].priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        nodes[node].left = last;
+        if (!spine.empty()) nodes[spine.back()].right = node;
+        spine.push_back(node);
+    }
+    root = spine.empty() ? -1 : spine.front();
+
+    // Sizes bottom-up: children come before parents in reverse pre-order
+    std::vector<int> preorder, stack;
+    if (root >= 0) stack.push_back(root);
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        preorder.push_back(node);
+        if (nodes[node].left >= 0) stack.push_back(nodes[node].left);
+        if (nodes[node].right >= 0) stack.push_back(nodes[node].right);
+    }
+    for (auto node = preorder.rbegin(); node != preorder.rend(); ++node) Update(*node);
+}
+
+bool RankedLeaderboard::Submit(const std::string& playerName, int score) {
+    uint64_t hash = HashName(playerName);
+    int node = FindNode(playerName, hash);
+
+    if (node >= 0) {
+        if (score <= nodes[node].score) return false;
+        Erase(node);
+        nodes[node].score = score;
+        nodes[node].sequence = nextSequence++;
+        nodes[node].left = nodes[node].right = -1;
+        nodes[node].size = 1;
+        Insert(node);
+        return true;
+    }
+
+    nodes.push_back(Node{playerName, hash, score, nextSequence++, NextPriority(), -1, -1, 1});
+    node = (int) nodes.size() - 1;
+    IndexNode(node);
+    Insert(node);
+    return true;
+}
+
+size_t RankedLeaderboard::GetRank(const std::string& playerName) const {
+    int target = FindNode(playerName, HashName(playerName));
+    return target < 0 ? 0 : CountAhead(target) + 1;
+}
+
+int RankedLeaderboard::GetBestScore(const std::string& playerName) const {
+    int node = FindNode(playerName, HashName(playerName));
+    return node < 0 ? -1 : nodes[node].score;
+}
+
+void RankedLeaderboard::Collect(int current, size_t offset, size_t count, std::vector<LeaderboardEntry>& page) const {
+    if (current < 0 || page.size() >= count) return;
+
+    size_t leftSize = SizeOf(nodes[current].left);
+    if (offset < leftSize) Collect(nodes[current].left, offset, count, page);
+    if (page.size() < count && offset <= leftSize) page.push_back(LeaderboardEntry{nodes[current].name, nodes[current].score});
+    if (page.size() < count) Collect(nodes[current].right, offset > leftSize ? offset - leftSize - 1 : 0, count, page);
+}
+
+std::vector<LeaderboardEntry> RankedLeaderboard::GetPage(size_t offset, size_t count) const {
+    std::vector<LeaderboardEntry> page;
+    page.reserve(count);
+    Collect(root, offset, count, page);
+    return page;
+}
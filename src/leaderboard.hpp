@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define LEADERBOARD_PAGE_SIZE 10
+
+struct LeaderboardEntry {
+    std::string playerName;
+    int score;
+};
+
+// Every player's best multiplayer score, ordered by score (earlier results first on equal scores).
+// A treap augmented with subtree sizes gives O(log n) inserts, rank queries and page lookups, and a name hash
+// index finds a player's entry in O(1), so millions of players stay cheap. Nodes live in one pool and are
+// re-linked in place when a player improves, so the name index never has to change.
+class RankedLeaderboard {
+    public:
+        RankedLeaderboard();
+
+        void Clear();
+        size_t Size() const { return nodes.size(); }
+
+        // Records a result. Returns true when it is the player's first or a new best score.
+        bool Submit(const std::string& playerName, int score);
+
+        // Replaces the board with `results` in the order they were achieved, keeping each player's best. Sorts once
+        // and builds the tree in linear time, which is much faster than one Submit() per result when loading.
+        void Rebuild(const std::vector<LeaderboardEntry>& results);
+
+        // 1-based rank of the player's best score, 0 when the player has no entry
+        size_t GetRank(const std::string& playerName) const;
+        int GetBestScore(const std::string& playerName) const;    // -1 when the player has no entry
+
+        // Entries [offset, offset + count) in rank order, O(log n + count)
+        std::vector<LeaderboardEntry> GetPage(size_t offset, size_t count) const;
+
+    private:
+        struct Node {
+            std::string name;
+            uint64_t nameHash;
+            int score;
+            uint32_t sequence;    // Order of the result, breaks ties between equal scores
+            uint32_t priority;
+            int left, right;
+            uint32_t size;
+        };
+
+        bool Before(int a, int b) const;    // Node a ranks ahead of node b
+        uint32_t SizeOf(int node) const { return node < 0 ? 0 : nodes[node].size; }
+        void Update(int node);
+        void Split(int root, int pivot, int& before, int& after);    // before: nodes ranking ahead of pivot
+        void SplitFirst(int root, size_t count, int& first, int& rest);    // first: the `count` best nodes
+        size_t CountAhead(int node) const;
+        int Merge(int before, int after);
+        void Insert(int node);
+        void Erase(int node);
+        void Collect(int root, size_t offset, size_t count, std::vector<LeaderboardEntry>& page) const;
+
+        uint32_t NextPriority();
+        int FindNode(const std::string& playerName, uint64_t hash) const;
+        void IndexNode(int node);
+
+        std::vector<Node> nodes;
+        std::vector<int> slots;    // Open addressing name index into nodes, -1 when empty
+        int root;
+        uint32_t nextSequence;
+        uint64_t priorityState;
+};
@@ -8,16 +8,90 @@
 #include <string>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <cstdlib>
+#include <ctime>
 #include "raylib.h"
 #include "button.hpp"
 #include "questions.hpp"
+#include "input.hpp"
+#include "players.hpp"
+#include "match_client.hpp"
+#include "quiz_host.hpp"
+#include "replay.hpp"
+#include "session_random.hpp"
+#include "bots.hpp"
+#include "persistence.hpp"
+#include "score_store.hpp"
+#include "leaderboard.hpp"
+#include "game_history.hpp"
+#include "question_telemetry.hpp"
+#include "question_selector.hpp"
+#include "practice.hpp"
+#include "math_generator.hpp"
+#include "audio_engine.hpp"
+#include "mixer.hpp"
+#include "timeline.hpp"
+#include "sound_bank.hpp"
+#include "triple_buffer.hpp"
+#include "work_stealing.hpp"
+#include "asset_preload.hpp"
 
 #define SINGLEPLAYER_DATA_FILE_PATH "data/singleplayer-data.bin" 
-#define MULTIPLAYER_DATA_FILE_PATH "data/multiplayer-data.bin" 
+#define MULTIPLAYER_DATA_FILE_PATH "data/multiplayer-data.bin"     // Leaderboard before the score log, imported once
+#define SCORE_LOG_FILE_PATH "data/multiplayer-scores.wal"
+#define SCORE_LOG_COMPACT_RECORDS 256                             // Compact once the log holds this many records
+#define LOGIC_TICK_HZ 60                                          // Game logic rate, independent of the frame rate
+#define LOGIC_MAX_LAG_TICKS 10                                    // Behind by more than this, the logic skips ahead
+#define GENERATED_WRAP_CACHE_LIMIT 64                             // Wrapped texts of generated questions kept
+#define QUESTION_WRAP_WIDTH 800
+#define QUESTION_FONT_SIZE 30
+#define ANSWER_WRAP_WIDTH 600
+#define ANSWER_FONT_SIZE 25
 
 
 // Screen manager, based on an example from the raylib website
-typedef enum GameScreen { MAIN_MENU = 0, STARTGAME, SETTINGS, SINGLEPLAYER_RULES, MULTIPLAYER_RULES, SINGLEPLAYER, MULTIPLAYER, READY, PAUSE, SINGLEPLAYER_GAMEOVER, MULTIPLAYER_GAMEOVER, MULTIPLAYER_CONTROLS, PLAYERNAME, LEADERBOARDS, EXIT } GameScreen;
+typedef enum GameScreen { MAIN_MENU = 0, STARTGAME, SETTINGS, SINGLEPLAYER_RULES, MULTIPLAYER_RULES, SINGLEPLAYER, MULTIPLAYER, READY, PAUSE, SINGLEPLAYER_GAMEOVER, MULTIPLAYER_GAMEOVER, MULTIPLAYER_CONTROLS, PLAYERNAME, LEADERBOARDS, ONLINE_LOBBY, ONLINE_MULTIPLAYER, QUIZ_HOST, EXIT } GameScreen;
+
+// Everything the screens draw, published by the game thread once per tick and drawn by the window thread, see
+// triple_buffer.hpp. The draw code reads only this and what does not change after loading (textures, buttons).
+struct GameSnapshot {
+    GameScreen screen;
+    Question question;
+    int questionIndex;      // Into the bank, or past its end for a generated question
+    int seconds;
+    int score;
+    int highscore;
+    int healthPoints;
+
+    // Singleplayer
+    bool abilityA_Used, abilityS_Used, abilityD_Used, abilityF_Used;
+    bool skipQuestion, isAnswerCorrect, answerSelected, addHealthPoint;
+    bool isChoiceCorrect[4], isChoiceWrong[4], isRemoved[4];
+    bool practiceMode;
+    int practiceDueCount, practiceCardCount;
+
+    // Multiplayer, online and the quiz host
+    std::vector<Player> players;
+    int playerCount;
+    int typingPlayer;
+    bool correctAnswer;
+    std::string gameMessage, gameMessage1, gameMessage2;
+    bool isInMatch;
+    QuizResults quizResults;
+    bool quizRoundOpen;
+
+    // Leaderboard, filled on its screen only
+    std::vector<LeaderboardEntry> leaderboardEntries;
+    size_t leaderboardPage, leaderboardSize;
+    std::vector<std::string> lastMatchPlayers;
+    std::vector<size_t> lastMatchRanks;
+
+    bool muteUi, muteMusic;
+};
 
 // Draws text and dynamically centers it horizontally 
 void DrawTextHorizontal (Font font, const char* text, float fontSize, float fontSpacing,
@@ -78,12 +152,22 @@ std::vector<std::string> WrapText(Font font, const char* text, int maxWidth, int
     return lines;
 }
 
+// Wrapped lines of generated questions by width, font size and text. The question and answers are drawn on every
+// frame, the answers up to 25 times for their outlines, so each text is measured once. The bank is wrapped at startup
+// and looked up by question index instead, this only holds the few generated questions seen lately. Window thread only.
+std::unordered_map<std::string, std::vector<std::string>> generatedWrapCache;
+
+const std::vector<std::string>& GetWrappedText(Font font, const char* text, int maxWidth, int fontSize) {
+    std::string key = std::to_string(maxWidth) + ":" + std::to_string(fontSize) + ":" + text;
+    auto found = generatedWrapCache.find(key);
+    if (found != generatedWrapCache.end()) return found->second;
+    if (generatedWrapCache.size() >= GENERATED_WRAP_CACHE_LIMIT) generatedWrapCache.clear();
+    return generatedWrapCache[key] = WrapText(font, text, maxWidth, fontSize);
+}
+
 // Draw wrapped text centered both vertically and horizontally
-void DrawQuestionText(Font font, const char* text, int maxWidth, int screenWidth, int screenHeight,
+void DrawQuestionText(Font font, const std::vector<std::string>& lines, int screenWidth, int screenHeight,
                       int fontSize, Color color, bool isMultiplayer) {
-    // Get wrapped lines
-    std::vector<std::string> lines = WrapText(font, text, maxWidth, fontSize);
-
     // Calculate total height for vertical centering
     int totalHeight = lines.size() * fontSize;
     float posY = (screenHeight - totalHeight) / 2; // Vertically center
@@ -111,11 +195,8 @@ void DrawCenteredTextAtX(const char* text, Font font, float x, float y, int minF
 }
 
 // Draw and center text for the answer buttons based on the buttons' dimensions
-void DrawAnswerText(Font font, const char *text, float fontSize, float spacing, Color color, 
-                    float buttonX, float buttonY, float buttonWidth, float buttonHeight, int maxWidth, bool isMultiplayer) {
-    // Wrap the text into multiple lines
-    std::vector<std::string> lines = WrapText(font, text, maxWidth, fontSize);
-    
+void DrawAnswerText(Font font, const std::vector<std::string>& lines, float fontSize, float spacing, Color color, 
+                    float buttonX, float buttonY, float buttonWidth, float buttonHeight, bool isMultiplayer) {
     // Calculate total height of wrapped text for vertical centering
     float totalHeight = lines.size() * fontSize;
 
@@ -136,71 +217,32 @@ void DrawAnswerText(Font font, const char *text, float fontSize, float spacing,
     }
 }
 
-// Checks for any key press
-bool IsAnyKeyPressed(void) {
-    for (int key = 32; key < 350; key++) { 
-        if (IsKeyPressed(key)) return true;        
-    }
-    return false;
-}
-
 // Generates a random number ensuring it doesn't repeat within the last 'historySize' numbers
-int GetUniqueRandomValue(int min, int max, std::vector<int>& history, size_t historySize) {
-    while (true) {
-        int newRandom = GetRandomValue(min, max);
-
-        // Check if the number exists in the history
-        bool isUnique = true;
-        for (int num : history) {
-            if (num == newRandom) {
-                isUnique = false;
-                break;
-            }
-        }
+int GetUniqueRandomValue(SessionRandom& random, int min, int max, std::vector<int>& history, size_t historySize) {
+    int newRandom = random.RangeExcluding(min, max, history);
 
-        // If unique, update history and return the value
-        if (isUnique) {
-            if (history.size() >= historySize) {
-                history.erase(history.begin()); // Remove the oldest number
-            }
-            history.push_back(newRandom); // Add the new number to the history
-            return newRandom;
-        }
+    if (history.size() >= historySize) {
+        history.erase(history.begin()); // Remove the oldest number
     }
+    history.push_back(newRandom); // Add the new number to the history
+    return newRandom;
 }
 
-std::vector<int> GetTwoWrongAnswersIndices(int correctAnswerIndex) {
-    std::vector<int> wrongAnswers;
-
-    while (wrongAnswers.size() < 2) {
-        int randomIndex = GetRandomValue(0, 3);
-
-        // Ensure the index is not the correct answer and is not already in the wrongAnswers vector
-        bool isDuplicate = false;
-        for (int answer : wrongAnswers) {
-            if (answer == randomIndex) {
-                isDuplicate = true;
-                break;
-            }
-        }
-        if (randomIndex != correctAnswerIndex && !isDuplicate) {
-            wrongAnswers.push_back(randomIndex);
-        }
+std::vector<int> GetTwoWrongAnswersIndices(SessionRandom& random, int correctAnswerIndex) {
+    int wrongAnswers[3];
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i != correctAnswerIndex) wrongAnswers[count++] = i;
     }
 
-    return wrongAnswers;
+    random.SampleInPlace(wrongAnswers, count, 2);
+    return {wrongAnswers[0], wrongAnswers[1]};
 }
 
-int GetOneWrongAnswerIndex(int correctAnswerIndex) {
-    int randomIndex;
-
-    while (true) {
-        randomIndex = GetRandomValue(0, 3);
-        if (randomIndex != correctAnswerIndex) {
-            return randomIndex;
-            break;
-        }
-    }
+int GetOneWrongAnswerIndex(SessionRandom& random, int correctAnswerIndex) {
+    // Draw among the three wrong slots and shift past the correct one
+    int randomIndex = random.Range(0, 2);
+    return (randomIndex >= correctAnswerIndex) ? randomIndex + 1 : randomIndex;
 }
 
 void DrawTextHighlight(Font font, const char* text, float posX, float posY, 
@@ -213,13 +255,30 @@ void DrawTextHighlight(Font font, const char* text, float posX, float posY,
     DrawTextEx(font, text, {posX, posY}, fontSize, fontSpacing, BLACK);
 }
 
-// Save highscore to a binary file
-void SaveHighScore(const char* filename, int value) {
-    std::ofstream outFile(filename, std::ios::binary);
-    if (outFile.is_open()) {
-        outFile.write(reinterpret_cast<const char*>(&value), sizeof(value));
-        outFile.close();
-    }
+// Places a multiplayer HUD panel: players alternate between the left and right side, and panels shrink
+// as more rows are needed so up to MAX_PLAYERS fit above the answer buttons
+Vector2 GetPlayerHudPosition(int playerIndex, int playerCount, float* scale) {
+    int rows = (playerCount + 1) / 2;
+    float rowHeight = 520.0f / rows;
+    *scale = (rowHeight >= 400.0f) ? 1.0f : rowHeight / 400.0f;
+
+    float posX = (playerIndex % 2 == 0) ? 100.0f : (float) GetScreenWidth() - 330.0f;
+    float posY = 190.0f + (playerIndex / 2) * rowHeight;
+    return {posX, posY};
+}
+
+// Appends the raw bytes of a value, the save files use the in-memory layout
+template <typename T>
+void AppendBytes(std::vector<uint8_t>& data, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+// Save highscore to a binary file, written by the persistence thread
+void SaveHighScore(PersistenceWriter& writer, const char* filename, int value) {
+    std::vector<uint8_t> data;
+    AppendBytes(data, value);
+    writer.Write(filename, std::move(data));
 }
 
 // Load highscore from a binary file. Will create a new .bin file if not existing
@@ -233,92 +292,127 @@ int LoadHighScore(const char* filename) {
     return value;
 }
 
-//Stores player names and scores used for leader board
-struct LeaderboardEntry {
-    std::string playerName;
-    int score;
+// Every player's best multiplayer score, ranked
+RankedLeaderboard leaderboard;
 
-    bool operator>(const LeaderboardEntry& other) const {
-        return score > other.score; // Compare scores for sorting
-    }
-};
+int scoreLogRecords = 0;    // Records in the score log since the last compaction
 
-// Global leaderboard vector
-std::vector<LeaderboardEntry> leaderboard;
-
-void SaveLeaderboard() {
-    std::ofstream file(MULTIPLAYER_DATA_FILE_PATH, std::ios::binary);
-    if (file.is_open()) {
-        // Save the leaderboard size first
-        int size = leaderboard.size();
-        file.write(reinterpret_cast<char*>(&size), sizeof(size));
-
-        // Save each player's name and score
-        for (const auto& entry : leaderboard) {
-            int nameLength = entry.playerName.length();
-            file.write(reinterpret_cast<char*>(&nameLength), sizeof(nameLength)); // Save name length
-            file.write(entry.playerName.c_str(), nameLength); // Save name
-            file.write(reinterpret_cast<const char*>(&entry.score), sizeof(entry.score)); // Save score
-        }
-        file.close();
+// Rewrites the score log with one record per player, best score first
+void CompactScoreLog(PersistenceWriter& writer) {
+    std::vector<ScoreRecord> records;
+    records.reserve(leaderboard.Size());
+    for (const LeaderboardEntry& entry : leaderboard.GetPage(0, leaderboard.Size())) {
+        records.push_back(ScoreRecord{entry.playerName, entry.score});
     }
+    writer.Write(SCORE_LOG_FILE_PATH, EncodeScoreLog(records));
+    scoreLogRecords = records.size();
 }
 
-// Load leaderboard from a binary file. Will create a new .bin file if not existing
-void LoadLeaderboard() {
-    std::ifstream file(MULTIPLAYER_DATA_FILE_PATH, std::ios::binary);
-    if (file.is_open()) {
-        leaderboard.clear(); // Clear existing leaderboard
-
-        // Read leaderboard size
-        int size;
-        file.read(reinterpret_cast<char*>(&size), sizeof(size));
-
-        // Read each player's name and score
-        for (int i = 0; i < size; i++) {
-            int nameLength;
-            file.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength)); // Read name length
-            char* nameBuffer = new char[nameLength + 1]; // Allocate memory for name
-            file.read(nameBuffer, nameLength); // Read name
-            nameBuffer[nameLength] = '\0'; // Null-terminate the string
-
-            int score;
-            file.read(reinterpret_cast<char*>(&score), sizeof(score)); // Read score
+// The log is compacted once superseded records outnumber the live ones, so rewrites stay proportional to growth
+bool ScoreLogNeedsCompaction() {
+    return scoreLogRecords > 2 * (int) leaderboard.Size() + SCORE_LOG_COMPACT_RECORDS;
+}
 
-            // Add to leaderboard
-            leaderboard.push_back(LeaderboardEntry{nameBuffer, score});
+void RebuildLeaderboard(const std::vector<ScoreRecord>& records) {
+    std::vector<LeaderboardEntry> results;
+    results.reserve(records.size());
+    for (const ScoreRecord& record : records) results.push_back(LeaderboardEntry{record.name, record.score});
+    leaderboard.Rebuild(results);
+}
 
-            delete[] nameBuffer; // Clean up memory
+// Load the leaderboard from the score log. Corrupt records are skipped and the log is rewritten clean; a missing
+// log is created from the old leaderboard file when there is one.
+void LoadLeaderboard(PersistenceWriter& writer) {
+    leaderboard.Clear();
+    std::vector<uint8_t> data;
+
+    if (ReadWholeFile(SCORE_LOG_FILE_PATH, data)) {
+        ScoreLogContents contents = ParseScoreLog(data.data(), data.size());
+        RebuildLeaderboard(contents.records);
+        scoreLogRecords = contents.records.size();
+
+        if (!contents.valid || contents.droppedBytes > 0) {
+            TraceLog(LOG_WARNING, "SCORES: Skipped %i corrupt bytes in %s, kept %i records", (int) contents.droppedBytes,
+                     SCORE_LOG_FILE_PATH, (int) contents.records.size());
+            CompactScoreLog(writer);
         }
+        else if (ScoreLogNeedsCompaction()) CompactScoreLog(writer);
+        return;
+    }
 
-        file.close();
+    std::vector<ScoreRecord> legacy;
+    if (ReadWholeFile(MULTIPLAYER_DATA_FILE_PATH, data) && !ParseLegacyLeaderboard(data.data(), data.size(), legacy)) {
+        TraceLog(LOG_WARNING, "SCORES: %s is damaged, imported %i entries", MULTIPLAYER_DATA_FILE_PATH, (int) legacy.size());
     }
+    RebuildLeaderboard(legacy);
+    CompactScoreLog(writer);    // Creates the log with its header
 }
 
-void UpdateLeaderboard(const std::string& player1Name, int player1Score, const std::string& player2Name, int player2Score) {
-    // Add new scores to the leaderboard
-    leaderboard.push_back(LeaderboardEntry{player1Name, player1Score});
-    leaderboard.push_back(LeaderboardEntry{player2Name, player2Score});
-
-    // Sort leaderboard by score (highest to lowest)
-    std::sort(leaderboard.begin(), leaderboard.end(), std::greater<LeaderboardEntry>());
-
-    // Keep only top 10 players
-    if (leaderboard.size() > 10) {
-        leaderboard.resize(10);
+void UpdateLeaderboard(PersistenceWriter& writer, const std::vector<Player>& players) {
+    // Only new personal bests change the board, so only they are logged
+    std::vector<uint8_t> appended;
+    for (const Player& player : players) {
+        if (!leaderboard.Submit(player.name, player.score)) continue;
+        std::vector<uint8_t> encoded = EncodeScoreRecord(ScoreRecord{player.name, player.score});
+        appended.insert(appended.end(), encoded.begin(), encoded.end());
+        scoreLogRecords++;
     }
+    if (appended.empty()) return;
 
-    // Save the updated leaderboard
-    SaveLeaderboard();
+    writer.Append(SCORE_LOG_FILE_PATH, std::move(appended));
+    if (ScoreLogNeedsCompaction()) CompactScoreLog(writer);
 }
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main(void) 
+int main(int argc, char** argv) 
 {
     // Initialization
     //--------------------------------------------------------------------------------------
+    // "--connect host[:port]" plays the multiplayer mode against another cabinet through a match server,
+    // "--host-quiz [port]" turns this screen into a classroom quiz host,
+    // "--bots N [--bot-level easy|medium|hard]" fills the last N multiplayer seats with computer players,
+    // "--practice-profile NAME" picks the student whose practice deck this kiosk drills,
+    // "--compressed-sounds" keeps sound effects compressed in memory and decodes them as they play
+    std::string serverHost;
+    uint16_t serverPort = MATCH_DEFAULT_PORT;
+    bool quizHostMode = false;
+    uint16_t quizPort = QUIZ_DEFAULT_PORT;
+    int botCount = 0;
+    BotLevel botLevel = BOT_MEDIUM;
+    std::string practiceProfile = PRACTICE_DEFAULT_PROFILE;
+    bool compressedSounds = false;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--connect" && i + 1 < argc) {
+            serverHost = argv[++i];
+            size_t colon = serverHost.find(':');
+            if (colon != std::string::npos) {
+                serverPort = (uint16_t) atoi(serverHost.c_str() + colon + 1);
+                serverHost.resize(colon);
+            }
+        }
+        else if (argument == "--host-quiz") {
+            quizHostMode = true;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) quizPort = (uint16_t) atoi(argv[++i]);
+        }
+        else if (argument == "--bots" && i + 1 < argc) {
+            botCount = std::max(0, std::min(MAX_PLAYERS - 1, atoi(argv[++i])));
+        }
+        else if (argument == "--bot-level" && i + 1 < argc) {
+            ParseBotLevel(argv[++i], botLevel);
+        }
+        else if (argument == "--practice-profile" && i + 1 < argc) {
+            practiceProfile = argv[++i];
+        }
+        else if (argument == "--compressed-sounds") {
+            compressedSounds = true;
+        }
+    }
+    bool onlineMode = !serverHost.empty();
+    if (onlineMode) botCount = 0;
+
     GameScreen currentScreen = MAIN_MENU;
     GameScreen previousScreen = MAIN_MENU;
     
@@ -331,15 +425,34 @@ int main(void)
     ToggleFullscreen();                   
     SetExitKey(KEY_NULL);            
     SetTargetFPS(60);
+    InstallInputEventHook();
+
+    // Startup work runs on the job system while this thread loads the rest, see work_stealing.hpp. The time of
+    // every job goes to the debug log.
+    JobSystem jobs;
+    jobs.SetProfileHook([](const JobProfile& profile) {
+        TraceLog(LOG_DEBUG, "JOBS: %s took %.2f ms on worker %i, queued %.2f ms", profile.name,
+                 (profile.endNs - profile.startNs) / 1e6, profile.worker, (profile.startNs - profile.readyNs) / 1e6);
+    });
+    uint64_t loadStartNs = GetMonotonicTimeNs();
+    std::vector<JobHandle> startupJobs;
+
+    // Images, and the effects unless they stay compressed, decode first, the textures and sounds below wait for them
+    PreloadImages(jobs, "assets");
+    if (!compressedSounds) {
+        PreloadSounds(jobs, {"assets/sounds/button_click.mp3", "assets/sounds/correct_answer.mp3", "assets/sounds/wrong_answer.mp3",
+                             "assets/sounds/gameover.mp3", "assets/sounds/gotcorrect.mp3", "assets/sounds/Both-wrong.mp3",
+                             "assets/sounds/playerWins.mp3", "assets/sounds/no-time-left.mp3", "assets/sounds/3s-countdown.mp3"});
+    }
 
     //For Multiplayer name input
-    std::string player1Name = "";
-    std::string player2Name = "";
-    bool enteringPlayer1Name = false;
-    bool enteringPlayer2Name = false;
+    std::vector<Player> players;
+    int playerCount = std::max(MIN_PLAYERS, botCount + 1);
+    ResetPlayers(players, playerCount);
+    int typingPlayer = -1;    // Player whose name is being typed, -1 when none
     bool namesEntered = false;
     
-    bool exitConfirmed = false;
+    std::atomic<bool> exitConfirmed(false);    // Set on the game thread, ends the window loop
 
     bool singlePLayerSelected = false; 
 
@@ -353,15 +466,8 @@ int main(void)
     bool addHealthPoint = false;
     bool abilityF_Used = false;
 
-    bool isAnswerQ_Correct = false;
-    bool isAnswerW_Correct = false;
-    bool isAnswerE_Correct = false;
-    bool isAnswerR_Correct = false;
-
-    bool isAnswerQ_Wrong = false;
-    bool isAnswerW_Wrong = false;
-    bool isAnswerE_Wrong = false;
-    bool isAnswerR_Wrong = false;
+    bool isChoiceCorrect[4] = {false, false, false, false};    // Per answer button: Q, W, E, R
+    bool isChoiceWrong[4] = {false, false, false, false};
     bool answerSelected = false;
 
     bool exitFromGameover = false;
@@ -376,72 +482,240 @@ int main(void)
     
 
     std::vector<Question> questions = GetQuestionsVector();
+    // The bank, then one slot that generated math questions are written into, see math_generator.hpp
+    size_t bankSize = questions.size();
+    int generatedSlot = (int) bankSize;
+    questions.push_back(Question{"", {"", "", "", ""}, 0});
     std::vector<int> history;    // To store last 'historySize' generated numbers
     size_t historySize = 10;    
+    SessionRandom sessionRandom(GetMonotonicTimeNs());    // Reseeded per session, see BeginReplay
 
     int countdownTime = 21;
     int seconds = 0;
-    int currentQuestionIndex = GetUniqueRandomValue(0, questions.size()-1, history, historySize);
+    int currentQuestionIndex = GetUniqueRandomValue(sessionRandom, 0, bankSize - 1, history, historySize);
+    int64_t currentQuestionId = currentQuestionIndex;    // As logged in the replay
     int selectedAnswerIndex = -1;
     int score = 0;
     int highscore = LoadHighScore(SINGLEPLAYER_DATA_FILE_PATH);
-    LoadLeaderboard();
+
+    // Score files and replays are written behind the game on their own thread, see persistence.hpp
+    PersistenceWriter persistence;
+    persistence.Start();
+    startupJobs.push_back(jobs.Run("leaderboard", [&]() { LoadLeaderboard(persistence); }));
+
+    // Answer telemetry and question difficulty estimates, updated on their own thread, see question_telemetry.hpp
+    QuestionTelemetry telemetry(bankSize);
+    JobHandle telemetryLoaded = jobs.Run("difficulty estimates", [&]() {
+        telemetry.Load(DIFFICULTY_FILE_PATH);
+        telemetry.Start(&persistence);
+    });
+    uint64_t questionStartNs = GetMonotonicTimeNs();
+    float playerAbilities[MAX_PLAYERS] = {};    // Skill estimates for the current game, in logits
+    int playerAnswerCounts[MAX_PLAYERS] = {};
+    AdaptiveQuestionSelector questionSelector;    // Aims questions at those skills, rebuilt every session
+
+    // Practice mode plays the singleplayer screen with the student's spaced-repetition deck, see practice.hpp
+    bool practiceMode = false;
+    std::string practicePath = GetPracticeProfilePath(practiceProfile);
+    PracticeDeck practiceDeck;
+    int practiceReviews = 0;
+    int practiceDueCount = 0;
+    startupJobs.push_back(jobs.Run("practice deck", [&]() {
+        std::vector<uint8_t> questionCategories(bankSize);
+        for (size_t i = 0; i < bankSize; i++) questionCategories[i] = (uint8_t) GetQuestionCategory(i);
+        practiceDeck.Reset(questionCategories, CATEGORY_COUNT);
+        std::vector<uint8_t> data;
+        if (ReadWholeFile(practicePath, data) && practiceDeck.Load(data.data(), data.size())) {
+            TraceLog(LOG_INFO, "PRACTICE: Loaded %i cards from %s", (int) practiceDeck.GetCardCount(), practicePath.c_str());
+        }
+    }));
+
     int healthPoints = 10;
-    int wrongAnswerIndex;
+    int wrongAnswerIndex = -1;
 
     //Multiplayer variables
-    int player1Score = 0;
-    int player2Score = 0;
-    int player1Healthpoints = 10;
-    int player2Healthpoints = 10;
-    bool player1Selected = false, player2Selected = false;
     bool gameInProgress = false;
-    int player1Answer = -1, player2Answer = -1;
-    float player1AnswerTime = 0, player2AnswerTime = 0;
     bool correctAnswer = false;
-    bool messageDisplayed = false;
     std::string gameMessage;
-    float gameOverDelayTimer = 0.0f;
     bool isGameOverTriggered = false;
+
+    // Round results, the READY countdown and the game-over delay play out as timed sequences, see timeline.hpp.
+    // The timeline only advances on the game screens, so it stands still while paused.
+    Timeline timeline;
+    TimelineTask roundTask = TIMELINE_NONE;    // The result of the current question, until the next one starts
     std::string gameMessage1;
     std::string gameMessage2;
 
-    // Predefined Y-offsets for leaderboard entries (top 10)
+    // Online multiplayer, the server owns the question, the countdown and the scores
+    MatchClient matchClient;
+    uint32_t onlineRoundId = 0;
+    uint32_t onlineResultRoundId = 0;
+
+    // Classroom quiz host, answers are collected on a background thread so they are timestamped on arrival
+    QuizHost quizHost;
+    QuizResults quizResults{};
+    bool quizRoundOpen = false;
+
+    if (onlineMode || quizHostMode) NetInit();
+    if (quizHostMode && quizHost.Start(quizPort, QUIZ_MAX_CLIENTS)) {
+        quizHost.RunInBackground();
+        currentScreen = QUIZ_HOST;
+    }
+
+    // Predefined Y-offsets for the entries of one leaderboard page
     float yOffsets[] = {470.0f, 510.0f, 550.0f, 590.0f, 630.0f, 670.0f, 710.0f, 750.0f, 790.0f, 830.0f};
+    size_t leaderboardPage = 0;
+    std::vector<std::string> lastMatchPlayers;    // Shown with their ranks below the leaderboard
 
     std::vector<int> wrongAnswersIndices = {-1, -1};  // 2 wrong answers' indices, reset this variabe everytime after its value gets changed
 
     double startTime = GetTime();
 
+    // Computer players sit in the last botCount seats and answer through the same action list as the keyboards
+    std::vector<BotPlayer> bots;
+    for (int i = 0; i < botCount; i++) bots.push_back(BotPlayer(GetBotProfile(botLevel), sessionRandom.Next()));
+
+    auto IsBotSeat = [&](int player) { return player >= playerCount - botCount; };
+    auto GetBotName = [](int player) { return "CPU " + std::to_string(player + 1); };
+
+    auto NameBots = [&]() {
+        for (int i = 0; i < playerCount; i++) {
+            if (IsBotSeat(i)) players[i].name = GetBotName(i);
+            else if (players[i].name == GetBotName(i)) players[i].name.clear();    // Seat handed back to a human
+        }
+    };
+    NameBots();
+
+    auto StartBotQuestion = [&]() {
+        uint64_t nowNs = GetMonotonicTimeNs();
+        QuestionCategory category = currentQuestionIndex == generatedSlot ? CATEGORY_MATH : GetQuestionCategory(currentQuestionIndex);
+        for (BotPlayer& bot : bots) bot.StartQuestion(category, questions[currentQuestionIndex].correctAnswerIndex, nowNs);
+    };
+
+    // Every session is logged so disputed results can be replayed, see replay.hpp and tools/replay_tool.cpp
+    ReplayRecorder replay;
+
+    auto GetReplayPlayers = [&]() -> std::vector<Player> {
+        if (!singlePLayerSelected) return players;
+        return std::vector<Player>{Player{"Player 1", score, healthPoints, -1, false, 0}};
+    };
+
+    // Feeds one player's answer (or TELEMETRY_NO_ANSWER) to the telemetry and updates their skill estimate
+    auto RecordAnswer = [&](int player, int answer, uint64_t pressNs) {
+        if (currentQuestionIndex == generatedSlot) return;    // Generated questions have no telemetry to feed
+        bool correct = answer == questions[currentQuestionIndex].correctAnswerIndex;
+        uint32_t latencyMs = (answer != TELEMETRY_NO_ANSWER && pressNs > questionStartNs) ? (uint32_t) ((pressNs - questionStartNs) / 1000000) : 0;
+        telemetry.Record(AnswerSample{(int64_t) time(nullptr), (uint16_t) currentQuestionIndex, (int8_t) answer, correct, latencyMs, playerAbilities[player]});
+        playerAbilities[player] = UpdateAbility(playerAbilities[player], telemetry.GetDifficulty(currentQuestionIndex), correct, playerAnswerCounts[player]++);
+
+        if (practiceMode && player == 0) {
+            int grade = GetPracticeGrade(answer != TELEMETRY_NO_ANSWER, correct, latencyMs);
+            practiceDeck.Review(currentQuestionIndex, grade, (uint32_t) (time(nullptr) / 60));
+            if (++practiceReviews % PRACTICE_SAVE_EVERY == 0) persistence.Write(practicePath, practiceDeck.Encode());
+        }
+    };
+
+    // The skill questions are aimed at: the player's, or the average of the human players in multiplayer
+    auto GetTargetAbility = [&]() {
+        if (singlePLayerSelected) return playerAbilities[0];
+        float sum = 0.0f;
+        int humans = 0;
+        for (int p = 0; p < (int) players.size(); p++) {
+            if (!IsBotSeat(p)) sum += playerAbilities[p], humans++;
+        }
+        return humans ? sum / humans : 0.0f;
+    };
+
+    auto RebuildQuestionSelector = [&]() {
+        std::vector<float> difficulties(bankSize);
+        for (size_t i = 0; i < bankSize; i++) difficulties[i] = telemetry.GetDifficulty(i);
+        questionSelector.Rebuild(difficulties);
+    };
+    startupJobs.push_back(jobs.Then(telemetryLoaded, "question selector", RebuildQuestionSelector));
+
+    // Practice takes the student's due cards, games aim at the players' skill
+    auto PickQuestion = [&]() {
+        if (practiceMode) {
+            uint32_t nowMinutes = (uint32_t) (time(nullptr) / 60);
+            currentQuestionIndex = practiceDeck.Next(sessionRandom, nowMinutes, currentQuestionIndex);
+            practiceDueCount = (int) practiceDeck.GetDueCount(nowMinutes);
+            currentQuestionId = currentQuestionIndex;
+            return;
+        }
+
+        float ability = GetTargetAbility();
+        currentQuestionIndex = questionSelector.Pick(sessionRandom, ability, history, historySize);
+        currentQuestionId = currentQuestionIndex;
+
+        // Half the math questions are generated on the spot, at a level that follows the player's skill
+        if (GetQuestionCategory(currentQuestionIndex) == CATEGORY_MATH && sessionRandom.NextUnit() < MATH_GENERATED_SHARE) {
+            int level = ability < -0.5f ? 0 : ability < 0.5f ? 1 : 2;
+            uint32_t seed = MakeMathSeed((uint32_t) sessionRandom.Next(), level);
+            GenerateMathQuestion(seed, questions[generatedSlot]);
+            currentQuestionIndex = generatedSlot;
+            currentQuestionId = GetGeneratedQuestionId(seed);
+        }
+    };
+
+    auto BeginReplay = [&]() {
+        uint64_t seed = GetMonotonicTimeNs();
+        sessionRandom.Seed(seed);
+        TraceLog(LOG_INFO, "REPLAY: Session seed %llu", (unsigned long long) seed);
+
+        // The session was just reseeded and the selector now has this session's difficulty estimates, so the first
+        // question is picked again from both
+        history.clear();
+        RebuildQuestionSelector();
+        PickQuestion();
+        for (BotPlayer& bot : bots) bot.Seed(sessionRandom.Next());
+        StartBotQuestion();
+
+        replay.Begin(singlePLayerSelected ? REPLAY_SINGLEPLAYER : REPLAY_MULTIPLAYER, seed, GetReplayPlayers(), GetMonotonicTimeNs());
+        replay.Record(REPLAY_QUESTION, 0, currentQuestionId, GetMonotonicTimeNs());
+        questionStartNs = GetMonotonicTimeNs();
+    };
+
+    auto FinishReplay = [&]() {
+        if (!replay.IsRecording()) return false;
+        replay.End(GetReplayPlayers(), GetMonotonicTimeNs());
+        persistence.Write(REPLAY_FILE_PATH, replay.GetData());
+        return true;
+    };
+
+    // Game over: saves the replay and appends the game to the history. Sessions left through the pause menu only
+    // keep their replay.
+    auto FinishGame = [&]() {
+        if (!FinishReplay()) return;
+        GameHistoryGame game;
+        if (BuildGameHistoryGame(replay.GetData(), questions, (int64_t) time(nullptr), game)) {
+            persistence.Append(GAME_HISTORY_FILE_PATH, EncodeGameHistoryGame(game));
+        }
+    };
+
     auto ResetGameVariables = [&]() {
 
         countdownTime = (currentScreen == MAIN_MENU || currentScreen == SINGLEPLAYER_GAMEOVER) ? 21 : 20;    
-        currentQuestionIndex = GetUniqueRandomValue(0, questions.size()-1, history, historySize);
+        PickQuestion();
+        replay.Record(REPLAY_QUESTION, 0, currentQuestionId, GetMonotonicTimeNs());
+        questionStartNs = GetMonotonicTimeNs();
+        StartBotQuestion();
         isAnswerCorrect = false; 
         timer = 0.0f;
 
         wrongAnswersIndices = {-1, -1};
         wrongAnswerIndex = -1;
 
-        isAnswerQ_Correct = false;
-        isAnswerW_Correct = false;
-        isAnswerE_Correct = false;
-        isAnswerR_Correct = false;
-
-        isAnswerQ_Wrong = false;
-        isAnswerW_Wrong = false;
-        isAnswerE_Wrong = false;
-        isAnswerR_Wrong = false;
+        for (int i = 0; i < 4; i++) {
+            isChoiceCorrect[i] = false;
+            isChoiceWrong[i] = false;
+        }
         
         enableInput = true;
         answerSelected = false;
         
-        player1Selected = false, player2Selected = false;
-        player1Answer = -1, player2Answer = -1;
-        player1AnswerTime = 0, player2AnswerTime = 0;
+        ResetPlayerAnswers(players);
         correctAnswer = false;
         gameMessage = "";
-        messageDisplayed = false;
         gameMessage1 = "";
         gameMessage2 = "";
 
@@ -456,111 +730,117 @@ int main(void)
             addHealthPoint = false;
             abilityF_Used = false;
 
+            std::fill(playerAbilities, playerAbilities + MAX_PLAYERS, 0.0f);
+            std::fill(playerAnswerCounts, playerAnswerCounts + MAX_PLAYERS, 0);
+
+            if (practiceMode) persistence.Write(practicePath, practiceDeck.Encode());
+            practiceMode = false;
+
             //Multiplayer variables
-            player1Name = "";
-            player2Name = "";
-            enteringPlayer1Name = false;
-            enteringPlayer2Name = false;
+            ResetPlayers(players, playerCount);
+            NameBots();
+            typingPlayer = -1;
             namesEntered = false;
-            player1Score = 0;
-            player2Score = 0;
-            player1Healthpoints = 10;
-            player2Healthpoints = 10;
-            player1Selected = false, player2Selected = false;
-            player1Answer = -1, player2Answer = -1;
-            player1AnswerTime = 0, player2AnswerTime = 0;
             correctAnswer = false;
             gameMessage = "";
             gameMessage1 = "";
             gameMessage2 = "";
-            gameOverDelayTimer = 0.0f;
+            isGameOverTriggered = false;
+            timeline.CancelAll();
 
+            matchClient.Disconnect();
+            onlineRoundId = 0;
+            onlineResultRoundId = 0;
         }
     };
 
 
     Font arcadeFont = LoadFont("assets/fonts/arcade.ttf");
 
-    Music mainMenuMusic = LoadMusicStream("assets/sounds/Flim.mp3");
-    Music singleplayerMusic = LoadMusicStream("assets/sounds/singleplayer-music.mp3");
-    Music multiplayerMusic = LoadMusicStream("assets/sounds/multiplayer-music.mp3");
-    Music singleplayerLowHealthMusic = LoadMusicStream("assets/sounds/low-health.mp3");
-
-    Sound menuButtonsSound = LoadSound("assets/sounds/button_click.mp3");
-    Sound correctAnswerSound = LoadSound("assets/sounds/correct_answer.mp3");
-    Sound wrongAnswerSound = LoadSound("assets/sounds/wrong_answer.mp3");
-    Sound gameoverSound = LoadSound("assets/sounds/gameover.mp3");
-    Sound playercorrect = LoadSound("assets/sounds/gotcorrect.mp3");
-    Sound bothWrong = LoadSound("assets/sounds/Both-wrong.mp3");
-    Sound playerWins = LoadSound("assets/sounds/playerWins.mp3");
-    SetSoundVolume(playerWins, 0.5f);
-    Sound buttonClicked = LoadSound("assets/sounds/correct_answer.mp3");
-
-    Sound timesUpSound = LoadSound("assets/sounds/no-time-left.mp3");
-    SetSoundVolume(timesUpSound, 0.5f);
-    Sound countdownSound = LoadSound("assets/sounds/3s-countdown.mp3");
-    SetSoundVolume(countdownSound, 0.3f);
+    // Wrap every bank question and answer at the sizes the screens draw them, the draw code then only looks them up
+    std::vector<std::vector<std::string>> questionLines(bankSize), answerLines(bankSize * 4);
+    startupJobs.push_back(jobs.ParallelFor("question layout", (int) bankSize, [&](int i) {
+        questionLines[i] = WrapText(arcadeFont, questions[i].questionText.c_str(), QUESTION_WRAP_WIDTH, QUESTION_FONT_SIZE);
+        for (int a = 0; a < 4; a++) {
+            answerLines[i * 4 + a] = WrapText(arcadeFont, questions[i].answers[a].c_str(), ANSWER_WRAP_WIDTH, ANSWER_FONT_SIZE);
+        }
+    }));
+
+    // Music streams on its own thread, the screens below only pick the track, see audio_engine.hpp
+    AudioEngine audio;
+    audio.LoadTrack(TRACK_MAIN_MENU, "assets/sounds/Flim.mp3");
+    audio.LoadTrack(TRACK_SINGLEPLAYER, "assets/sounds/singleplayer-music.mp3");
+    audio.LoadTrack(TRACK_MULTIPLAYER, "assets/sounds/multiplayer-music.mp3");
+    audio.LoadTrack(TRACK_LOW_HEALTH, "assets/sounds/low-health.mp3");
+
+    // Effects share one decode per file and play through voice pools, see sound_bank.hpp. buttonClicked and
+    // correctAnswerSound are the same file and so the same sound.
+    SoundBank sounds;
+    sounds.SetCompressed(compressedSounds);
+    SoundId menuButtonsSound = sounds.Load("assets/sounds/button_click.mp3", BUS_UI);
+    SoundId correctAnswerSound = sounds.Load("assets/sounds/correct_answer.mp3", BUS_GAMEPLAY);
+    SoundId wrongAnswerSound = sounds.Load("assets/sounds/wrong_answer.mp3", BUS_GAMEPLAY);
+    SoundId gameoverSound = sounds.Load("assets/sounds/gameover.mp3", BUS_GAMEPLAY, 1);
+    SoundId playercorrect = sounds.Load("assets/sounds/gotcorrect.mp3", BUS_GAMEPLAY);
+    SoundId bothWrong = sounds.Load("assets/sounds/Both-wrong.mp3", BUS_GAMEPLAY, 1);
+    SoundId playerWins = sounds.Load("assets/sounds/playerWins.mp3", BUS_GAMEPLAY, 1);
+    sounds.SetVolume(playerWins, 0.5f);
+    SoundId buttonClicked = sounds.Load("assets/sounds/correct_answer.mp3", BUS_GAMEPLAY);
+
+    SoundId timesUpSound = sounds.Load("assets/sounds/no-time-left.mp3", BUS_GAMEPLAY, 1);
+    sounds.SetVolume(timesUpSound, 0.5f);
+    SoundId countdownSound = sounds.Load("assets/sounds/3s-countdown.mp3", BUS_GAMEPLAY, 1);
+    sounds.SetVolume(countdownSound, 0.3f);
+    sounds.SetDucking(countdownSound, true);
+
+    audio.AttachSounds(&sounds);
+    audio.LogMemoryReport();
+    sounds.LogMemoryReport();
+    audio.Start();
     
 
-    auto SetMute = [&](bool muteMusic, bool muteUi) {
-        float musicVolume = muteMusic ? 0.0f : 1.0f;
-        float uiVolume = muteUi ? 0.0f : 1.0f;
-
-        SetMusicVolume(singleplayerMusic, musicVolume);
-        SetMusicVolume(singleplayerLowHealthMusic, musicVolume);
-        SetMusicVolume(mainMenuMusic, musicVolume);
-        SetMusicVolume(multiplayerMusic, musicVolume);
-
-        SetSoundVolume(menuButtonsSound, uiVolume);
-        SetSoundVolume(playerWins, uiVolume);
-        SetSoundVolume(bothWrong, uiVolume);
-        SetSoundVolume(playercorrect, uiVolume);
-        SetSoundVolume(buttonClicked, uiVolume);
-        SetSoundVolume(wrongAnswerSound, uiVolume);
-        SetSoundVolume(correctAnswerSound, uiVolume);
-        SetSoundVolume(gameoverSound, uiVolume);
-        SetSoundVolume(timesUpSound, muteUi ? 0.0f : 0.5f);
-        SetSoundVolume(countdownSound, muteUi ? 0.0f : 0.3f);
-    };
 
     // Main Menu Textures
-    Texture2D titleLogo = LoadTexture("assets/title-logo.png");
-    Texture2D menuBackground = LoadTexture("assets/main-menu-bg.png");
-    Texture2D settingsBackground = LoadTexture("assets/settings-bg.png");
-    Texture2D rulesScreen = LoadTexture("assets/rules-screen.png");
-    Texture2D rulesScreen1 = LoadTexture("assets/rules-screen1.png");
-    Texture2D pausedTxt = LoadTexture("assets/game-paused-txt.png");
-    Texture2D fiveHearts = LoadTexture("assets/five-hearts.png");
-    Texture2D startGameBackground = LoadTexture("assets/start-game-bg.png");
-    Texture2D exitBackground = LoadTexture("assets/exit-bg.png");
-    Texture2D readyScreen = LoadTexture("assets/ready-screen.png");
+    Texture2D titleLogo = LoadPreloadedTexture("assets/title-logo.png");
+    Texture2D menuBackground = LoadPreloadedTexture("assets/main-menu-bg.png");
+    Texture2D settingsBackground = LoadPreloadedTexture("assets/settings-bg.png");
+    Texture2D rulesScreen = LoadPreloadedTexture("assets/rules-screen.png");
+    Texture2D rulesScreen1 = LoadPreloadedTexture("assets/rules-screen1.png");
+    Texture2D pausedTxt = LoadPreloadedTexture("assets/game-paused-txt.png");
+    Texture2D fiveHearts = LoadPreloadedTexture("assets/five-hearts.png");
+    Texture2D startGameBackground = LoadPreloadedTexture("assets/start-game-bg.png");
+    Texture2D exitBackground = LoadPreloadedTexture("assets/exit-bg.png");
+    Texture2D readyScreen = LoadPreloadedTexture("assets/ready-screen.png");
 
     // Singleplayer Textures
-    Texture2D singleplayerBackground = LoadTexture("assets/singleplayer-bg.png");
-    Texture2D questionBox = LoadTexture("assets/question-box.png");
-    Texture2D health_1 = LoadTexture("assets/health/health_1.png");
-    Texture2D health_2 = LoadTexture("assets/health/health_2.png");
-    Texture2D health_3 = LoadTexture("assets/health/health_3.png");
-    Texture2D health_4 = LoadTexture("assets/health/health_4.png");
-    Texture2D health_5 = LoadTexture("assets/health/health_5.png");
-    Texture2D health_6 = LoadTexture("assets/health/health_6.png");
-    Texture2D health_7 = LoadTexture("assets/health/health_7.png");
-    Texture2D health_8 = LoadTexture("assets/health/health_8.png");
-    Texture2D health_9 = LoadTexture("assets/health/health_9.png");
-    Texture2D health_10 = LoadTexture("assets/health/health_10.png");
-    Texture2D health_11 = LoadTexture("assets/health/health_11.png");
-    Texture2D abilityA_Used_Texture = LoadTexture("assets/ability-a-used.png");
-    Texture2D abilityS_Used_Texture = LoadTexture("assets/ability-s-used.png");
-    Texture2D abilityD_Used_Texture = LoadTexture("assets/ability-d-used.png");
-    Texture2D abilityF_Used_Texture = LoadTexture("assets/ability-f-used.png");
+    Texture2D singleplayerBackground = LoadPreloadedTexture("assets/singleplayer-bg.png");
+    Texture2D questionBox = LoadPreloadedTexture("assets/question-box.png");
+    Texture2D health_1 = LoadPreloadedTexture("assets/health/health_1.png");
+    Texture2D health_2 = LoadPreloadedTexture("assets/health/health_2.png");
+    Texture2D health_3 = LoadPreloadedTexture("assets/health/health_3.png");
+    Texture2D health_4 = LoadPreloadedTexture("assets/health/health_4.png");
+    Texture2D health_5 = LoadPreloadedTexture("assets/health/health_5.png");
+    Texture2D health_6 = LoadPreloadedTexture("assets/health/health_6.png");
+    Texture2D health_7 = LoadPreloadedTexture("assets/health/health_7.png");
+    Texture2D health_8 = LoadPreloadedTexture("assets/health/health_8.png");
+    Texture2D health_9 = LoadPreloadedTexture("assets/health/health_9.png");
+    Texture2D health_10 = LoadPreloadedTexture("assets/health/health_10.png");
+    Texture2D health_11 = LoadPreloadedTexture("assets/health/health_11.png");
+    // Indexed by health points, the multiplayer HUD scales these per panel
+    Texture2D healthTextures[12] = {health_1, health_1, health_2, health_3, health_4, health_5, health_6, health_7, health_8, health_9, health_10, health_11};
+    float healthTextureScales[12] = {0.0f, 0.15f, 0.15f, 0.15f, 0.15f, 0.18f, 0.15f, 0.15f, 0.15f, 0.15f, 0.15f, 0.5f};
+    Texture2D abilityA_Used_Texture = LoadPreloadedTexture("assets/ability-a-used.png");
+    Texture2D abilityS_Used_Texture = LoadPreloadedTexture("assets/ability-s-used.png");
+    Texture2D abilityD_Used_Texture = LoadPreloadedTexture("assets/ability-d-used.png");
+    Texture2D abilityF_Used_Texture = LoadPreloadedTexture("assets/ability-f-used.png");
 
     // Multiplayer Textures
-    Texture2D multiplayerBackground = LoadTexture("assets/multiplayer-bg.png");
-    Texture2D controlScreen2 = LoadTexture("assets/controlScreen2.png");
-    Texture2D enterPlayerName = LoadTexture("assets/EnterPlayerName-screen.png");
+    Texture2D multiplayerBackground = LoadPreloadedTexture("assets/multiplayer-bg.png");
+    Texture2D controlScreen2 = LoadPreloadedTexture("assets/controlScreen2.png");
+    Texture2D enterPlayerName = LoadPreloadedTexture("assets/EnterPlayerName-screen.png");
 
-    Texture2D gameoverBackground = LoadTexture("assets/gameover-bg.png");
-    Texture2D leaderBoardBackground = LoadTexture("assets/Leaderboards-screen.png");
+    Texture2D gameoverBackground = LoadPreloadedTexture("assets/gameover-bg.png");
+    Texture2D leaderBoardBackground = LoadPreloadedTexture("assets/Leaderboards-screen.png");
 
     // Main Menu Buttons
     Button onePlayerBtn{"assets/one-player-btn.png", {0.0f, 500.0f}, 0.5f}; 
@@ -572,6 +852,7 @@ int main(void)
     Button exitBtn{"assets/exit-btn.png", {0.0f, 730.0f}, 0.6f};
 
     //Settings Buttons
+    Button settingsMainMenuBtn{"assets/main-menu-btn.png", {0, 700.0f}, 0.6f};
     Button muteUiFalse{"assets/mute-ui-false.png", {0, 300}, 1.0f};
     Button muteUiTrue{"assets/mute-ui-true.png", {0, 300}, 1.0f};
     Button muteMusicFalse{"assets/mute-music-false.png", {0, 450}, 1.0f};
@@ -580,9 +861,29 @@ int main(void)
     // Pause & Gameover Buttons 
     Button pauseBtn{"assets/pause-btn.png", {10.0f, 10.0f}, 0.7f};
     Button resumeBtn{"assets/resume-btn.png", {0.0f, 400.0f}, 0.7f};
+    Button pauseMainMenuBtn{"assets/main-menu-btn.png", {0, 530.0f}, 0.6f};
     Button restartBtn{"assets/restart-btn.png", {0, 500.0f}, 0.73f};
-    Button mainMenuBtn{"assets/main-menu-btn.png", {0, 620.0f}, 0.6f};
-    Button leaderboardsBtn{"assets/leaderboards-btn.png", {0, 620.0f}, 0.93f};
+    Button gameoverMainMenuBtn{"assets/main-menu-btn.png", {0, 600.0f}, 0.6f};
+    Button gameoverExitBtn{"assets/exit-btn.png", {0.0f, 700.0f}, 0.6f};
+    Button multiplayerRestartBtn{"assets/restart-btn.png", {0, 670.0f}, 0.73f};
+    Button multiplayerMainMenuBtn{"assets/main-menu-btn.png", {0, 760.0f}, 0.6f};
+    Button multiplayerExitBtn{"assets/exit-btn.png", {0.0f, 850.0f}, 0.6f};
+    Button leaderboardsBtn{"assets/leaderboards-btn.png", {0, 580.0f}, 0.93f};
+
+    // Each screen has its own copy of the shared buttons, drawn at its own size. Nothing moves a button after this:
+    // the game thread hit-tests them while the window thread draws.
+    settingsMainMenuBtn.imgScale = 0.9f;
+    pauseMainMenuBtn.imgScale = 0.84f;
+    gameoverMainMenuBtn.imgScale = 0.8f;
+    gameoverExitBtn.imgScale = 0.53f;
+    multiplayerRestartBtn.imgScale = 0.75f;
+    multiplayerMainMenuBtn.imgScale = 0.8f;
+    multiplayerExitBtn.imgScale = 0.53f;
+    Button* centeredButtons[] = {&onePlayerBtn, &twoPlayerBtn, &yesBtn, &noBtn, &settingsBtn, &startBtn, &exitBtn,
+                                 &settingsMainMenuBtn, &muteUiFalse, &muteUiTrue, &muteMusicFalse, &muteMusicTrue,
+                                 &resumeBtn, &pauseMainMenuBtn, &restartBtn, &gameoverMainMenuBtn, &gameoverExitBtn,
+                                 &multiplayerRestartBtn, &multiplayerMainMenuBtn, &multiplayerExitBtn, &leaderboardsBtn};
+    for (Button* button : centeredButtons) button->CenterHorizontally();
 
     // Singlepayer Buttons
     Button answerQ_Btn{"assets/answer-q.png", {150.0f, (float) (GetScreenHeight() - 350.0f)}, 1.3f};
@@ -603,155 +904,234 @@ int main(void)
     Button playerNameBoxBtn{"assets/playerNameBox-btn.png", {750.0f, 415.0f}, 0.85};
     Button playerNameBox1Btn{"assets/playerNameBox-btn.png", {750.0f, 580.0f}, 0.85};
 
-    Color pauseDark = {0,0,0, 100};
+    Button* answerButtons[4] = {&answerQ_Btn, &answerW_Btn, &answerE_Btn, &answerR_Btn};
+    Button* multiplayerAnswerButtons[4] = {&answerQUBtn, &answerWIBtn, &answerEOBtn, &answerRPBtn};
+    Color playerColors[MAX_PLAYERS] = {ORANGE, PURPLE, SKYBLUE, LIME, PINK, GOLD, MAROON, DARKBLUE};
 
-    //--------------------------------------------------------------------------------------
-    // Main game loop
-    while (!WindowShouldClose() && !exitConfirmed)
-    {  
-        float deltaTime = GetFrameTime();
+    // Keys, mouse and gamepad buttons are resolved to actions through this table, see input.cpp for the defaults.
+    // inputDevices polls them on the window thread, input hands the game thread what it captured.
+    std::vector<InputBinding> bindings = LoadInputBindings(INPUT_BINDINGS_FILE_PATH);
+    InputDispatcher inputDevices{bindings};
+    InputDispatcher input{bindings};
 
-        Vector2 mousePosition = GetMousePosition();
-        bool mouseClicked = IsMouseButtonPressed(MOUSE_BUTTON_LEFT); 
+    Color pauseDark = {0,0,0, 100};
 
-        switch(currentScreen) {
-            case MAIN_MENU:
+    // The music each screen wants. Low health takes over a game, the pause and exit prompts keep what is playing.
+    auto GetScreenTrack = [&]() -> MusicTrack {
+        switch (currentScreen) {
+            case SINGLEPLAYER: return healthPoints == 1 ? TRACK_LOW_HEALTH : TRACK_SINGLEPLAYER;
+            case MULTIPLAYER:
+            case ONLINE_MULTIPLAYER: return IsAnyPlayerAtHealth(players, 1) ? TRACK_LOW_HEALTH : TRACK_MULTIPLAYER;
+            case MULTIPLAYER_GAMEOVER:
+            case LEADERBOARDS:
+            case QUIZ_HOST: return TRACK_MULTIPLAYER;
+            case READY: return TRACK_NONE;    // The countdown sound plays alone
+            case PAUSE:
+            case EXIT: return audio.GetDesiredTrack();
+            default: return TRACK_MAIN_MENU;
+        }
+    };
 
-                if (!IsMusicStreamPlaying(mainMenuMusic)) PlayMusicStream(mainMenuMusic); // Play main menu music
-                if (IsMusicStreamPlaying(singleplayerMusic)) StopMusicStream(singleplayerMusic); // Stop singleplayer music
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
-                
-                // Reset variables
+    // Screen transitions. The update switch below only changes currentScreen; the loop then runs the exit hook of
+    // the old screen and the enter hook of the new one, once per transition, so resets do not run every frame.
+    // Screens without hooks, like the games coming back from the pause menu, keep their state.
+    auto EnterScreen = [&](GameScreen screen) {
+        switch (screen) {
+            case MAIN_MENU:
+                // A session left through the pause menu still gets its replay saved
+                FinishReplay();
                 ResetGameVariables();
+                break;
+            case SINGLEPLAYER_RULES:
+            case MULTIPLAYER_RULES:
+            case MULTIPLAYER_CONTROLS:
+                timer = 0.0f;    // Restarts the input cooldown
+                break;
+            case READY:
+                countdownTime = 4;
+                timeline.After(3.0f, [&]() { currentScreen = (singlePLayerSelected) ? SINGLEPLAYER : MULTIPLAYER; });
+                break;
+            case SINGLEPLAYER_GAMEOVER:
+                if (score > highscore) {
+                    highscore = score;
+                    SaveHighScore(persistence, SINGLEPLAYER_DATA_FILE_PATH, highscore);
+                }
+                break;
+            case MULTIPLAYER_GAMEOVER:
+                {
+                    int winner = GetWinningPlayer(players);
+                    if (winner != -1) {
+                        gameMessage = players[winner].name + " wins!";
+                        gameMessage1 = "Score: " + std::to_string(players[winner].score);
+                        gameMessage2 = "Remaining Health: " + std::to_string(players[winner].healthPoints);
+                    } else {
+                        int topScore = 0;
+                        for (const Player& player : players) topScore = std::max(topScore, player.score);
+                        gameMessage = "It's a draw!";
+                        gameMessage1 = "Score: " + std::to_string(topScore);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    };
 
-                exitBtn.imgScale = 0.6f;
-                exitBtn.position.y = 730.0f;
+    auto ExitScreen = [&](GameScreen screen) {
+        switch (screen) {
+            case READY:
+                // The countdown is over, the game and its replay start now
+                countdownTime = 20;
+                timer = 0.0f;
+                BeginReplay();
+                break;
+            default:
+                break;
+        }
+    };
 
-                mainMenuBtn.imgScale = 0.6f;
-                mainMenuBtn.position.y = 620.0f;
+    GameScreen activeScreen = currentScreen;    // The screen whose enter hook ran last
+    auto ChangeScreens = [&]() {
+        while (activeScreen != currentScreen) {
+            GameScreen previous = activeScreen;
+            activeScreen = currentScreen;
+            ExitScreen(previous);
+            EnterScreen(activeScreen);
+        }
+    };
+
+    // One tick of game logic, on the game thread. It owns the game state above; the window thread only sees the
+    // snapshots published after each tick.
+    auto UpdateGame = [&](const InputFrame& frame) {
+        float deltaTime = 1.0f / LOGIC_TICK_HZ;
+
+        Vector2 mousePosition = {frame.mouseX, frame.mouseY};
+        input.Update(frame);    // The actions the window thread captured since the last tick
+        bool mouseClicked = frame.clicked;
 
+        if (currentScreen == READY || currentScreen == SINGLEPLAYER || currentScreen == MULTIPLAYER || currentScreen == ONLINE_MULTIPLAYER) {
+            timeline.Advance(deltaTime);
+            ChangeScreens();    // A sequence may have ended the screen, the new one updates this frame already
+        }
+
+        switch(currentScreen) {
+            case MAIN_MENU:
                 if (startBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = STARTGAME;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 if (settingsBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = SETTINGS;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 if (exitBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = EXIT;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }   
             break;
             case STARTGAME:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
                 if (onePlayerBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = SINGLEPLAYER_RULES;
                     singlePLayerSelected = true;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 if (twoPlayerBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = MULTIPLAYER_RULES;
                     singlePLayerSelected = false;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 break;
             case SETTINGS:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
-                if (mainMenuBtn.isClicked(mousePosition, mouseClicked) || IsKeyPressed(KEY_ESCAPE)) {
+                if (settingsMainMenuBtn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_BACK)) {
                     currentScreen = MAIN_MENU;
-                    PlaySound(menuButtonsSound);
-                }
-                if (muteMusicFalse.isClicked(mousePosition, mouseClicked)) {
-                    muteMusic = true;
-                    SetMute(muteMusic, muteUi);
-                    PlaySound(menuButtonsSound);
-                }
-                if (muteUiFalse.isClicked(mousePosition, mouseClicked)) {
-                    muteUi = true;
-                    SetMute(muteMusic, muteUi);
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
-                if (muteMusicTrue.isClicked(mousePosition, mouseClicked)) {
-                    muteMusic = false;
-                    SetMute(muteMusic, muteUi);
-                    PlaySound(menuButtonsSound);
+                // Each toggle is drawn as whichever of its two buttons matches the setting, only that one is live
+                if ((muteMusic ? muteMusicTrue : muteMusicFalse).isClicked(mousePosition, mouseClicked)) {
+                    muteMusic = !muteMusic;
+                    SetBusMuted(BUS_MUSIC, muteMusic);
+                    sounds.Play(menuButtonsSound);
                 }
-                if (muteUiTrue.isClicked(mousePosition, mouseClicked)) {
-                    muteUi = false;
-                    SetMute(muteMusic, muteUi);
-                    PlaySound(menuButtonsSound);
+                if ((muteUi ? muteUiTrue : muteUiFalse).isClicked(mousePosition, mouseClicked)) {
+                    muteUi = !muteUi;
+                    SetBusMuted(BUS_UI, muteUi);
+                    SetBusMuted(BUS_GAMEPLAY, muteUi);    // The UI setting has always muted every effect
+                    sounds.Play(menuButtonsSound);
                 }
                 break;
             case SINGLEPLAYER_RULES:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
                 timer += deltaTime;
-                countdownTime = 4;
                 if (timer > inputCooldown) {
-                    if (IsKeyPressed(KEY_ESCAPE)) currentScreen = MAIN_MENU;
-                    else if (IsAnyKeyPressed() || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)|| IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+                    if (input.IsActionPressed(ACTION_BACK)) currentScreen = MAIN_MENU;
+                    else if (input.IsAnyInputPressed()) {
+                        practiceMode = input.IsActionPressed(ACTION_PRACTICE);
                         timer = 0;
                         currentScreen = READY;
                     } 
                 }
                 break;
             case MULTIPLAYER_RULES:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
                 timer += deltaTime;
-                countdownTime = 4;
                 if (timer > inputCooldown) {
-                    if (IsKeyPressed(KEY_ESCAPE)) currentScreen = MAIN_MENU;
-                    else if (IsAnyKeyPressed() || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)|| IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+                    if (input.IsActionPressed(ACTION_BACK)) currentScreen = MAIN_MENU;
+                    else if (input.IsAnyInputPressed()) {
                         timer = 0;
                         currentScreen = MULTIPLAYER_CONTROLS;
                     } 
                 }
                 break;
             case MULTIPLAYER_CONTROLS:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
                 timer += deltaTime;
-                countdownTime = 4;
                 if (timer > inputCooldown) {
-                    if (IsKeyPressed(KEY_ESCAPE)) currentScreen = MAIN_MENU;
-                    else if (IsAnyKeyPressed() || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)|| IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+                    if (input.IsActionPressed(ACTION_BACK)) currentScreen = MAIN_MENU;
+                    else if (input.IsAnyInputPressed()) {
                         timer = 0;
                         currentScreen = PLAYERNAME;
                     } 
                 }
                 break;
             case PLAYERNAME:
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
-                countdownTime = 4;
                 if (!namesEntered) {
                     if (playerNameBoxBtn.isClicked(mousePosition, mouseClicked)) {
-                        PlaySound(menuButtonsSound);
-                        enteringPlayer1Name = true;
-                        enteringPlayer2Name = false;
+                        sounds.Play(menuButtonsSound);
+                        typingPlayer = 0;
                     }
-                    if (playerNameBox1Btn.isClicked(mousePosition, mouseClicked)) {
-                        PlaySound(menuButtonsSound);
-                        enteringPlayer1Name = false;
-                        enteringPlayer2Name = true;
+                    if (playerNameBox1Btn.isClicked(mousePosition, mouseClicked) && !IsBotSeat(1)) {
+                        sounds.Play(menuButtonsSound);
+                        typingPlayer = 1;
                     }
-                    int key = GetCharPressed();
-                    while (key > 0) {
-                        if (enteringPlayer1Name && player1Name.size() < 11) {
-                            player1Name += static_cast<char>(key);
-                        }
-                        if (enteringPlayer2Name && player2Name.size() < 11) {
-                            player2Name += static_cast<char>(key);
-                        }
-                        key = GetCharPressed();
+                    if (input.IsActionPressed(ACTION_NEXT_PLAYER)) typingPlayer = (typingPlayer + 1) % (playerCount - botCount);
+
+                    // Change the number of players, extra players join on the other keyboard zones and gamepads
+                    if (input.IsActionPressed(ACTION_ADD_PLAYER) && playerCount < MAX_PLAYERS) playerCount++;
+                    if (input.IsActionPressed(ACTION_REMOVE_PLAYER) && playerCount > std::max(MIN_PLAYERS, botCount + 1)) playerCount--;
+                    if ((int) players.size() != playerCount) {
+                        SetPlayerCount(players, playerCount);
+                        NameBots();
+                        if (typingPlayer >= playerCount) typingPlayer = -1;
                     }
-                    if (IsKeyPressed(KEY_BACKSPACE)) {
-                        if (enteringPlayer1Name && !player1Name.empty()) {
-                            player1Name.pop_back();
+
+                    for (int i = 0; i < frame.charCount; i++) {
+                        if (typingPlayer != -1 && players[typingPlayer].name.size() < 11) {
+                            players[typingPlayer].name += static_cast<char>(frame.chars[i]);
                         }
-                        if (enteringPlayer2Name && !player2Name.empty()) {
-                            player2Name.pop_back();
+                    }
+                    if (input.IsActionPressed(ACTION_ERASE)) {
+                        if (typingPlayer != -1 && !players[typingPlayer].name.empty()) {
+                            players[typingPlayer].name.pop_back();
                         }
                     }
-                    if (IsKeyPressed(KEY_ENTER) && !player1Name.empty() && !player2Name.empty()) {
+                    // Online, the opponent types their name on their own cabinet
+                    if (onlineMode && input.IsActionPressed(ACTION_CONFIRM) && !players[0].name.empty()) {
+                        namesEntered = true;
+                        currentScreen = ONLINE_LOBBY;
+                        singlePLayerSelected = false;
+                    }
+                    else if (input.IsActionPressed(ACTION_CONFIRM) && !players[0].name.empty() && !players[1].name.empty()) {
+                        // Extra players may skip typing a name
+                        for (int i = 2; i < playerCount; i++) {
+                            if (players[i].name.empty()) players[i].name = "Player " + std::to_string(i + 1);
+                        }
                         namesEntered = true;
                         currentScreen = READY;
                         singlePLayerSelected = false;
@@ -767,9 +1147,8 @@ int main(void)
 
                 if (countdownTime < 0) countdownTime = 0;
 
-                if (!IsSoundPlaying(countdownSound)) PlaySound(countdownSound);
+                if (!sounds.IsPlaying(countdownSound)) sounds.Play(countdownSound);
 
-                if (IsMusicStreamPlaying(mainMenuMusic)) StopMusicStream(mainMenuMusic);
 
                 if (GetTime() - startTime >= 1.0) {
                     countdownTime--;
@@ -779,14 +1158,6 @@ int main(void)
                 if (countdownTime < 0) countdownTime = 0;
         
                 seconds = countdownTime % 60;
-
-                timer += deltaTime;
-
-                if (timer >= 3.0f) {
-                    currentScreen = (singlePLayerSelected) ? SINGLEPLAYER : MULTIPLAYER;
-                    countdownTime = 20;
-                    timer = 0.f;
-                }
                 break;
             case SINGLEPLAYER:
 
@@ -798,11 +1169,6 @@ int main(void)
                 
                 seconds = countdownTime % 60;
 
-                if (!IsMusicStreamPlaying(singleplayerMusic)) {
-                    PlayMusicStream(singleplayerMusic);
-                }
-                 
-                UpdateMusicStream(singleplayerMusic);  // Update music stream to continue playing it
 
                 if (GetTime() - startTime >= 1.0) {
                     countdownTime--;
@@ -814,29 +1180,17 @@ int main(void)
                 seconds = countdownTime % 60;
 
                 // Answers
-                if ((enableInput && answerQ_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && IsKeyPressed(KEY_Q))){
-                    selectedAnswerIndex = 0;
-                    answerSelected = true;
-                    if (selectedAnswerIndex == questions[currentQuestionIndex].correctAnswerIndex) isAnswerQ_Correct = true;
-                    if (selectedAnswerIndex != questions[currentQuestionIndex].correctAnswerIndex) isAnswerQ_Wrong = true;
-                } 
-                else if ((enableInput && answerW_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && IsKeyPressed(KEY_W))) {
-                    selectedAnswerIndex = 1;
-                    answerSelected = true;
-                    if (selectedAnswerIndex == questions[currentQuestionIndex].correctAnswerIndex) isAnswerW_Correct = true;
-                    if (selectedAnswerIndex != questions[currentQuestionIndex].correctAnswerIndex) isAnswerW_Wrong = true;
-                }
-                else if ((enableInput && answerE_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && IsKeyPressed(KEY_E))) {
-                    selectedAnswerIndex = 2;
-                    answerSelected = true;
-                    if (selectedAnswerIndex == questions[currentQuestionIndex].correctAnswerIndex) isAnswerE_Correct = true;
-                    if (selectedAnswerIndex != questions[currentQuestionIndex].correctAnswerIndex) isAnswerE_Wrong = true;
-                }
-                else if ((enableInput && answerR_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && IsKeyPressed(KEY_R))) {
-                    selectedAnswerIndex = 3;
-                    answerSelected = true;
-                    if (selectedAnswerIndex == questions[currentQuestionIndex].correctAnswerIndex) isAnswerR_Correct = true;
-                    if (selectedAnswerIndex != questions[currentQuestionIndex].correctAnswerIndex) isAnswerR_Wrong = true;
+                for (int i = 0; i < 4 && enableInput; i++) {
+                    if (answerButtons[i]->isClicked(mousePosition, mouseClicked) || input.IsActionPressed((InputAction) (ACTION_ANSWER_1 + i))) {
+                        selectedAnswerIndex = i;
+                        answerSelected = true;
+                        const InputActionEvent* pressed = input.FindAction((InputAction) (ACTION_ANSWER_1 + i));
+                        replay.Record(REPLAY_ANSWER, 0, i, pressed ? pressed->timestampNs : GetMonotonicTimeNs());
+                        RecordAnswer(0, i, pressed ? pressed->timestampNs : GetMonotonicTimeNs());
+                        if (selectedAnswerIndex == questions[currentQuestionIndex].correctAnswerIndex) isChoiceCorrect[i] = true;
+                        else isChoiceWrong[i] = true;
+                        break;
+                    }
                 }
                 
                 if (selectedAnswerIndex != -1) {
@@ -844,99 +1198,96 @@ int main(void)
                         isAnswerCorrect = true;
                         score++;
                         selectedAnswerIndex = -1;
-                        PlaySound(correctAnswerSound);
+                        sounds.Play(correctAnswerSound);
                     } else {
                         isAnswerCorrect = false;
-                        healthPoints--;
+                        if (!practiceMode) healthPoints--;    // Practice has no game over
                         selectedAnswerIndex = -1;
-                        PlaySound(wrongAnswerSound);
+                        sounds.Play(wrongAnswerSound);
                     }
                 }
 
-                if (seconds == 1) PlaySound(timesUpSound);
-
-                if (seconds == 0) {    // If time runs out:
-                    timer += deltaTime;
-                    selectedAnswerIndex = -1;
-                    enableInput = false;
-                    addHealthPoint = false;
-
-                    // Gives time to draw and show "Times Up!" text, dissapears after 1.5 seconds and draws the timer again
-                    if (timer > 1.5f) {
-                        healthPoints--;
-                        ResetGameVariables();
-                    }
-                }
+                if (seconds == 1) sounds.Play(timesUpSound);
 
-                else if (isAnswerCorrect || skipQuestion) {    // If answer is correct or skib ability used, resets variables
-                    //Reset timer, incase player corectly answers in the last second, since there is a 1.5s delay to reset variables
-                    countdownTime = 20;  
-                    timer += deltaTime;
-                    enableInput = false;
-                    
-                    // Gives time to draw and show "Correct!" text, dissapears after 1.5 seconds and draws the timer again
-                    if (timer > 1.5f) {
-                        if (addHealthPoint) healthPoints++;
-                        addHealthPoint = false;
-    
-                        if (skipQuestion) {
-                            score++;
-                            abilityS_Used = true;                       
-                        }
-
-                        skipQuestion = false;
-
-                        ResetGameVariables();
-                    }
-                } else if (!isAnswerCorrect && answerSelected) { // If answer is incorrect and player has selected an answer, resets variables
-                    //Reset timer, incase player corectly answers in the last second, since there is a 1.5s delay to reset variables
-                    countdownTime = 20;  
-                    timer += deltaTime;
-                    enableInput = false;
-                    
-                    // Gives time to draw  "Incorrect!" text, dissapears after 1.5 seconds and draws the timer again
-                    if (timer > 1.5f) {
+                // The result shows for 1.5 seconds ("Times Up!", "Correct!" or "Incorrect!"), then the next question
+                if (!timeline.IsPending(roundTask)) {
+                    if (seconds == 0) {    // If time runs out:
+                        selectedAnswerIndex = -1;
+                        enableInput = false;
                         addHealthPoint = false;
-                        ResetGameVariables();
+                        roundTask = timeline.After(1.5f, [&]() {
+                            if (!practiceMode) healthPoints--;
+                            replay.Record(REPLAY_ROUND_END, 0, ROUND_END_TIMEOUT, GetMonotonicTimeNs());
+                            RecordAnswer(0, TELEMETRY_NO_ANSWER, 0);
+                            ResetGameVariables();
+                        });
                     }
-                }
+                    else if (isAnswerCorrect || skipQuestion) {    // If answer is correct or skip ability used
+                        countdownTime = 20;    // So an answer in the last second does not also time out
+                        enableInput = false;
+                        roundTask = timeline.After(1.5f, [&]() {
+                            replay.Record(REPLAY_ROUND_END, 0, skipQuestion ? ROUND_END_SKIPPED : ROUND_END_ANSWERED, GetMonotonicTimeNs());
+                            if (addHealthPoint) healthPoints++;
+                            addHealthPoint = false;
+
+                            if (skipQuestion) {
+                                score++;
+                                abilityS_Used = true;
+                            }
+                            skipQuestion = false;
 
-                if (healthPoints == 1) {
-                    StopMusicStream(singleplayerMusic);
-                    if (!IsMusicStreamPlaying(singleplayerLowHealthMusic)) {
-                    PlayMusicStream(singleplayerLowHealthMusic);
+                            ResetGameVariables();
+                        });
                     }
-                    UpdateMusicStream(singleplayerLowHealthMusic);  // Update music stream to continue playing it
+                    else if (answerSelected) {    // Answered wrong
+                        countdownTime = 20;
+                        enableInput = false;
+                        roundTask = timeline.After(1.5f, [&]() {
+                            addHealthPoint = false;
+                            replay.Record(REPLAY_ROUND_END, 0, ROUND_END_ANSWERED, GetMonotonicTimeNs());
+                            ResetGameVariables();
+                        });
                     }
+                }
 
-                if (healthPoints <= 0) currentScreen = SINGLEPLAYER_GAMEOVER;
+                if (healthPoints <= 0) {
+                    FinishGame();
+                    sounds.Play(gameoverSound);
+                    currentScreen = SINGLEPLAYER_GAMEOVER;
+                }
 
                 // Pause
-                if (pauseBtn.isClicked(mousePosition, mouseClicked) || IsKeyPressed(KEY_ESCAPE)) {
-                    PlaySound(menuButtonsSound);
+                if (pauseBtn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_BACK)) {
+                    sounds.Play(menuButtonsSound);
                     previousScreen = SINGLEPLAYER;
                     currentScreen = PAUSE;
                 }
 
                 // Remove 2 wrong answers
-                if ((enableInput && !abilityA_Used && abilityA_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && !abilityA_Used && IsKeyPressed(KEY_A))) {
-                    wrongAnswersIndices = GetTwoWrongAnswersIndices(questions[currentQuestionIndex].correctAnswerIndex);
+                if (enableInput && !abilityA_Used && (abilityA_Btn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_ABILITY_1))) {
+                    wrongAnswersIndices = GetTwoWrongAnswersIndices(sessionRandom, questions[currentQuestionIndex].correctAnswerIndex);
                     abilityA_Used = true;
+                    replay.Record(REPLAY_ABILITY, 0, 0, GetMonotonicTimeNs());
+                    replay.Record(REPLAY_REMOVED_ANSWERS, 0, (1 << wrongAnswersIndices[0]) | (1 << wrongAnswersIndices[1]), GetMonotonicTimeNs());
                 }
                 // Skip question
-                if ((enableInput && !abilityS_Used && abilityS_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && !abilityS_Used && IsKeyPressed(KEY_S))) {
+                if (enableInput && !abilityS_Used && (abilityS_Btn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_ABILITY_2))) {
                     skipQuestion = true; 
                     abilityS_Used = true;
+                    replay.Record(REPLAY_ABILITY, 0, 1, GetMonotonicTimeNs());
                 }
                 // Gain 1 health point if question is answered correctly
-                if ((enableInput && !abilityD_Used && abilityD_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && !abilityD_Used && IsKeyPressed(KEY_D))) {
+                if (enableInput && !abilityD_Used && (abilityD_Btn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_ABILITY_3))) {
                     addHealthPoint = true;
                     abilityD_Used = true;
+                    replay.Record(REPLAY_ABILITY, 0, 2, GetMonotonicTimeNs());
                 }
                 // Remove 1 wrong option
-                if ((enableInput && !abilityF_Used && abilityF_Btn.isClicked(mousePosition, mouseClicked)) || (enableInput && !abilityF_Used && IsKeyPressed(KEY_F))) {
-                    wrongAnswerIndex = GetOneWrongAnswerIndex(questions[currentQuestionIndex].correctAnswerIndex);
+                if (enableInput && !abilityF_Used && (abilityF_Btn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_ABILITY_4))) {
+                    wrongAnswerIndex = GetOneWrongAnswerIndex(sessionRandom, questions[currentQuestionIndex].correctAnswerIndex);
                     abilityF_Used = true;
+                    replay.Record(REPLAY_ABILITY, 0, 3, GetMonotonicTimeNs());
+                    replay.Record(REPLAY_REMOVED_ANSWERS, 0, 1 << wrongAnswerIndex, GetMonotonicTimeNs());
                 }
                 break;
             case MULTIPLAYER:
@@ -946,11 +1297,6 @@ int main(void)
                 if (countdownTime < 0) countdownTime = 0;
                 seconds = countdownTime % 60;
 
-                if (!IsMusicStreamPlaying(multiplayerMusic)) {
-                    PlayMusicStream(multiplayerMusic);
-                }
-                 
-                UpdateMusicStream(multiplayerMusic);  // Update music stream to continue playing it
 
                 // Start the timer for a new question
                 if (!gameInProgress) { // Reset the game when a new question starts
@@ -959,162 +1305,85 @@ int main(void)
                     gameInProgress = true; // Indicate the game is in progress for the new question
                 }
 
-                // Handle Player 1 input (Q, W, E, R keys)
-                if (enableInput && !player1Selected) { // Check if input is enabled and Player 1 hasn't selected
-                    if (IsKeyPressed(KEY_Q)) {
-                        PlaySound(buttonClicked);
-                        player1Answer = 0;
-                        player1Selected = true; // Lock Player 1's choice
-                        player1AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_W)) {
-                        PlaySound(buttonClicked);
-                        player1Answer = 1;
-                        player1Selected = true; // Lock Player 1's choice
-                        player1AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_E)) {
-                        PlaySound(buttonClicked);
-                        player1Answer = 2;
-                        player1Selected = true; // Lock Player 1's choice
-                        player1AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_R)) {
-                        PlaySound(buttonClicked);
-                        player1Answer = 3;
-                        player1Selected = true; // Lock Player 1's choice
-                        player1AnswerTime = (int)(GetTime() * 1000);
-                    }
+                // Bots press their answers through the same action list, stamped with their planned press time
+                for (int i = 0; i < botCount && enableInput; i++) {
+                    InputActionEvent botAction;
+                    if (bots[i].PollAction(playerCount - botCount + i, GetMonotonicTimeNs(), botAction)) input.InjectAction(botAction);
                 }
 
-                // Handle Player 2 input (U, I, O, P keys)
-                if (enableInput && !player2Selected) { // Check if input is enabled and Player 2 hasn't selected
-                    if (IsKeyPressed(KEY_U)) {
-                        PlaySound(buttonClicked);
-                        player2Answer = 0;
-                        player2Selected = true; // Lock Player 2's choice
-                        player2AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_I)) {
-                        PlaySound(buttonClicked);
-                        player2Answer = 1;
-                        player2Selected = true; // Lock Player 2's choice
-                        player2AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_O)) {
-                        PlaySound(buttonClicked);
-                        player2Answer = 2;
-                        player2Selected = true; // Lock Player 2's choice
-                        player2AnswerTime = (int)(GetTime() * 1000);
-                    }
-                    else if (IsKeyPressed(KEY_P)) {
-                        PlaySound(buttonClicked);
-                        player2Answer = 3;
-                        player2Selected = true; // Lock Player 2's choice
-                        player2AnswerTime = (int)(GetTime() * 1000);
-                    }
+                // Handle every player's answer in real press order, the bindings decide which keys belong to whom
+                for (const InputActionEvent& action : input.GetActions()) {
+                    if (!enableInput || action.action < ACTION_ANSWER_1 || action.action > ACTION_ANSWER_4) continue;
+                    if (action.player >= (int) players.size() || players[action.player].selected) continue;
+
+                    sounds.Play(buttonClicked);
+                    Player& player = players[action.player];
+                    player.answer = action.action - ACTION_ANSWER_1;
+                    player.selected = true; // Lock the player's choice
+                    player.answerTimeNs = action.timestampNs;
+                    replay.Record(REPLAY_ANSWER, action.player, player.answer, action.timestampNs);
                 }
 
-                // After both players have selected their answers, proceed with evaluation
-                if (player1Selected && player2Selected) {
-                    // Stop the timer after both players select
-                    countdownTime = 20;
-                    timer += deltaTime;
+                // After every player has selected an answer: a short pause, the reveal, and the next question
+                if (HaveAllPlayersAnswered(players) && !timeline.IsPending(roundTask)) {
+                    countdownTime = 20;    // Stop the clock, nobody can time out any more
                     enableInput = false;
-                if (timer > 0.50f && !messageDisplayed) {
-                    // Evaluate answers
-                    if (player1Answer == questions[currentQuestionIndex].correctAnswerIndex && 
-                        player2Answer != questions[currentQuestionIndex].correctAnswerIndex) {
-                        gameMessage = "Player 1 got the correct answer!";
-                        PlaySound(playercorrect);
-                        player1Score++;
-                        player2Healthpoints--;
-                    }
-                    else if (player2Answer == questions[currentQuestionIndex].correctAnswerIndex && 
-                            player1Answer != questions[currentQuestionIndex].correctAnswerIndex) {
-                        gameMessage = "Player 2 got the correct answer!";
-                        PlaySound(playercorrect);
-                        player2Score++;
-                        player1Healthpoints--;
-                    }
-                    else if (player1Answer == questions[currentQuestionIndex].correctAnswerIndex && 
-                            player2Answer == questions[currentQuestionIndex].correctAnswerIndex) {
-                        // Both players got it correct, check who answered first
-                        if (player1AnswerTime < player2AnswerTime) {
-                            gameMessage = "Both players are correct, but Player 1 was faster!";
-                            PlaySound(playercorrect);
-                            player1Score++;
-                        } else if (player2AnswerTime < player1AnswerTime) {
-                            gameMessage = "Both players are correct, but Player 2 was faster!";
-                            PlaySound(playercorrect);
-                            player2Score++;
-                        }
-                    }
-                    else {
-                        // Both players got it wrong
-                        gameMessage = "Both players got the wrong answer!";
-                        PlaySound(bothWrong);
-                        player1Healthpoints--;
-                        player2Healthpoints--;
-                        correctAnswer = true;;
-                    }
-
-                        messageDisplayed = true; // Flag to indicate message is displayed
-                        timer = 0; // Reset timer for next delay
-                        
-                    }
-
-                    // Delay before resetting game variables
-                    if (messageDisplayed && timer > 2.5f) { // Adjust delay as needed
-                        ResetGameVariables(); // Reset variables after delay
-                        messageDisplayed = false; // Reset the flag
-                    }
+                    roundTask = timeline.Begin()
+                        .Wait(0.5f)
+                        .Then([&]() {
+                            for (int p = 0; p < (int) players.size(); p++) {
+                                if (!IsBotSeat(p)) RecordAnswer(p, players[p].answer, players[p].answerTimeNs);
+                            }
+                            // Evaluate answers in press order: the fastest correct player scores, wrong players lose health
+                            RoundResult result = EvaluateRound(players, questions[currentQuestionIndex].correctAnswerIndex);
+                            replay.Record(REPLAY_ROUND_END, 0, ROUND_END_ANSWERED, GetMonotonicTimeNs());
+                            gameMessage = DescribeRoundResult(result, players.size());
+
+                            if (result.correctCount == 0) {
+                                sounds.Play(bothWrong);
+                                correctAnswer = true;
+                            }
+                            else sounds.Play(playercorrect);
+                        })
+                        .Wait(2.5f)
+                        .Then([&]() { ResetGameVariables(); })
+                        .Start();
                 }
 
                 // Handle timer countdown logic (time out handling)
-                if (seconds == 1) PlaySound(timesUpSound);
+                if (seconds == 1) sounds.Play(timesUpSound);
 
-                if (seconds == 0) {  // If time runs out:
-                    timer += deltaTime;
-                    player1Answer = -1;
-                    player2Answer = -1;
+                if (seconds == 0 && !timeline.IsPending(roundTask)) {  // If time runs out:
+                    for (Player& player : players) player.answer = -1;
                     enableInput = false;
                     correctAnswer = true;
-                    gameMessage = "You both ran out of time!";
+                    gameMessage = DescribeTimeout(players.size());
 
-                    // Both players lose health points and reset game variables
-                    if (timer > 2.0f) {
-                        player1Healthpoints--;
-                        player2Healthpoints--;
+                    // Every player loses a health point, then the next question
+                    roundTask = timeline.After(2.0f, [&]() {
+                        for (Player& player : players) player.healthPoints--;
+                        for (int p = 0; p < (int) players.size(); p++) {
+                            if (!IsBotSeat(p)) RecordAnswer(p, TELEMETRY_NO_ANSWER, 0);
+                        }
+                        replay.Record(REPLAY_ROUND_END, 0, ROUND_END_TIMEOUT, GetMonotonicTimeNs());
                         ResetGameVariables();
-                    }
+                    });
                 }
 
-                if (player1Healthpoints == 1 || player2Healthpoints == 1) {
-                    StopMusicStream(multiplayerMusic);
-                    if (!IsMusicStreamPlaying(singleplayerLowHealthMusic)) {
-                        PlayMusicStream(singleplayerLowHealthMusic);
-                    }
-                    UpdateMusicStream(singleplayerLowHealthMusic);  // Update music stream to continue playing it
-                    }
-
 
                 // Add a delay before going to game over screen
-                if (player1Healthpoints <= 0 || player2Healthpoints <= 0) {
+                if (IsAnyPlayerOutOfHealth(players)) {
                     if (!isGameOverTriggered) {
                         isGameOverTriggered = true;  // Flag to indicate game-over condition
-                        gameOverDelayTimer = 0.0f; 
-                        // After Player 1 and Player 2 finish the round, update the leaderboard
-                        UpdateLeaderboard(player1Name, player1Score, player2Name, player2Score);  // Reset the timer
-                    }
-                }
-                // If the game-over condition has been triggered, increment the timer
-                if (isGameOverTriggered) {
-                    gameOverDelayTimer += deltaTime;  // Update timer with the elapsed time
-
-                    if (gameOverDelayTimer >= 2.5f) { // Add a 2.5-second delay
-                        currentScreen = MULTIPLAYER_GAMEOVER;
-                        PlaySound(playerWins);    // Switch to the Game Over screen
+                        // After every player finishes the round, update the leaderboard
+                        UpdateLeaderboard(persistence, players);
+                        lastMatchPlayers.clear();
+                        for (const Player& player : players) lastMatchPlayers.push_back(player.name);
+                        FinishGame();
+                        timeline.After(2.5f, [&]() {
+                            currentScreen = MULTIPLAYER_GAMEOVER;
+                            sounds.Play(playerWins);
+                        });
                     }
                 }
 
@@ -1123,65 +1392,172 @@ int main(void)
                         currentScreen = PAUSE;
                         previousScreen = MULTIPLAYER;                 
                     }
-                    if (IsKeyPressed(KEY_ESCAPE)) {
+                    if (input.IsActionPressed(ACTION_BACK)) {
                         currentScreen = PAUSE;
                         previousScreen = MULTIPLAYER;
                     }
 
+                break;
+            case ONLINE_LOBBY:
+                // gameMessage holds the connection error, if any, until the player goes back
+                if (gameMessage.empty()) {
+                    if (!matchClient.IsConnected() && !matchClient.Connect(serverHost.c_str(), serverPort, players[0].name)) {
+                        gameMessage = "Could not reach " + serverHost;
+                    }
+                    matchClient.Update(GetMonotonicTimeNs());
+                    if (gameMessage.empty() && !matchClient.IsConnected()) gameMessage = "The server closed the connection";
+                }
+
+                // The first question starts the match
+                if (matchClient.GetRoundId() != 0) {
+                    gameMessage = "";
+                    currentScreen = ONLINE_MULTIPLAYER;
+                }
+                if (input.IsActionPressed(ACTION_BACK)) {
+                    currentScreen = MAIN_MENU;
+                    sounds.Play(menuButtonsSound);
+                }
+                break;
+            case ONLINE_MULTIPLAYER:
+                matchClient.Update(GetMonotonicTimeNs());
+
+
+                // Mirror the server's state, the draw code is shared with the local mode
+                players = matchClient.GetPlayers();
+                seconds = matchClient.GetSecondsLeft();
+                if (matchClient.GetQuestionIndex() >= 0 && matchClient.GetQuestionIndex() < (int) bankSize) {
+                    currentQuestionIndex = matchClient.GetQuestionIndex();
+                    currentQuestionId = currentQuestionIndex;
+                }
+                if (matchClient.GetRoundId() != onlineRoundId) {
+                    onlineRoundId = matchClient.GetRoundId();
+                    gameMessage = "";
+                    correctAnswer = false;
+                    enableInput = true;
+                }
+
+                // Only the first keyboard zone answers, the opponent plays on their own cabinet. The press timestamp
+                // goes to the server, which checks it against the measured round trip before using it as the tie-break.
+                for (const InputActionEvent& action : input.GetActions()) {
+                    if (!enableInput || action.player != 0 || action.action < ACTION_ANSWER_1 || action.action > ACTION_ANSWER_4) continue;
+
+                    sounds.Play(buttonClicked);
+                    matchClient.SendAnswer(action.action - ACTION_ANSWER_1, action.timestampNs);
+                    enableInput = false;
+                }
+
+                {
+                    const MatchRoundResult& result = matchClient.GetLastResult();
+                    if (result.roundId == onlineRoundId && result.roundId != onlineResultRoundId) {
+                        onlineResultRoundId = result.roundId;
+                        enableInput = false;
+
+                        if (result.timedOut) {
+                            gameMessage = DescribeTimeout(players.size());
+                            correctAnswer = true;
+                        } else {
+                            gameMessage = DescribeRoundResult(result.result, players.size());
+                            if (result.result.correctCount == 0) {
+                                sounds.Play(bothWrong);
+                                correctAnswer = true;
+                            }
+                            else sounds.Play(playercorrect);
+                        }
+                    }
+                }
+
+                if (seconds == 1) sounds.Play(timesUpSound);
+
+                // The server ends the match when someone runs out of health or a cabinet disconnects
+                if (matchClient.IsGameOver() && !isGameOverTriggered) {
+                    isGameOverTriggered = true;
+                    UpdateLeaderboard(persistence, players);
+                    timeline.After(2.5f, [&]() {
+                        currentScreen = MULTIPLAYER_GAMEOVER;
+                        sounds.Play(playerWins);
+                    });
+                }
+
+                // Pause, the match keeps running on the server
+                if (pauseBtn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_BACK)) {
+                    currentScreen = PAUSE;
+                    previousScreen = ONLINE_MULTIPLAYER;
+                }
                 break;
             case PAUSE:
-                if (mainMenuBtn.isClicked(mousePosition, mouseClicked)) {
+                // Keep answering the server's pings so the measured round trip stays honest
+                if (previousScreen == ONLINE_MULTIPLAYER) matchClient.Update(GetMonotonicTimeNs());
+                if (pauseMainMenuBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = MAIN_MENU;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 if (resumeBtn.isClicked(mousePosition, mouseClicked)) {
 
                     currentScreen = previousScreen;
 
                     currentScreen = previousScreen; 
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
 
                 }
-                else if (IsKeyPressed(KEY_ESCAPE)) {
+                else if (input.IsActionPressed(ACTION_BACK)) {
                     currentScreen = previousScreen;
                 }
                 break;
+            case QUIZ_HOST:
+
+                quizResults = quizHost.GetResults();
+
+                if (!quizRoundOpen) {
+                    // ENTER sends the next question to every connected client
+                    if (input.IsActionPressed(ACTION_CONFIRM)) {
+                        ResetGameVariables();
+                        quizHost.BroadcastQuestion(questions[currentQuestionIndex], countdownTime);
+                        quizRoundOpen = true;
+                        startTime = GetTime();
+                        sounds.Play(menuButtonsSound);
+                    }
+                } else {
+                    if (GetTime() - startTime >= 1.0) {
+                        countdownTime--;
+                        startTime = GetTime();
+                    }
+                    if (countdownTime < 0) countdownTime = 0;
+                    seconds = countdownTime % 60;
+
+                    // Reveal when time is up, when every client answered, or early with ENTER
+                    bool everyoneAnswered = quizResults.clientCount > 0 && quizResults.answered >= quizResults.clientCount;
+                    if (seconds == 0 || everyoneAnswered || input.IsActionPressed(ACTION_CONFIRM)) {
+                        quizHost.BroadcastResults(questions[currentQuestionIndex].correctAnswerIndex);
+                        quizResults = quizHost.GetResults();
+                        quizRoundOpen = false;
+                        sounds.Play(correctAnswerSound);
+                    }
+                }
+
+                if (input.IsActionPressed(ACTION_BACK)) {
+                    sounds.Play(menuButtonsSound);
+                    currentScreen = EXIT;
+                }
+                break;
             case EXIT:
-                if (!exitFromGameover) UpdateMusicStream(mainMenuMusic);
                 if (yesBtn.isClicked(mousePosition, mouseClicked)) {
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                     exitConfirmed = true;
                 }
                 if (noBtn.isClicked(mousePosition, mouseClicked)) {
                     currentScreen = (exitFromGameover) ? SINGLEPLAYER_GAMEOVER:MAIN_MENU;  // Returns to GAMEOVER screen when player clicks no, if in the GAMEOVER screen
+                    if (quizHostMode) currentScreen = QUIZ_HOST;
                     exitFromGameover = false;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
                 }
                 break;
             case SINGLEPLAYER_GAMEOVER:
-                if (IsMusicStreamPlaying(singleplayerMusic) || IsMusicStreamPlaying(singleplayerLowHealthMusic)) {
-                    StopMusicStream(singleplayerMusic); // Stop multiplayer music
-                    StopMusicStream(singleplayerLowHealthMusic); // Stop singleplayer music
-                    PlaySound(gameoverSound);
-                }
-                
-
-                if (!IsMusicStreamPlaying(mainMenuMusic)) {
-                    PlayMusicStream(mainMenuMusic);
-                }
-                 
-                UpdateMusicStream(mainMenuMusic);  // Update music stream to continue playing it
-
-                if (score > highscore) {
-                    highscore = score;
-                    SaveHighScore(SINGLEPLAYER_DATA_FILE_PATH, highscore);
-                }
-                if (mainMenuBtn.isClicked(mousePosition, mouseClicked)) {
-                    PlaySound(menuButtonsSound);
+                if (gameoverMainMenuBtn.isClicked(mousePosition, mouseClicked)) {
+                    sounds.Play(menuButtonsSound);
                     currentScreen = MAIN_MENU;
                 }
-                if (exitBtn.isClicked(mousePosition, mouseClicked)) {
-                    PlaySound(menuButtonsSound);
+                if (gameoverExitBtn.isClicked(mousePosition, mouseClicked)) {
+                    sounds.Play(menuButtonsSound);
                     currentScreen = EXIT;
                     exitFromGameover = true;
                 }
@@ -1192,49 +1568,152 @@ int main(void)
                 } 
                 break;
             case MULTIPLAYER_GAMEOVER:
-                if (!IsMusicStreamPlaying(multiplayerMusic)) {
-                    PlayMusicStream(multiplayerMusic);
-                }
-                UpdateMusicStream(multiplayerMusic);  // Update music stream to continue playing it
-                // Determine the winner based on scores
-                if (player1Score > player2Score) {
-                    gameMessage = player1Name + " wins!";
-                    gameMessage1 = "Score: " + std::to_string(player1Score);           
-                    gameMessage2 = "Remaining Health: " + std::to_string(player1Healthpoints);
-                } else if (player2Score > player1Score) {
-                    gameMessage = player2Name + " wins! ";
-                    gameMessage1 = "Score: " + std::to_string(player2Score);           
-                    gameMessage2 = "Remaining Health: " + std::to_string(player2Healthpoints);
-                } else {
-                    gameMessage = "It's a draw!";
-                    gameMessage1 = "Score: " + std::to_string(player1Score);
+                if (leaderboardsBtn.isClicked(mousePosition, mouseClicked)) {
+                    leaderboardPage = 0;
+                    currentScreen = LEADERBOARDS;
                 }
-
-                if (leaderboardsBtn.isClicked(mousePosition, mouseClicked)) currentScreen = LEADERBOARDS;
-                if (mainMenuBtn.isClicked(mousePosition, mouseClicked)) currentScreen = MAIN_MENU;
-                if (exitBtn.isClicked(mousePosition, mouseClicked)) currentScreen = EXIT;
-                if (restartBtn.isClicked(mousePosition, mouseClicked)) {    // Reset variables and return to RULES GameScreen
+                if (multiplayerMainMenuBtn.isClicked(mousePosition, mouseClicked)) currentScreen = MAIN_MENU;
+                if (multiplayerExitBtn.isClicked(mousePosition, mouseClicked)) currentScreen = EXIT;
+                if (multiplayerRestartBtn.isClicked(mousePosition, mouseClicked)) {    // Reset variables and return to RULES GameScreen
                     isGameOverTriggered = false;
                     ResetGameVariables();
                     currentScreen = MULTIPLAYER_RULES; 
                 } 
                 break;
             case LEADERBOARDS:
-                if (!IsMusicStreamPlaying(multiplayerMusic)) {
-                    PlayMusicStream(multiplayerMusic);
-                }
-                UpdateMusicStream(multiplayerMusic);  // Update music stream to continue playing it
                 // Pause
-                if (pauseBtn.isClicked(mousePosition, mouseClicked) || IsKeyPressed(KEY_ESCAPE)) {
+                if (pauseBtn.isClicked(mousePosition, mouseClicked) || input.IsActionPressed(ACTION_BACK)) {
                     previousScreen = LEADERBOARDS;
                     currentScreen = PAUSE;
-                    PlaySound(menuButtonsSound);
+                    sounds.Play(menuButtonsSound);
+                }
+                {
+                    size_t pageCount = (leaderboard.Size() + LEADERBOARD_PAGE_SIZE - 1) / LEADERBOARD_PAGE_SIZE;
+                    if (input.IsActionPressed(ACTION_PREVIOUS_PAGE) && leaderboardPage > 0) leaderboardPage--;
+                    if (input.IsActionPressed(ACTION_NEXT_PAGE) && leaderboardPage + 1 < pageCount) leaderboardPage++;
                 }
                 break;
             default:
                 break;
             }
-        
+
+        ChangeScreens();
+        audio.SetDesiredTrack(GetScreenTrack());    // The audio thread crossfades when it changes
+    };
+
+    // Window frames hand their input to the game thread here, it hands back what to draw
+    SpscQueue<InputFrame, 64> inputFrames;
+    TripleBuffer<GameSnapshot> snapshots;
+
+    // Copies what the screens draw into the next snapshot. The buffers are recycled, so the strings and vectors
+    // keep their storage from tick to tick.
+    auto PublishSnapshot = [&]() {
+        GameSnapshot& view = snapshots.Back();
+        view.screen = currentScreen;
+        view.question = questions[currentQuestionIndex];
+        view.questionIndex = currentQuestionIndex;
+        view.seconds = seconds;
+        view.score = score;
+        view.highscore = highscore;
+        view.healthPoints = healthPoints;
+
+        view.abilityA_Used = abilityA_Used;
+        view.abilityS_Used = abilityS_Used;
+        view.abilityD_Used = abilityD_Used;
+        view.abilityF_Used = abilityF_Used;
+        view.skipQuestion = skipQuestion;
+        view.isAnswerCorrect = isAnswerCorrect;
+        view.answerSelected = answerSelected;
+        view.addHealthPoint = addHealthPoint;
+        for (int i = 0; i < 4; i++) {
+            view.isChoiceCorrect[i] = isChoiceCorrect[i];
+            view.isChoiceWrong[i] = isChoiceWrong[i];
+            view.isRemoved[i] = wrongAnswersIndices[0] == i || wrongAnswersIndices[1] == i || wrongAnswerIndex == i;
+        }
+        view.practiceMode = practiceMode;
+        view.practiceDueCount = practiceDueCount;
+        view.practiceCardCount = (int) practiceDeck.GetCardCount();
+
+        view.players = players;
+        view.playerCount = playerCount;
+        view.typingPlayer = typingPlayer;
+        view.correctAnswer = correctAnswer;
+        view.gameMessage = gameMessage;
+        view.gameMessage1 = gameMessage1;
+        view.gameMessage2 = gameMessage2;
+        view.isInMatch = matchClient.IsInMatch();
+        view.quizResults = quizResults;
+        view.quizRoundOpen = quizRoundOpen;
+
+        view.leaderboardPage = leaderboardPage;
+        view.leaderboardSize = leaderboard.Size();
+        view.leaderboardEntries.clear();
+        view.lastMatchPlayers.clear();
+        view.lastMatchRanks.clear();
+        if (currentScreen == LEADERBOARDS) {
+            view.leaderboardEntries = leaderboard.GetPage(leaderboardPage * LEADERBOARD_PAGE_SIZE, LEADERBOARD_PAGE_SIZE);
+            for (size_t i = 0; i < lastMatchPlayers.size() && i < 4; i++) {
+                view.lastMatchPlayers.push_back(lastMatchPlayers[i]);
+                view.lastMatchRanks.push_back(leaderboard.GetRank(lastMatchPlayers[i]));    // O(log n) each
+            }
+        }
+
+        view.muteUi = muteUi;
+        view.muteMusic = muteMusic;
+        snapshots.Publish();
+    };
+
+    // Everything the first tick needs is loaded once the startup jobs are done
+    jobs.Wait(jobs.WhenAll(startupJobs, "startup"));
+    UnloadPreloaded();
+    TraceLog(LOG_INFO, "JOBS: Loaded in %.1f ms with %i workers, %llu steals", (GetMonotonicTimeNs() - loadStartNs) / 1e6,
+             jobs.GetThreadCount(), (unsigned long long) jobs.GetStealCount());
+
+    // The drawn question's wrapped lines: the bank's from the startup layout, generated ones wrapped on first draw
+    auto GetQuestionLines = [&](const GameSnapshot& view) -> const std::vector<std::string>& {
+        if (view.questionIndex < (int) bankSize) return questionLines[view.questionIndex];
+        return GetWrappedText(arcadeFont, view.question.questionText.c_str(), QUESTION_WRAP_WIDTH, QUESTION_FONT_SIZE);
+    };
+    auto GetAnswerLines = [&](const GameSnapshot& view, int answer) -> const std::vector<std::string>& {
+        if (view.questionIndex < (int) bankSize) return answerLines[view.questionIndex * 4 + answer];
+        return GetWrappedText(arcadeFont, view.question.answers[answer].c_str(), ANSWER_WRAP_WIDTH, ANSWER_FONT_SIZE);
+    };
+
+    //--------------------------------------------------------------------------------------
+    // Game thread: a fixed tick, however fast the window draws
+    EnterScreen(activeScreen);
+    PublishSnapshot();
+    std::atomic<bool> logicRunning(true);
+    std::thread logicThread([&]() {
+        const uint64_t tickNs = 1000000000ull / LOGIC_TICK_HZ;
+        uint64_t nextTickNs = GetMonotonicTimeNs();
+        InputFrame frame, next;
+        while (logicRunning.load(std::memory_order_relaxed)) {
+            ClearInputFrame(frame);
+            while (inputFrames.Pop(next)) AppendInputFrame(frame, next);
+            UpdateGame(frame);
+            PublishSnapshot();
+
+            // Late ticks run back to back to catch up, unless the game fell so far behind it is better to skip ahead
+            nextTickNs += tickNs;
+            uint64_t nowNs = GetMonotonicTimeNs();
+            if (nowNs < nextTickNs) std::this_thread::sleep_for(std::chrono::nanoseconds(nextTickNs - nowNs));
+            else if (nowNs - nextTickNs > LOGIC_MAX_LAG_TICKS * tickNs) nextTickNs = nowNs;
+        }
+    });
+
+    //--------------------------------------------------------------------------------------
+    // Main game loop: polls the window and draws the latest snapshot. raylib only reads input and draws on the
+    // thread that opened the window.
+    InputFrame pendingInput;
+    ClearInputFrame(pendingInput);
+    while (!WindowShouldClose() && !exitConfirmed)
+    {  
+        inputDevices.Update();    // Translate this frame's input events into actions
+        inputDevices.Capture(pendingInput);
+        if (inputFrames.Push(pendingInput)) ClearInputFrame(pendingInput);    // Otherwise kept, and added to next frame
+
+        const GameSnapshot& view = snapshots.Read();
 
         //----------------------------------------------------------------------------------
         // Draw
@@ -1242,7 +1721,7 @@ int main(void)
         BeginDrawing();
         ClearBackground(GRAY);
 
-        switch (currentScreen)
+        switch (view.screen)
         {
         case MAIN_MENU:
             DrawTexture(menuBackground, 0,0, WHITE);
@@ -1261,7 +1740,7 @@ int main(void)
             DrawTexture(singleplayerBackground, 0, 0, WHITE);
             DrawTextureEx(questionBox, {(float)(GetScreenWidth() - questionBox.width * 1.8) / 2.0f, 200}, 0, 1.8, WHITE);
             
-            DrawQuestionText(arcadeFont, questions[currentQuestionIndex].questionText.c_str(), 800, GetScreenWidth(), GetScreenHeight(), 30, BLACK, false);
+            DrawQuestionText(arcadeFont, GetQuestionLines(view), GetScreenWidth(), GetScreenHeight(), QUESTION_FONT_SIZE, BLACK, false);
 
             answerQ_Btn.DrawButton();
             answerW_Btn.DrawButton();
@@ -1269,239 +1748,217 @@ int main(void)
             answerR_Btn.DrawButton();
             
             // Draw Answers/Choices.
-            if (isAnswerQ_Correct) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[0].c_str(), 25.0f, 1.0f, GREEN, answerQ_Btn.position.x, answerQ_Btn.position.y, answerQ_Btn.width, answerQ_Btn.height, 600, false);
-            else DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[0].c_str(), 25.0f, 1.0f, (wrongAnswersIndices[0] != 0 && wrongAnswersIndices[1] != 0 && wrongAnswerIndex != 0 && !isAnswerQ_Wrong) ? BLACK : RED, answerQ_Btn.position.x, answerQ_Btn.position.y, answerQ_Btn.width, answerQ_Btn.height, 600, false); 
-            
-            if (isAnswerW_Correct) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[1].c_str(), 25.0f, 1.0f, GREEN, answerW_Btn.position.x, answerW_Btn.position.y, answerW_Btn.width, answerW_Btn.height, 600, false);
-            else DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[1].c_str(), 25.0f, 1.0f, (wrongAnswersIndices[0] != 1 && wrongAnswersIndices[1] != 1 && wrongAnswerIndex != 1 && !isAnswerW_Wrong) ? BLACK : RED, answerW_Btn.position.x, answerW_Btn.position.y, answerW_Btn.width, answerW_Btn.height, 600, false);
-
-            if (isAnswerE_Correct) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[2].c_str(), 25.0f, 1.0f, GREEN, answerE_Btn.position.x, answerE_Btn.position.y, answerE_Btn.width, answerE_Btn.height, 600, false);
-            else DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[2].c_str(), 25.0f, 1.0f, (wrongAnswersIndices[0] != 2 && wrongAnswersIndices[1] != 2 && wrongAnswerIndex != 2 && !isAnswerE_Wrong) ? BLACK : RED, answerE_Btn.position.x, answerE_Btn.position.y, answerE_Btn.width, answerE_Btn.height, 600, false);
-
-            if (isAnswerR_Correct) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[3].c_str(), 25.0f, 1.0f, GREEN, answerR_Btn.position.x, answerR_Btn.position.y, answerR_Btn.width, answerR_Btn.height, 600, false);
-            else DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[3].c_str(), 25.0f, 1.0f, (wrongAnswersIndices[0] != 3 && wrongAnswersIndices[1] != 3 && wrongAnswerIndex != 3 && !isAnswerR_Wrong) ? BLACK : RED, answerR_Btn.position.x, answerR_Btn.position.y, answerR_Btn.width, answerR_Btn.height, 600, false);
+            for (int i = 0; i < 4; i++) {
+                Color answerColor = view.isChoiceCorrect[i] ? GREEN : (view.isRemoved[i] || view.isChoiceWrong[i]) ? RED : BLACK;
+                DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, answerColor, answerButtons[i]->position.x, answerButtons[i]->position.y, answerButtons[i]->width, answerButtons[i]->height, false);
+            }
 
             // Draw Timer
-            if (seconds == 0) {
+            if (view.seconds == 0) {
                 DrawTextHorizontal(arcadeFont, "Times Up!", 50.0f, 1.0f, RED, 100.0f);  
             }
-            else if (skipQuestion) {
+            else if (view.skipQuestion) {
                 DrawTextHorizontal(arcadeFont, "Skip!", 50.0f, 1.0f, ORANGE, 100.0f);  
             }
-            else if (!isAnswerCorrect && answerSelected) {
+            else if (!view.isAnswerCorrect && view.answerSelected) {
                 DrawTextHorizontal(arcadeFont, "Wrong!", 50.0f, 1.0f, RED, 100.0f);
             }
-            else if (!isAnswerCorrect && seconds != 0) {
-                DrawTextHorizontal(arcadeFont, TextFormat("Timer: %i", seconds), 50.0f, 1.0f, BLACK, 100.0f);
+            else if (!view.isAnswerCorrect && view.seconds != 0) {
+                DrawTextHorizontal(arcadeFont, TextFormat("Timer: %i", view.seconds), 50.0f, 1.0f, BLACK, 100.0f);
             } 
             else {
                 DrawTextHorizontal(arcadeFont, "Correct!", 50.0f, 1.0f, LIME, 100.0f);
             }
 
-            if (addHealthPoint) {
+            if (view.addHealthPoint) {
                 DrawTextHorizontal(arcadeFont, "Answer correctly to gain health!", 20.0f, 1.0f, BLACK, 170.0f);
             }
             
             // Draw Score
-            DrawTextEx(arcadeFont, TextFormat("Score: %i", score), {100.0f, 350.0f}, 30.0f, 1.0f, BLACK);
+            DrawTextEx(arcadeFont, TextFormat("Score: %i", view.score), {100.0f, 350.0f}, 30.0f, 1.0f, BLACK);
+            if (view.practiceMode) {
+                DrawTextEx(arcadeFont, TextFormat("Due: %i of %i cards", view.practiceDueCount, view.practiceCardCount), {100.0f, 300.0f}, 30.0f, 1.0f, BLACK);
+            }
 
             // Draw Health
-            DrawTextEx(arcadeFont, "Health: ", {100.0f, 400.0f}, 30.0f, 1.0f, (healthPoints == 1) ? RED:BLACK);
-            if (healthPoints == 11) DrawTextureEx(health_11, {100.0f, 450.0f}, 0.0f, 0.5f, WHITE);
-            if (healthPoints == 10) DrawTextureEx(health_10, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 9) DrawTextureEx(health_9, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 8) DrawTextureEx(health_8, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 7) DrawTextureEx(health_7, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 6) DrawTextureEx(health_6, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 5) DrawTextureEx(health_5, {100.0f, 450.0f}, 0.0f, 0.18f, WHITE);
-            if (healthPoints == 4) DrawTextureEx(health_4, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 3) DrawTextureEx(health_3, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 2) DrawTextureEx(health_2, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (healthPoints == 1) DrawTextureEx(health_1, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            DrawTextEx(arcadeFont, "Health: ", {100.0f, 400.0f}, 30.0f, 1.0f, (view.healthPoints == 1) ? RED:BLACK);
+            if (view.healthPoints == 11) DrawTextureEx(health_11, {100.0f, 450.0f}, 0.0f, 0.5f, WHITE);
+            if (view.healthPoints == 10) DrawTextureEx(health_10, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 9) DrawTextureEx(health_9, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 8) DrawTextureEx(health_8, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 7) DrawTextureEx(health_7, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 6) DrawTextureEx(health_6, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 5) DrawTextureEx(health_5, {100.0f, 450.0f}, 0.0f, 0.18f, WHITE);
+            if (view.healthPoints == 4) DrawTextureEx(health_4, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 3) DrawTextureEx(health_3, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 2) DrawTextureEx(health_2, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
+            if (view.healthPoints == 1) DrawTextureEx(health_1, {100.0f, 450.0f}, 0.0f, 0.15f, WHITE);
 
             // Draw Abilities
-            if (abilityA_Used) DrawTextureEx(abilityA_Used_Texture, {abilityA_Btn.position.x, abilityA_Btn.position.y}, 0, abilityA_Btn.imgScale, WHITE);
+            if (view.abilityA_Used) DrawTextureEx(abilityA_Used_Texture, {abilityA_Btn.position.x, abilityA_Btn.position.y}, 0, abilityA_Btn.imgScale, WHITE);
             else abilityA_Btn.DrawButton();
 
-            if (abilityS_Used) DrawTextureEx(abilityS_Used_Texture, {abilityS_Btn.position.x, abilityS_Btn.position.y}, 0, abilityS_Btn.imgScale, WHITE);
+            if (view.abilityS_Used) DrawTextureEx(abilityS_Used_Texture, {abilityS_Btn.position.x, abilityS_Btn.position.y}, 0, abilityS_Btn.imgScale, WHITE);
             else abilityS_Btn.DrawButton();
 
-            if (abilityD_Used) DrawTextureEx(abilityD_Used_Texture, {abilityD_Btn.position.x, abilityD_Btn.position.y}, 0, abilityD_Btn.imgScale, WHITE);
+            if (view.abilityD_Used) DrawTextureEx(abilityD_Used_Texture, {abilityD_Btn.position.x, abilityD_Btn.position.y}, 0, abilityD_Btn.imgScale, WHITE);
             else abilityD_Btn.DrawButton();
 
-            if (abilityF_Used) DrawTextureEx(abilityF_Used_Texture, {abilityF_Btn.position.x, abilityF_Btn.position.y}, 0, abilityF_Btn.imgScale, WHITE);
+            if (view.abilityF_Used) DrawTextureEx(abilityF_Used_Texture, {abilityF_Btn.position.x, abilityF_Btn.position.y}, 0, abilityF_Btn.imgScale, WHITE);
             else abilityF_Btn.DrawButton();
 
             pauseBtn.DrawButton();
             break;
         case MULTIPLAYER:
+        case ONLINE_MULTIPLAYER:
             DrawTexture(multiplayerBackground, 0,0, WHITE);
             DrawTextureEx(questionBox, {(float)(GetScreenWidth() - questionBox.width * 1.9) / 2.0f, 150}, 0, 1.9, WHITE);
-            DrawQuestionText(arcadeFont, questions[currentQuestionIndex].questionText.c_str(), 800, GetScreenWidth(), GetScreenHeight(), 30, BLACK, true);
+            DrawQuestionText(arcadeFont, GetQuestionLines(view), GetScreenWidth(), GetScreenHeight(), QUESTION_FONT_SIZE, BLACK, true);
             
-            DrawTextHighlight(arcadeFont, "Player 1", 140.0f, 240.0f, 20.0f, 0.5f, ORANGE);
-
-            DrawTextHighlight(arcadeFont, "Player 2", 1610.0f, 240.0f, 20.0f, 0.5f, PURPLE);
+            // Draw every player's name, score and health on a panel scaled to the number of players
+            for (int p = 0; p < (int) view.players.size(); p++) {
+                float hudScale;
+                Vector2 hud = GetPlayerHudPosition(p, view.players.size(), &hudScale);
 
-            for (int x = -2; x <= 2; x++) {
-                for (int y = -2; y <= 2; y++) {
-                    if (x != 0 || y != 0) {
-                        DrawCenteredTextAtX(player1Name.c_str(), arcadeFont, 212 + x, 190 + y, 10, 40, screenWidth * 0.8f, ORANGE);
+                for (int x = -2; x <= 2; x++) {
+                    for (int y = -2; y <= 2; y++) {
+                        if (x != 0 || y != 0) {
+                            DrawCenteredTextAtX(view.players[p].name.c_str(), arcadeFont, hud.x + 110 * hudScale + x, hud.y + y, 10, (int) (40 * hudScale), 400 * hudScale, playerColors[p]);
+                        }
                     }
                 }
-            }
 
-            DrawCenteredTextAtX(player1Name.c_str(), arcadeFont, 212, 190, 10, 40, screenWidth * 0.8f, BLACK);
+                DrawCenteredTextAtX(view.players[p].name.c_str(), arcadeFont, hud.x + 110 * hudScale, hud.y, 10, (int) (40 * hudScale), 400 * hudScale, BLACK);
 
-            for (int x = -2; x <= 2; x++) {
-                for (int y = -2; y <= 2; y++) {
-                    if (x != 0 || y != 0) {
-                        DrawCenteredTextAtX(player2Name.c_str(), arcadeFont, 1690 + x, 190 + y, 10, 40, screenWidth * 0.8f, PURPLE);
-                    }
+                DrawTextHighlight(arcadeFont, TextFormat("Player %i", p + 1), hud.x + 40 * hudScale, hud.y + 50 * hudScale, 20.0f * hudScale, 0.5f, playerColors[p]);
+                DrawTextHighlight(arcadeFont, TextFormat("Score: %i", view.players[p].score), hud.x, hud.y + 160 * hudScale, 30 * hudScale, 1.0f, playerColors[p]);
+                DrawTextHighlight(arcadeFont, "Health: ", hud.x, hud.y + 210 * hudScale, 30 * hudScale, 1.0f, playerColors[p]);
+
+                int health = view.players[p].healthPoints;
+                if (health >= 1 && health <= 11) {
+                    DrawTextureEx(healthTextures[health], {hud.x - 10.0f, hud.y + 260 * hudScale}, 0.0f, healthTextureScales[health] * hudScale, WHITE);
                 }
             }
 
-            DrawCenteredTextAtX(player2Name.c_str(), arcadeFont, 1690, 190, 10, 40, screenWidth * 0.8f, BLACK);
-
-            // Draw Player 1 score
-            DrawTextHighlight(arcadeFont, TextFormat("Score: %i", player1Score), 100, 350, 30, 1.0f, ORANGE);
-            // Draw Player 2 score
-            DrawTextHighlight(arcadeFont, TextFormat("Score: %i", player2Score), 1590, 350, 30, 1.0f, PURPLE);
-
-
-            // Draw Player 1 health
-            DrawTextHighlight(arcadeFont, "Health: ", 100, 400, 30, 1.0f, ORANGE);
-            // Draw Player 2 health
-            DrawTextHighlight(arcadeFont, "Health: ", 1590, 400, 30, 1.0f, PURPLE);
-
             answerQUBtn.DrawButton();
             answerWIBtn.DrawButton();
             answerEOBtn.DrawButton();
             answerRPBtn.DrawButton();
 
-            // Player 1's answers
+            // Draw the answers, outlined in the color of every player who picked them
             for (int i = 0; i < 4; i++) {
-                // If Player 1 has selected this answer, highlight it with an orange color
-                if (player1Answer == i) {
-                    // Draw the highlight first (outline effect) using a small offset
-                    for (int x = -2; x <= 2; x++) {
-                        for (int y = -2; y <= 2; y++) {
-                            if (x != 0 || y != 0) {  // Skip the center to avoid overlapping
-                                if (i == 0) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, ORANGE, answerQUBtn.position.x + (float)x, answerQUBtn.position.y + (float)y, answerQUBtn.width, answerQUBtn.height, 600, false);
-                                else if (i == 1) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, ORANGE, answerWIBtn.position.x + (float)x, answerWIBtn.position.y + (float)y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                                else if (i == 2) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, ORANGE, answerEOBtn.position.x + (float)x, answerEOBtn.position.y + (float)y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                                else if (i == 3) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(),25.0f, 1.0f, ORANGE, answerRPBtn.position.x + (float)x, answerRPBtn.position.y + (float)y, answerRPBtn.width, answerRPBtn.height, 600, false);
-                            }
-                        }
-                    }
-                }
+                Button* button = multiplayerAnswerButtons[i];
+                for (int p = 0; p < (int) view.players.size(); p++) {
+                    if (view.players[p].answer != i) continue;
 
-                // Draw the actual answer in black for Player 1
-                if (i == 0) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerQUBtn.position.x, answerQUBtn.position.y, answerQUBtn.width, answerQUBtn.height, 600, false);
-                else if (i == 1) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerWIBtn.position.x, answerWIBtn.position.y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                else if (i == 2) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerEOBtn.position.x, answerEOBtn.position.y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                else if (i == 3) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerRPBtn.position.x, answerRPBtn.position.y, answerRPBtn.width, answerRPBtn.height, 600, false);
-            }
-
-            // Player 2's answers
-            for (int i = 0; i < 4; i++) {
-                // If Player 2 has selected this answer, highlight it with a PURPLE color
-                if (player2Answer == i) {
                     // Draw the highlight first (outline effect) using a small offset
                     for (int x = -2; x <= 2; x++) {
                         for (int y = -2; y <= 2; y++) {
                             if (x != 0 || y != 0) {  // Skip the center to avoid overlapping
-                                if (i == 0) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, PURPLE, answerQUBtn.position.x + (float)x, answerQUBtn.position.y + (float)y, answerQUBtn.width, answerQUBtn.height, 600, false);
-                                else if (i == 1) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, PURPLE, answerWIBtn.position.x + (float)x, answerWIBtn.position.y + (float)y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                                else if (i == 2) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, PURPLE, answerEOBtn.position.x + (float)x, answerEOBtn.position.y + (float)y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                                else if (i == 3) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, PURPLE, answerRPBtn.position.x + (float)x, answerRPBtn.position.y + (float)y, answerRPBtn.width, answerRPBtn.height, 600, false);
+                                DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, playerColors[p], button->position.x + (float)x, button->position.y + (float)y, button->width, button->height, false);
                             }
                         }
                     }
                 }
-            
-                // Draw the actual answer in black for Player 2
-                if (i == 0) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerQUBtn.position.x, answerQUBtn.position.y, answerQUBtn.width, answerQUBtn.height, 600, false); 
-                else if (i == 1) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerWIBtn.position.x, answerWIBtn.position.y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                else if (i == 2) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerEOBtn.position.x, answerEOBtn.position.y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                else if (i == 3) DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[i].c_str(), 25.0f, 1.0f, BLACK, answerRPBtn.position.x, answerRPBtn.position.y, answerRPBtn.width, answerRPBtn.height, 600, false);
-            
+
+                // Draw the actual answer in black
+                DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, BLACK, button->position.x, button->position.y, button->width, button->height, false);
             }
             
-            //If both player got the wrong answer then it reveals the correct one
-            if (correctAnswer) {
+            //If every player got the wrong answer then it reveals the correct one
+            if (view.correctAnswer) {
                 // Draw the correct answer with green highlight
-                for (int x = -2; x <= 2; x++) { 
-                    for (int y = -2; y <= 2; y++) {
-                        if (x != 0 || y != 0) {
-                            DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[0].c_str(), 25.0f, 1.0f, (questions[currentQuestionIndex].correctAnswerIndex == 0) ? GREEN : RED, answerQUBtn.position.x + (float)x, answerQUBtn.position.y + (float)y, answerQUBtn.width, answerQUBtn.height, 600, false);
-                            DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[1].c_str(), 25.0f, 1.0f, (questions[currentQuestionIndex].correctAnswerIndex == 1) ? GREEN : RED, answerWIBtn.position.x + (float)x, answerWIBtn.position.y + (float)y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                            DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[2].c_str(), 25.0f, 1.0f, (questions[currentQuestionIndex].correctAnswerIndex == 2) ? GREEN : RED, answerEOBtn.position.x + (float)x, answerEOBtn.position.y + (float)y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                            DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[3].c_str(), 25.0f, 1.0f, (questions[currentQuestionIndex].correctAnswerIndex == 3) ? GREEN : RED, answerRPBtn.position.x + (float)x, answerRPBtn.position.y + (float)y, answerRPBtn.width, answerRPBtn.height, 600, false);
+                for (int i = 0; i < 4; i++) {
+                    Button* button = multiplayerAnswerButtons[i];
+                    Color revealColor = (view.question.correctAnswerIndex == i) ? GREEN : RED;
+                    for (int x = -2; x <= 2; x++) { 
+                        for (int y = -2; y <= 2; y++) {
+                            if (x != 0 || y != 0) {
+                                DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, revealColor, button->position.x + (float)x, button->position.y + (float)y, button->width, button->height, false);
+                            }
                         }
                     }
-                }
 
-                DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[0].c_str(), 25.0f, 1.0f, BLACK, answerQUBtn.position.x, answerQUBtn.position.y, answerQUBtn.width,answerQUBtn.height, 600, false);
-                DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[1].c_str(), 25.0f, 1.0f, BLACK, answerWIBtn.position.x, answerWIBtn.position.y, answerWIBtn.width, answerWIBtn.height, 600, false);
-                DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[2].c_str(), 25.0f, 1.0f, BLACK, answerEOBtn.position.x, answerEOBtn.position.y, answerEOBtn.width, answerEOBtn.height, 600, false);
-                DrawAnswerText(arcadeFont, questions[currentQuestionIndex].answers[3].c_str(), 25.0f, 1.0f, BLACK, answerRPBtn.position.x, answerRPBtn.position.y, answerRPBtn.width, answerRPBtn.height, 600, false);
-                    
+                    DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, BLACK, button->position.x, button->position.y, button->width, button->height, false);
+                }
             }
 
             // Display the message after answers are evaluated
-            if (!gameMessage.empty()) {
+            if (!view.gameMessage.empty()) {
                 // Calculate the width of the text to center it
-                Vector2 textSize = MeasureTextEx(arcadeFont, gameMessage.c_str(), 30.0f, 1.0f);
-                DrawTextHighlight(arcadeFont, gameMessage.c_str(), (float) (GetScreenWidth() - textSize.x) / 2.0f, (float) (GetScreenHeight() - 400), 30.0f, 1.0f, GREEN);
+                Vector2 textSize = MeasureTextEx(arcadeFont, view.gameMessage.c_str(), 30.0f, 1.0f);
+                DrawTextHighlight(arcadeFont, view.gameMessage.c_str(), (float) (GetScreenWidth() - textSize.x) / 2.0f, (float) (GetScreenHeight() - 400), 30.0f, 1.0f, GREEN);
             }
 
             // Draw Timer at the start of the question
-            if (seconds > 0) DrawTextHorizontal(arcadeFont, TextFormat("Timer: %i", seconds), 50.0f, 1.0f, BLACK, 100.0f);
+            if (view.seconds > 0) DrawTextHorizontal(arcadeFont, TextFormat("Timer: %i", view.seconds), 50.0f, 1.0f, BLACK, 100.0f);
             else DrawTextHorizontal(arcadeFont, "Times Up!", 50.0f, 1.0f, RED, 100.0f);  // Display "Times Up!"
 
-            // Draw Health for Player 1
-            if (player1Healthpoints == 11) DrawTextureEx(health_11, {90.0f, 450.0f}, 0.0f, 0.5f, WHITE);
-            if (player1Healthpoints == 10) DrawTextureEx(health_10, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 9) DrawTextureEx(health_9, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 8) DrawTextureEx(health_8, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 7) DrawTextureEx(health_7, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 6) DrawTextureEx(health_6, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 5) DrawTextureEx(health_5, {90.0f, 450.0f}, 0.0f, 0.18f, WHITE);
-            if (player1Healthpoints == 4) DrawTextureEx(health_4, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 3) DrawTextureEx(health_3, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 2) DrawTextureEx(health_2, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player1Healthpoints == 1) DrawTextureEx(health_1, {90.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-
-            // Draw Health for Player 2
-            if (player2Healthpoints == 11) DrawTextureEx(health_11, {1580.0f, 450.0f}, 0.0f, 0.5f, WHITE);
-            if (player2Healthpoints == 10) DrawTextureEx(health_10, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 9) DrawTextureEx(health_9, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 8) DrawTextureEx(health_8, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 7) DrawTextureEx(health_7, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 6) DrawTextureEx(health_6, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 5) DrawTextureEx(health_5, {1580.0f, 450.0f}, 0.0f, 0.18f, WHITE);
-            if (player2Healthpoints == 4) DrawTextureEx(health_4, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 3) DrawTextureEx(health_3, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 2) DrawTextureEx(health_2, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-            if (player2Healthpoints == 1) DrawTextureEx(health_1, {1580.0f, 450.0f}, 0.0f, 0.15f, WHITE);
-
             pauseBtn.DrawButton();
             break;
+        case QUIZ_HOST:
+            DrawTexture(multiplayerBackground, 0, 0, WHITE);
+            DrawTextHorizontal(arcadeFont, TextFormat("Classroom quiz - %i connected on port %i", view.quizResults.clientCount, quizPort), 30, 1, BLACK, 40);
+
+            if (view.quizResults.round == 0) {
+                DrawTextHorizontal(arcadeFont, "Press ENTER to send the first question", 40, 1, BLACK, 450);
+                break;
+            }
+
+            DrawTextureEx(questionBox, {(float)(GetScreenWidth() - questionBox.width * 1.9) / 2.0f, 150}, 0, 1.9, WHITE);
+            DrawQuestionText(arcadeFont, GetQuestionLines(view), GetScreenWidth(), GetScreenHeight(), QUESTION_FONT_SIZE, BLACK, true);
+
+            // Every answer shows a live vote bar above it, the correct one turns green on reveal
+            for (int i = 0; i < 4; i++) {
+                Button* button = multiplayerAnswerButtons[i];
+                button->DrawButton();
+
+                Color answerColor = BLACK;
+                if (!view.quizRoundOpen) answerColor = (view.quizResults.correctAnswerIndex == i) ? GREEN : RED;
+                DrawAnswerText(arcadeFont, GetAnswerLines(view, i), ANSWER_FONT_SIZE, 1.0f, answerColor, button->position.x, button->position.y, button->width, button->height, false);
+
+                float share = (view.quizResults.answered > 0) ? (float) view.quizResults.counts[i] / view.quizResults.answered : 0.0f;
+                DrawRectangle((int) button->position.x, (int) button->position.y - 28, (int) (button->width * share), 20, playerColors[i]);
+                DrawTextEx(arcadeFont, TextFormat("%i", view.quizResults.counts[i]), {button->position.x + button->width - 60, button->position.y - 30}, 22, 1, BLACK);
+            }
+
+            if (view.quizRoundOpen) {
+                DrawTextHorizontal(arcadeFont, TextFormat("Timer: %i", view.seconds), 50.0f, 1.0f, BLACK, 100.0f);
+                DrawTextHorizontal(arcadeFont, TextFormat("Answered: %i / %i - ENTER to reveal", view.quizResults.answered, view.quizResults.clientCount), 30, 1, BLACK, GetScreenHeight() - 420);
+            } else {
+                if (view.quizResults.fastestCorrectName[0] != '\0') {
+                    DrawTextHorizontal(arcadeFont, TextFormat("Fastest: %s (%.2fs)", view.quizResults.fastestCorrectName, view.quizResults.fastestCorrectNs / 1e9), 40, 1, GREEN, 100.0f);
+                }
+                float averageSeconds = (view.quizResults.answered > 0) ? view.quizResults.totalResponseNs / 1e9f / view.quizResults.answered : 0.0f;
+                DrawTextHorizontal(arcadeFont, TextFormat("%i answered, average %.2fs - ENTER for the next question", view.quizResults.answered, averageSeconds), 30, 1, BLACK, GetScreenHeight() - 420);
+            }
+            break;
+        case ONLINE_LOBBY:
+            DrawTexture(multiplayerBackground, 0, 0, WHITE);
+            if (!view.gameMessage.empty()) DrawTextHorizontal(arcadeFont, view.gameMessage.c_str(), 40, 1, RED, 450);
+            else if (view.isInMatch) DrawTextHorizontal(arcadeFont, "Opponent found! Get ready...", 40, 1, BLACK, 450);
+            else DrawTextHorizontal(arcadeFont, TextFormat("Waiting for an opponent on %s...", serverHost.c_str()), 40, 1, BLACK, 450);
+            DrawTextHorizontal(arcadeFont, "Press ESC to go back", 30, 1, BLACK, GetScreenHeight() - 200);
+            break;
         case LEADERBOARDS:
             DrawTexture(leaderBoardBackground, 0, 0, WHITE);
             pauseBtn.DrawButton();
 
-            // Draw the top 10 leaderboard entries
-            for (size_t i = 0; i < leaderboard.size(); i++) {
-                const LeaderboardEntry& entry = leaderboard[i];
-                // Draw the player's rank and name separately
-                std::string rankText = std::to_string(i + 1) + ". " + entry.playerName;
-                DrawTextEx(arcadeFont, rankText.c_str(), (Vector2){550, yOffsets[i]}, 22.0f, 2.0f, BLACK);
-                // Now, draw the player's score separately with a different offset or style
-                std::string scoreText = std::to_string(entry.score);
-                DrawTextEx(arcadeFont, scoreText.c_str(), (Vector2){1320, yOffsets[i]}, 22.0f, 2.0f, BLACK); // Adjust the X position (500 here)
+            // Draw one page of leaderboard entries
+            {
+                const std::vector<LeaderboardEntry>& page = view.leaderboardEntries;
+                for (size_t i = 0; i < page.size(); i++) {
+                    const LeaderboardEntry& entry = page[i];
+                    // Draw the player's rank and name separately
+                    std::string rankText = std::to_string(view.leaderboardPage * LEADERBOARD_PAGE_SIZE + i + 1) + ". " + entry.playerName;
+                    DrawTextEx(arcadeFont, rankText.c_str(), (Vector2){550, yOffsets[i]}, 22.0f, 2.0f, BLACK);
+                    // Now, draw the player's score separately with a different offset or style
+                    std::string scoreText = std::to_string(entry.score);
+                    DrawTextEx(arcadeFont, scoreText.c_str(), (Vector2){1320, yOffsets[i]}, 22.0f, 2.0f, BLACK); // Adjust the X position (500 here)
+                }
+            }
 
+            if (view.leaderboardSize > 0) {
                 // Draw shadow effect by drawing the same text at various offsets for "PLAYER"
                 for (int x = -2; x <= 2; x++) {
                     for (int y = -2; y <= 2; y++) {
@@ -1521,49 +1978,44 @@ int main(void)
                     }
                 }
                 DrawTextEx(arcadeFont, "SCORE", (Vector2){1220, 400}, 45.0f, 2.0f, YELLOW);
+
+                size_t pageCount = (view.leaderboardSize + LEADERBOARD_PAGE_SIZE - 1) / LEADERBOARD_PAGE_SIZE;
+                DrawTextEx(arcadeFont, TextFormat("Page %i of %i  (LEFT / RIGHT)", (int) view.leaderboardPage + 1, (int) pageCount),
+                           (Vector2){550, 880}, 22.0f, 2.0f, BLACK);
+
+                // Where the players of the last match stand overall
+                for (size_t i = 0; i < view.lastMatchPlayers.size(); i++) {
+                    size_t rank = view.lastMatchRanks[i];
+                    if (rank == 0) continue;
+                    DrawTextEx(arcadeFont, TextFormat("%s: #%i of %i", view.lastMatchPlayers[i].c_str(), (int) rank, (int) view.leaderboardSize),
+                               (Vector2){550, 920 + 30.0f * i}, 22.0f, 2.0f, BLACK);
+                }
             }
             break;
         case SETTINGS:
             DrawTexture(settingsBackground, 0, 0 , WHITE);
 
-            mainMenuBtn.imgScale = 0.9f;
-            mainMenuBtn.position.y = 700.0f;
-            mainMenuBtn.DrawButtonHorizontal();
+            settingsMainMenuBtn.DrawButtonHorizontal();
 
             DrawTextHorizontal(arcadeFont, "Main Menu Music: Flim - Aphex Twin", 30.0f, 0.5f, BLACK, 100.0f);
             DrawTextHorizontal(arcadeFont, "Copyright Sounds and Music From: https://www.zapsplat.com", 30.0f, 0.5f, BLACK, 200.0f);
 
-           if (muteUi) {
-                muteUiFalse.position.y = 0;
-                muteUiTrue.position.y = 300;
-                muteUiTrue.DrawButtonHorizontal();
-            } 
-            else {
-                muteUiTrue.position.y = 0;
-                muteUiFalse.position.y = 300;
-                muteUiFalse.DrawButtonHorizontal();
-            }
+            if (view.muteUi) muteUiTrue.DrawButtonHorizontal();
+            else muteUiFalse.DrawButtonHorizontal();
 
-            if (muteMusic) {
-                muteMusicFalse.position.y = 0;
-                muteMusicTrue.position.y = 450;
-                muteMusicTrue.DrawButtonHorizontal();
-            } 
-            else {
-                muteMusicTrue.position.y = 0;
-                muteMusicFalse.position.y = 450;
-                muteMusicFalse.DrawButtonHorizontal();
-            }
+            if (view.muteMusic) muteMusicTrue.DrawButtonHorizontal();
+            else muteMusicFalse.DrawButtonHorizontal();
 
             break;
         case READY:
             DrawTexture(readyScreen, 0, 0, WHITE);
-            if (seconds > 0) DrawTextHorizontal(arcadeFont, TextFormat("in %i", seconds), 70.0f, 1.0f, WHITE, GetScreenHeight() - 200.0f);
+            if (view.seconds > 0) DrawTextHorizontal(arcadeFont, TextFormat("in %i", view.seconds), 70.0f, 1.0f, WHITE, GetScreenHeight() - 200.0f);
             else DrawTextHorizontal(arcadeFont, "Go!", 80.0f, 1.0f, GREEN, GetScreenHeight() - 200.0f);
             break;
         case SINGLEPLAYER_RULES:
             DrawTexture(rulesScreen, 0, 0, WHITE);
             DrawTextHorizontal(arcadeFont, "Press any button to start", 30, 1, WHITE, GetScreenHeight() - 200);
+            DrawTextHorizontal(arcadeFont, "Press TAB to practice your weak areas", 25, 1, WHITE, GetScreenHeight() - 150);
             break;
         case MULTIPLAYER_RULES:
             DrawTexture(rulesScreen1, 0, 0, WHITE);
@@ -1572,9 +2024,6 @@ int main(void)
         case MULTIPLAYER_CONTROLS:
             DrawTexture(controlScreen2, 0,0,WHITE);
              DrawTextHorizontal(arcadeFont, "Press any button to proceed", 30, 1, WHITE, GetScreenHeight() - 200);
-            if (timer > inputCooldown) {
-                if (IsAnyKeyPressed() || IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) currentScreen = PLAYERNAME;
-            }
             break;
         case PLAYERNAME:
             DrawTexture(enterPlayerName, 0, 0, WHITE);
@@ -1582,15 +2031,24 @@ int main(void)
             playerNameBox1Btn.DrawButton();
 
             //Player 1 name input
-            DrawTextHighlight(arcadeFont, player1Name.c_str(), 840.0f, 455.0f, 30, 1.0f, ORANGE);
+            DrawTextHighlight(arcadeFont, view.players[0].name.c_str(), 840.0f, 455.0f, 30, 1.0f, ORANGE);
 
-            if (enteringPlayer1Name) DrawTextHighlight(arcadeFont, "Typing...", 840.0f, 540.0f, 20.0f, 1.0f, ORANGE);
+            if (view.typingPlayer == 0) DrawTextHighlight(arcadeFont, "Typing...", 840.0f, 540.0f, 20.0f, 1.0f, ORANGE);
 
             //Player 2 name input        
-            DrawTextHighlight(arcadeFont, player2Name.c_str(), 840.0f, 620.0f, 30.0f, 1.0f, PURPLE);
+            DrawTextHighlight(arcadeFont, view.players[1].name.c_str(), 840.0f, 620.0f, 30.0f, 1.0f, PURPLE);
 
-            if (enteringPlayer2Name) DrawTextHighlight(arcadeFont, "Typing... ", 840.0f, 705.0f, 20.0f, 1.0f, PURPLE);
-            
+            if (view.typingPlayer == 1) DrawTextHighlight(arcadeFont, "Typing... ", 840.0f, 705.0f, 20.0f, 1.0f, PURPLE);
+
+            // Extra players are listed on both sides of the two name boxes
+            for (int p = 2; p < (int) view.players.size(); p++) {
+                float posX = (p % 2 == 0) ? 150.0f : 1400.0f;
+                float posY = 415.0f + ((p - 2) / 2) * 90.0f;
+                DrawTextHighlight(arcadeFont, TextFormat("P%i: %s", p + 1, view.players[p].name.c_str()), posX, posY, 30.0f, 1.0f, playerColors[p]);
+                if (view.typingPlayer == p) DrawTextHighlight(arcadeFont, "Typing...", posX, posY + 40.0f, 20.0f, 1.0f, playerColors[p]);
+            }
+
+            DrawTextHorizontal(arcadeFont, TextFormat("Players: %i - UP/DOWN to change, TAB for the next name", view.playerCount), 25, 1, WHITE, GetScreenHeight() - 260);
             DrawTextHorizontal(arcadeFont, "Press ENTER to start", 30, 1, WHITE, GetScreenHeight() - 200);
             break;
         case PAUSE:
@@ -1598,9 +2056,7 @@ int main(void)
             DrawRectangle(0,0,GetScreenWidth(),GetScreenHeight(), pauseDark);
             DrawTexture(pausedTxt, ((GetScreenWidth() - pausedTxt.width) / 2), 150, WHITE); 
             resumeBtn.DrawButtonHorizontal();
-            mainMenuBtn.DrawButtonHorizontal();
-            mainMenuBtn.imgScale = 0.84f;
-            mainMenuBtn.position.y = 530.0f;
+            pauseMainMenuBtn.DrawButtonHorizontal();
             break;
         case EXIT:
             DrawTexture(exitBackground, 0, 0, WHITE);
@@ -1610,82 +2066,70 @@ int main(void)
         case SINGLEPLAYER_GAMEOVER:
             DrawTexture(gameoverBackground, 0, 0, WHITE);
 
-            DrawTextHorizontal(arcadeFont, TextFormat("Score: %i", score), 50.0f, 1.0f, BLACK, 300.0f);
-            DrawTextHorizontal(arcadeFont, TextFormat("High Score: %i", highscore), 50.0f, 1.0f, ORANGE, 400.0f);
+            DrawTextHorizontal(arcadeFont, TextFormat("Score: %i", view.score), 50.0f, 1.0f, BLACK, 300.0f);
+            DrawTextHorizontal(arcadeFont, TextFormat("High Score: %i", view.highscore), 50.0f, 1.0f, ORANGE, 400.0f);
           
             restartBtn.DrawButtonHorizontal();
-            restartBtn.position.y = 500.0f;
-            mainMenuBtn.DrawButtonHorizontal();
-            mainMenuBtn.imgScale = 0.80f;
-            mainMenuBtn.position.y = 600.0f;
-            exitBtn.DrawButtonHorizontal();
-            exitBtn.imgScale = 0.53f;
-            exitBtn.position.y = 700.0f;
+            gameoverMainMenuBtn.DrawButtonHorizontal();
+            gameoverExitBtn.DrawButtonHorizontal();
 
             break;
         case MULTIPLAYER_GAMEOVER:
             DrawTexture(gameoverBackground, 0, 0, WHITE);
 
             // Display the message after answers are evaluated
-            if (!gameMessage.empty()) {
+            if (!view.gameMessage.empty()) {
                 // Draw the black highlight first (outline effect) using a small offset
                 for (int x = -2; x <= 2; x++) {
                     for (int y = -2; y <= 2; y++) {
                         if (x != 0 || y != 0) { // Skip the center to avoid overlapping
-                            DrawTextEx(arcadeFont, gameMessage.c_str(), 
-                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage.c_str(), 75.0f, 1.0f).x) / 2.0f + (float)x, 
+                            DrawTextEx(arcadeFont, view.gameMessage.c_str(), 
+                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage.c_str(), 75.0f, 1.0f).x) / 2.0f + (float)x, 
                             (float) (GetScreenHeight() - 750) + (float)y}, 75.0f, 1.0f, BLACK);
                         }
                     }
                 }
 
                 // Then draw the actual message in yellow (on top of the green highlight)
-                DrawTextEx(arcadeFont, gameMessage.c_str(), 
-                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage.c_str(), 75.0f, 1.0f).x) / 2.0f, 
+                DrawTextEx(arcadeFont, view.gameMessage.c_str(), 
+                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage.c_str(), 75.0f, 1.0f).x) / 2.0f, 
                 (float) (GetScreenHeight() - 750)}, 75.0f, 1.0f, YELLOW);}
                 
-            if (!gameMessage1.empty()) {
+            if (!view.gameMessage1.empty()) {
                 for (int x = -2; x <= 2; x++) {
                     for (int y = -2; y <= 2; y++) {
                         if (x != 0 || y != 0) { 
-                            DrawTextEx(arcadeFont, gameMessage1.c_str(), 
-                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage1.c_str(), 30.0f, 1.0f).x) / 2.0f + (float)x,
+                            DrawTextEx(arcadeFont, view.gameMessage1.c_str(), 
+                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage1.c_str(), 30.0f, 1.0f).x) / 2.0f + (float)x,
                             (float) (GetScreenHeight() - 660) + (float)y}, 30.0f, 1.0f, BLACK);
                         }
                     }
                 }
 
-                DrawTextEx(arcadeFont, gameMessage1.c_str(), 
-                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage1.c_str(), 30.0f, 1.0f).x) / 2.0f, 
+                DrawTextEx(arcadeFont, view.gameMessage1.c_str(), 
+                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage1.c_str(), 30.0f, 1.0f).x) / 2.0f, 
                 (float) (GetScreenHeight() - 660)}, 30.0f, 1.0f, YELLOW);}
 
-            if (!gameMessage2.empty()) {
+            if (!view.gameMessage2.empty()) {
                 for (int x = -2; x <= 2; x++) {
                     for (int y = -2; y <= 2; y++) {
                         if (x != 0 || y != 0) {
-                            DrawTextEx(arcadeFont, gameMessage2.c_str(), 
-                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage2.c_str(), 30.0f, 1.0f).x) / 2.0f + (float)x, 
+                            DrawTextEx(arcadeFont, view.gameMessage2.c_str(), 
+                            {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage2.c_str(), 30.0f, 1.0f).x) / 2.0f + (float)x, 
                             (float) (GetScreenHeight() - 610) + (float)y}, 30.0f, 1.0f, BLACK);
                         }
                     }
                 }
 
-                DrawTextEx(arcadeFont, gameMessage2.c_str(), 
-                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, gameMessage2.c_str(), 30.0f, 1.0f).x) / 2.0f, 
+                DrawTextEx(arcadeFont, view.gameMessage2.c_str(), 
+                {(float) (GetScreenWidth() - MeasureTextEx(arcadeFont, view.gameMessage2.c_str(), 30.0f, 1.0f).x) / 2.0f, 
                 (float) (GetScreenHeight() - 610)}, 30.0f, 1.0f, YELLOW);
             }
             
             leaderboardsBtn.DrawButtonHorizontal();
-            leaderboardsBtn.position.y = 580.0f;
-            restartBtn.DrawButtonHorizontal();
-            restartBtn.imgScale = 0.75f;
-            restartBtn.position.y = 670.0f;
-            mainMenuBtn.DrawButtonHorizontal();
-            mainMenuBtn.imgScale = 0.80f;
-            mainMenuBtn.position.y = 760.0f;
-            exitBtn.DrawButtonHorizontal();
-            exitBtn.imgScale = 0.53f;
-            exitBtn.position.y = 850.0f;
+            multiplayerRestartBtn.DrawButtonHorizontal();
+            multiplayerMainMenuBtn.DrawButtonHorizontal();
+            multiplayerExitBtn.DrawButtonHorizontal();
             break;
         default:
             break;
@@ -1696,27 +2140,15 @@ int main(void)
         //----------------------------------------------------------------------------------
     }
 
+    logicRunning = false;
+    logicThread.join();
+
     //--------------------------------------------------------------------------------------
     // De-Initialization
     // TODO: Unload all loaded data (textures, fonts, audio) here!
     
     UnloadFont(arcadeFont);
 
-    UnloadMusicStream(mainMenuMusic);
-    UnloadMusicStream(singleplayerMusic);
-    UnloadMusicStream(singleplayerLowHealthMusic);
-    UnloadMusicStream(multiplayerMusic);
-
-    UnloadSound(menuButtonsSound);
-    UnloadSound(wrongAnswerSound);
-    UnloadSound(correctAnswerSound);
-    UnloadSound(gameoverSound);
-    UnloadSound(timesUpSound);
-    UnloadSound(countdownSound);
-    UnloadSound(playerWins);
-    UnloadSound(bothWrong);
-    UnloadSound(playercorrect);
-
 
     UnloadTexture(menuBackground);
     UnloadTexture(titleLogo);
@@ -1750,6 +2182,15 @@ int main(void)
     UnloadTexture(abilityD_Used_Texture);
     UnloadTexture(abilityF_Used_Texture);
 
+    matchClient.Disconnect();
+    quizHost.Stop();
+    if (onlineMode || quizHostMode) NetShutdown();
+    telemetry.Stop();
+    if (practiceMode) persistence.Write(practicePath, practiceDeck.Encode());
+    persistence.Stop();    // Finishes any pending save before exiting
+
+    audio.Stop();
+    sounds.Unload();    // After the audio thread, it refills the compressed voices
     CloseAudioDevice();
     CloseWindow();  // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
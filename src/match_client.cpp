@@ -0,0 +1,91 @@
+#include "match_client.hpp"
+
+MatchClient::MatchClient()
+    : playerIndex(-1), gameOver(false), roundId(0), questionIndex(-1), secondsLeft(0), answered(false),
+      questionReceivedNs(0), lastResult{0, -1, RoundResult{-1, 0, 0}, false} {}
+
+MatchClient::~MatchClient() {
+    Disconnect();
+}
+
+bool MatchClient::Connect(const char* host, uint16_t port, const std::string& name) {
+    Disconnect();
+
+    NetSocket socket = NetConnect(host, port);
+    if (socket == INVALID_NET_SOCKET) return false;
+
+    connection = NetConnection(socket);
+    connection.Send(MessageWriter(MSG_HELLO).U8(MATCH_PROTOCOL_VERSION).String(name).Data());
+    return connection.Flush();
+}
+
+void MatchClient::Disconnect() {
+    connection.Close();
+    players.clear();
+    playerIndex = -1;
+    gameOver = false;
+    roundId = 0;
+    questionIndex = -1;
+    secondsLeft = 0;
+    answered = false;
+    lastResult = MatchRoundResult{0, -1, RoundResult{-1, 0, 0}, false};
+}
+
+void MatchClient::SendAnswer(int answer, uint64_t pressTimeNs) {
+    if (answered || roundId == 0 || !IsConnected()) return;
+
+    uint64_t reactionNs = (pressTimeNs > questionReceivedNs) ? pressTimeNs - questionReceivedNs : 0;
+    connection.Send(MessageWriter(MSG_ANSWER).U32(roundId).U8((uint8_t) answer).U64(reactionNs).Data());
+    connection.Flush();
+    answered = true;
+}
+
+void MatchClient::Update(uint64_t nowNs) {
+    if (!connection.Receive()) {
+        // Losing the server mid-match ends it, the last known scores stay readable
+        if (IsInMatch()) gameOver = true;
+        return;
+    }
+
+    std::vector<uint8_t> message;
+    while (connection.PopMessage(message)) {
+        MessageReader reader(message);
+
+        switch (reader.Type()) {
+            case MSG_WELCOME:
+                playerIndex = reader.U8();
+                break;
+            case MSG_PLAYERS:
+                ReadPlayers(reader, players);
+                break;
+            case MSG_QUESTION:
+                roundId = reader.U32();
+                questionIndex = reader.I32();
+                secondsLeft = reader.U8();
+                answered = false;
+                questionReceivedNs = nowNs;
+                break;
+            case MSG_COUNTDOWN:
+                if (reader.U32() == roundId) secondsLeft = reader.U8();
+                break;
+            case MSG_RESULT:
+                lastResult.roundId = reader.U32();
+                lastResult.correctAnswerIndex = reader.U8();
+                lastResult.result.fastestCorrectPlayer = (int8_t) reader.U8();
+                lastResult.result.correctCount = reader.U8();
+                lastResult.result.wrongCount = reader.U8();
+                lastResult.timedOut = reader.U8() != 0;
+                if (lastResult.timedOut) secondsLeft = 0;
+                break;
+            case MSG_PING:
+                connection.Send(MessageWriter(MSG_PONG).U64(reader.U64()).Data());
+                break;
+            case MSG_GAME_OVER:
+                gameOver = true;
+                break;
+            default:
+                break;
+        }
+    }
+    connection.Flush();
+}
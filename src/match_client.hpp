@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "match_protocol.hpp"
+#include "net.hpp"
+#include "players.hpp"
+
+// Game-side view of an online match. Everything here mirrors what the server broadcast last; the only thing
+// the client decides is when its own player pressed an answer.
+class MatchClient {
+    public:
+        MatchClient();
+        ~MatchClient();
+
+        bool Connect(const char* host, uint16_t port, const std::string& name);
+        void Disconnect();
+        void Update(uint64_t nowNs);    // Non-blocking, call once per frame
+
+        // `pressTimeNs` is the monotonic timestamp of the key press, the reaction time is measured from when
+        // this client received the question
+        void SendAnswer(int answer, uint64_t pressTimeNs);
+
+        bool IsConnected() const { return connection.IsOpen(); }
+        bool IsInMatch() const { return playerIndex != -1; }
+        bool IsGameOver() const { return gameOver; }
+        int GetPlayerIndex() const { return playerIndex; }
+        const std::vector<Player>& GetPlayers() const { return players; }
+
+        uint32_t GetRoundId() const { return roundId; }
+        int GetQuestionIndex() const { return questionIndex; }
+        int GetSecondsLeft() const { return secondsLeft; }
+        bool HasAnswered() const { return answered; }
+
+        // Rounds are numbered from 1, so a result with roundId == GetRoundId() belongs to the current question
+        const MatchRoundResult& GetLastResult() const { return lastResult; }
+
+    private:
+        NetConnection connection;
+        std::vector<Player> players;
+        int playerIndex;
+        bool gameOver;
+
+        uint32_t roundId;
+        int questionIndex;
+        int secondsLeft;
+        bool answered;
+        uint64_t questionReceivedNs;
+        MatchRoundResult lastResult;
+};
@@ -0,0 +1,110 @@
+#include "match_protocol.hpp"
+#include <algorithm>
+
+MessageWriter::MessageWriter(MatchMessageType type) {
+    data.reserve(32);
+    data.push_back((uint8_t) type);
+}
+
+MessageWriter& MessageWriter::U8(uint8_t value) {
+    data.push_back(value);
+    return *this;
+}
+
+MessageWriter& MessageWriter::U32(uint32_t value) {
+    for (int i = 0; i < 4; i++) data.push_back((uint8_t) (value >> (i * 8)));
+    return *this;
+}
+
+MessageWriter& MessageWriter::I32(int32_t value) {
+    return U32((uint32_t) value);
+}
+
+MessageWriter& MessageWriter::U64(uint64_t value) {
+    for (int i = 0; i < 8; i++) data.push_back((uint8_t) (value >> (i * 8)));
+    return *this;
+}
+
+MessageWriter& MessageWriter::String(const std::string& value) {
+    size_t length = std::min(value.size(), (size_t) 255);
+    data.push_back((uint8_t) length);
+    data.insert(data.end(), value.begin(), value.begin() + length);
+    return *this;
+}
+
+MessageReader::MessageReader(const std::vector<uint8_t>& data) : data(data), position(1), valid(!data.empty()) {
+    type = valid ? (MatchMessageType) data[0] : (MatchMessageType) 0;
+}
+
+uint8_t MessageReader::U8() {
+    if (position + 1 > data.size()) {
+        valid = false;
+        return 0;
+    }
+    return data[position++];
+}
+
+uint32_t MessageReader::U32() {
+    if (position + 4 > data.size()) {
+        valid = false;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t) data[position++] << (i * 8);
+    return value;
+}
+
+int32_t MessageReader::I32() {
+    return (int32_t) U32();
+}
+
+uint64_t MessageReader::U64() {
+    if (position + 8 > data.size()) {
+        valid = false;
+        return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t) data[position++] << (i * 8);
+    return value;
+}
+
+std::string MessageReader::String() {
+    size_t length = U8();
+    if (position + length > data.size()) {
+        valid = false;
+        return "";
+    }
+    std::string value(data.begin() + position, data.begin() + position + length);
+    position += length;
+    return value;
+}
+
+void WritePlayers(MessageWriter& writer, const std::vector<Player>& players) {
+    writer.U8((uint8_t) players.size());
+    for (const Player& player : players) {
+        writer.String(player.name).I32(player.score).I32(player.healthPoints).U8((uint8_t) (player.answer + 1));
+    }
+}
+
+bool ReadPlayers(MessageReader& reader, std::vector<Player>& players) {
+    int count = reader.U8();
+    if (count > MAX_PLAYERS) return false;
+
+    players.resize(count);
+    for (Player& player : players) {
+        player.name = reader.String();
+        player.score = reader.I32();
+        player.healthPoints = reader.I32();
+        player.answer = (int) reader.U8() - 1;
+        player.selected = player.answer != -1;
+        player.answerTimeNs = 0;
+    }
+    return reader.IsValid();
+}
+
+uint64_t CompensateReactionTime(uint64_t serverElapsedNs, uint64_t roundTripNs, uint64_t reportedReactionNs, uint64_t jitterToleranceNs) {
+    uint64_t latest = serverElapsedNs;
+    uint64_t slack = roundTripNs + jitterToleranceNs;
+    uint64_t earliest = (serverElapsedNs > slack) ? serverElapsedNs - slack : 0;
+    return std::max(earliest, std::min(latest, reportedReactionNs));
+}
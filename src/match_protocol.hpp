@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "players.hpp"
+
+// Messages exchanged between the online match server and the game clients. Every message starts with its type byte,
+// integers are little-endian and strings carry an 8-bit length.
+#define MATCH_DEFAULT_PORT 47321
+#define MATCH_PROTOCOL_VERSION 1
+
+enum MatchMessageType {
+    MSG_HELLO = 1,        // Client -> server: protocol version, player name
+    MSG_WELCOME,          // Server -> client: assigned player index, player count
+    MSG_PLAYERS,          // Server -> client: name, score, health and locked answer of every player
+    MSG_QUESTION,         // Server -> client: round id, question index, countdown seconds
+    MSG_COUNTDOWN,        // Server -> client: round id, seconds left
+    MSG_ANSWER,           // Client -> server: round id, answer, reaction time measured by the client
+    MSG_RESULT,           // Server -> client: round id, correct answer, fastest correct player, correct/wrong counts, timed out
+    MSG_PING,             // Server -> client: server clock
+    MSG_PONG,             // Client -> server: the echoed server clock
+    MSG_GAME_OVER         // Server -> client: the match has ended
+};
+
+class MessageWriter {
+    public:
+        explicit MessageWriter(MatchMessageType type);
+
+        MessageWriter& U8(uint8_t value);
+        MessageWriter& U32(uint32_t value);
+        MessageWriter& I32(int32_t value);
+        MessageWriter& U64(uint64_t value);
+        MessageWriter& String(const std::string& value);
+
+        const std::vector<uint8_t>& Data() const { return data; }
+
+    private:
+        std::vector<uint8_t> data;
+};
+
+// Reads fields in order. Reading past the end yields zeroes and marks the message invalid instead of throwing.
+class MessageReader {
+    public:
+        explicit MessageReader(const std::vector<uint8_t>& data);
+
+        MatchMessageType Type() const { return type; }
+        bool IsValid() const { return valid; }
+
+        uint8_t U8();
+        uint32_t U32();
+        int32_t I32();
+        uint64_t U64();
+        std::string String();
+
+    private:
+        const std::vector<uint8_t>& data;
+        size_t position;
+        MatchMessageType type;
+        bool valid;
+};
+
+void WritePlayers(MessageWriter& writer, const std::vector<Player>& players);
+bool ReadPlayers(MessageReader& reader, std::vector<Player>& players);
+
+struct MatchRoundResult {
+    uint32_t roundId;
+    int correctAnswerIndex;
+    RoundResult result;
+    bool timedOut;
+};
+
+// Server-side fairness rule for the "faster" tie-break. The client reports how long the player took after the
+// question appeared; the server only trusts that figure inside the window its own clock allows: no later than
+// the moment the answer arrived, and no earlier than that minus one measured round trip and the jitter tolerance.
+uint64_t CompensateReactionTime(uint64_t serverElapsedNs, uint64_t roundTripNs, uint64_t reportedReactionNs, uint64_t jitterToleranceNs);
@@ -0,0 +1,299 @@
+#include "match_server.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#define PING_INTERVAL_NS 500000000ULL
+#define QUESTION_HISTORY_SIZE 10
+
+static uint64_t SecondsToNs(float seconds) {
+    return (uint64_t) (seconds * 1e9);
+}
+
+MatchServerConfig GetDefaultMatchServerConfig(void) {
+    MatchServerConfig config;
+    config.port = MATCH_DEFAULT_PORT;
+    config.playerCount = MIN_PLAYERS;
+    config.countdownSeconds = 20;
+    config.readySeconds = 3.0f;
+    config.revealDelaySeconds = 0.5f;
+    config.resultDelaySeconds = 2.5f;
+    config.timeoutDelaySeconds = 2.0f;
+    config.jitterToleranceMs = 30;
+    config.jitterMs = 0;
+    config.seed = std::random_device{}();
+    return config;
+}
+
+MatchServer::MatchServer(const MatchServerConfig& config)
+    : config(config), listener(INVALID_NET_SOCKET), questions(GetQuestionsVector()), random(config.seed),
+      phase(PHASE_LOBBY), phaseStartNs(0), questionSentNs(0), lastTickNs(0), roundId(0), questionIndex(0),
+      secondsLeft(0), roundsPlayed(0) {
+    this->config.playerCount = std::max(MIN_PLAYERS, std::min(MAX_PLAYERS, config.playerCount));
+}
+
+MatchServer::~MatchServer() {
+    Stop();
+}
+
+bool MatchServer::Start() {
+    listener = NetListen(config.port, config.playerCount);
+    if (listener == INVALID_NET_SOCKET) {
+        fprintf(stderr, "MATCH: Failed to listen on port %u\n", config.port);
+        return false;
+    }
+    printf("MATCH: Waiting for %i players on port %u (seed %u)\n", config.playerCount, config.port, config.seed);
+    return true;
+}
+
+void MatchServer::Stop() {
+    for (Client& client : clients) {
+        client.connection.Flush();
+        client.connection.Close();
+    }
+    clients.clear();
+    NetClose(listener);
+    listener = INVALID_NET_SOCKET;
+}
+
+uint64_t MatchServer::GetRoundTripNs(int playerIndex) const {
+    for (const Client& client : clients) {
+        if (client.playerIndex == playerIndex) return client.roundTripNs;
+    }
+    return 0;
+}
+
+uint64_t MatchServer::SimulatedDelayNs(const Client& client) {
+    uint64_t jitterNs = 0;
+    if (config.jitterMs > 0) jitterNs = (uint64_t) random.NextBelow(config.jitterMs * 1000 + 1) * 1000ULL;
+    return client.oneWayDelayNs + jitterNs;
+}
+
+// Same rule as the local game: never repeat one of the last QUESTION_HISTORY_SIZE questions
+int MatchServer::PickQuestion(void) {
+    int candidate = random.RangeExcluding(0, (int) questions.size() - 1, history);
+    if (history.size() >= QUESTION_HISTORY_SIZE) history.erase(history.begin());
+    history.push_back(candidate);
+    return candidate;
+}
+
+void MatchServer::SendTo(Client& client, const MessageWriter& message, uint64_t nowNs) {
+    uint64_t releaseNs = std::max(client.lastOutboundReleaseNs, nowNs + SimulatedDelayNs(client));
+    client.lastOutboundReleaseNs = releaseNs;
+    client.outbound.push_back(DelayedMessage{releaseNs, message.Data()});
+}
+
+void MatchServer::Broadcast(const MessageWriter& message, uint64_t nowNs) {
+    for (Client& client : clients) {
+        if (client.playerIndex != -1) SendTo(client, message, nowNs);
+    }
+}
+
+void MatchServer::BroadcastPlayers(uint64_t nowNs) {
+    MessageWriter message(MSG_PLAYERS);
+    WritePlayers(message, players);
+    Broadcast(message, nowNs);
+}
+
+void MatchServer::AcceptClients(uint64_t nowNs) {
+    while (true) {
+        NetSocket socket = NetAccept(listener);
+        if (socket == INVALID_NET_SOCKET) return;
+
+        if (phase != PHASE_LOBBY || (int) clients.size() >= config.playerCount) {
+            NetClose(socket);    // Match is full or already running
+            continue;
+        }
+
+        uint64_t delayNs = 0;
+        if (!config.latencyMs.empty()) {
+            size_t slot = std::min(clients.size(), config.latencyMs.size() - 1);
+            delayNs = config.latencyMs[slot] * 1000000ULL;
+        }
+        clients.push_back(Client{NetConnection(socket), -1, delayNs, {}, {}, nowNs, nowNs, 0, false, 0});
+    }
+}
+
+void MatchServer::PumpClient(Client& client, uint64_t nowNs) {
+    // Everything read from the socket is held back by the simulated delay before the server sees it
+    client.connection.Receive();
+    std::vector<uint8_t> message;
+    while (client.connection.PopMessage(message)) {
+        uint64_t releaseNs = std::max(client.lastInboundReleaseNs, nowNs + SimulatedDelayNs(client));
+        client.lastInboundReleaseNs = releaseNs;
+        client.inbound.push_back(DelayedMessage{releaseNs, message});
+    }
+    while (!client.inbound.empty() && client.inbound.front().releaseNs <= nowNs) {
+        DelayedMessage delayed = std::move(client.inbound.front());
+        client.inbound.pop_front();
+        HandleMessage(client, delayed.data, nowNs);
+    }
+
+    if (client.playerIndex != -1 && nowNs - client.lastPingNs >= PING_INTERVAL_NS) {
+        SendTo(client, MessageWriter(MSG_PING).U64(nowNs), nowNs);
+        client.lastPingNs = nowNs;
+    }
+
+    while (!client.outbound.empty() && client.outbound.front().releaseNs <= nowNs) {
+        client.connection.Send(client.outbound.front().data);
+        client.outbound.pop_front();
+    }
+    client.connection.Flush();
+}
+
+void MatchServer::HandleMessage(Client& client, const std::vector<uint8_t>& message, uint64_t nowNs) {
+    MessageReader reader(message);
+
+    switch (reader.Type()) {
+        case MSG_HELLO: {
+            uint8_t version = reader.U8();
+            std::string name = reader.String();
+            if (!reader.IsValid() || version != MATCH_PROTOCOL_VERSION || client.playerIndex != -1 || phase != PHASE_LOBBY) {
+                client.connection.Close();
+                return;
+            }
+
+            client.playerIndex = (int) players.size();
+            if (name.empty()) name = "Player " + std::to_string(client.playerIndex + 1);
+            players.push_back(Player{name, 0, PLAYER_START_HEALTH, -1, false, 0});
+            printf("MATCH: %s joined as player %i\n", name.c_str(), client.playerIndex + 1);
+
+            if ((int) players.size() == config.playerCount) {
+                for (Client& joined : clients) {
+                    SendTo(joined, MessageWriter(MSG_WELCOME).U8((uint8_t) joined.playerIndex).U8((uint8_t) players.size()), nowNs);
+                }
+                BroadcastPlayers(nowNs);
+                phase = PHASE_READY;
+                phaseStartNs = nowNs;
+            }
+            break;
+        }
+        case MSG_PONG: {
+            uint64_t echoNs = reader.U64();
+            if (!reader.IsValid() || echoNs > nowNs) return;
+
+            // Smoothed like TCP's SRTT so a single jittery sample doesn't swing the compensation
+            uint64_t sampleNs = nowNs - echoNs;
+            if (!client.hasRoundTrip) client.roundTripNs = sampleNs;
+            else client.roundTripNs = client.roundTripNs - client.roundTripNs / 8 + sampleNs / 8;
+            client.hasRoundTrip = true;
+            break;
+        }
+        case MSG_ANSWER: {
+            uint32_t answerRound = reader.U32();
+            int answer = reader.U8();
+            uint64_t reactionNs = reader.U64();
+            if (!reader.IsValid() || phase != PHASE_QUESTION || answerRound != roundId || answer > 3) return;
+
+            Player& player = players[client.playerIndex];
+            if (player.selected) return;
+
+            player.answer = answer;
+            player.selected = true;
+            player.answerTimeNs = CompensateReactionTime(nowNs - questionSentNs, client.roundTripNs, reactionNs,
+                                                         config.jitterToleranceMs * 1000000ULL);
+            BroadcastPlayers(nowNs);
+
+            if (HaveAllPlayersAnswered(players)) {
+                phase = PHASE_REVEAL;
+                phaseStartNs = nowNs;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void MatchServer::StartRound(uint64_t nowNs) {
+    roundId++;
+    questionIndex = PickQuestion();
+    secondsLeft = config.countdownSeconds;
+    ResetPlayerAnswers(players);
+
+    BroadcastPlayers(nowNs);
+    Broadcast(MessageWriter(MSG_QUESTION).U32(roundId).I32(questionIndex).U8((uint8_t) secondsLeft), nowNs);
+
+    phase = PHASE_QUESTION;
+    phaseStartNs = nowNs;
+    questionSentNs = nowNs;
+    lastTickNs = nowNs;
+}
+
+void MatchServer::EndMatch(uint64_t nowNs) {
+    Broadcast(MessageWriter(MSG_GAME_OVER), nowNs);
+    phase = PHASE_GAME_OVER;
+    phaseStartNs = nowNs;
+}
+
+void MatchServer::Update(uint64_t nowNs) {
+    if (listener == INVALID_NET_SOCKET) return;
+
+    AcceptClients(nowNs);
+    for (Client& client : clients) PumpClient(client, nowNs);
+
+    // A player leaving ends the match for everyone, a stranger leaving the lobby just frees the slot
+    for (size_t i = 0; i < clients.size(); i++) {
+        if (clients[i].connection.IsOpen()) continue;
+        if (clients[i].playerIndex != -1 && phase != PHASE_GAME_OVER) {
+            printf("MATCH: Player %i disconnected\n", clients[i].playerIndex + 1);
+            clients.erase(clients.begin() + i);
+            EndMatch(nowNs);
+            return;
+        }
+        clients.erase(clients.begin() + i--);
+    }
+
+    uint64_t phaseElapsedNs = nowNs - phaseStartNs;
+    int correctAnswerIndex = questions[questionIndex].correctAnswerIndex;
+
+    switch (phase) {
+        case PHASE_READY:
+            if (phaseElapsedNs >= SecondsToNs(config.readySeconds)) StartRound(nowNs);
+            break;
+        case PHASE_QUESTION:
+            if (nowNs - lastTickNs >= 1000000000ULL) {
+                lastTickNs += 1000000000ULL;
+                secondsLeft--;
+                Broadcast(MessageWriter(MSG_COUNTDOWN).U32(roundId).U8((uint8_t) secondsLeft), nowNs);
+            }
+            if (secondsLeft <= 0) {
+                MatchRoundResult timeout{roundId, correctAnswerIndex, RoundResult{-1, 0, 0}, true};
+                results.push_back(timeout);
+                Broadcast(MessageWriter(MSG_RESULT).U32(roundId).U8((uint8_t) correctAnswerIndex).U8(0xFF).U8(0).U8(0).U8(1), nowNs);
+                phase = PHASE_TIMEOUT;
+                phaseStartNs = nowNs;
+            }
+            break;
+        case PHASE_REVEAL:
+            if (phaseElapsedNs >= SecondsToNs(config.revealDelaySeconds)) {
+                RoundResult result = EvaluateRound(players, correctAnswerIndex);
+                results.push_back(MatchRoundResult{roundId, correctAnswerIndex, result, false});
+                roundsPlayed++;
+
+                Broadcast(MessageWriter(MSG_RESULT).U32(roundId).U8((uint8_t) correctAnswerIndex).U8((uint8_t) result.fastestCorrectPlayer)
+                                                   .U8((uint8_t) result.correctCount).U8((uint8_t) result.wrongCount).U8(0), nowNs);
+                BroadcastPlayers(nowNs);
+                phase = PHASE_RESULT;
+                phaseStartNs = nowNs;
+            }
+            break;
+        case PHASE_TIMEOUT:
+            if (phaseElapsedNs >= SecondsToNs(config.timeoutDelaySeconds)) {
+                for (Player& player : players) player.healthPoints--;
+                roundsPlayed++;
+                BroadcastPlayers(nowNs);
+                if (IsAnyPlayerOutOfHealth(players)) EndMatch(nowNs);
+                else StartRound(nowNs);
+            }
+            break;
+        case PHASE_RESULT:
+            if (phaseElapsedNs >= SecondsToNs(config.resultDelaySeconds)) {
+                if (IsAnyPlayerOutOfHealth(players)) EndMatch(nowNs);
+                else StartRound(nowNs);
+            }
+            break;
+        default:
+            break;
+    }
+}
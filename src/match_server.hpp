@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "match_protocol.hpp"
+#include "net.hpp"
+#include "players.hpp"
+#include "questions.hpp"
+#include "session_random.hpp"
+
+struct MatchServerConfig {
+    uint16_t port;
+    int playerCount;
+    int countdownSeconds;
+    float readySeconds;               // Lobby -> first question, also gives the ping loop time to measure every RTT
+    float revealDelaySeconds;         // Every player answered -> evaluation
+    float resultDelaySeconds;         // Result shown -> next question
+    float timeoutDelaySeconds;        // "Times Up!" shown -> health loss and next question
+    uint32_t jitterToleranceMs;       // Extra slack allowed on top of the measured RTT, see CompensateReactionTime
+    std::vector<uint32_t> latencyMs;  // Simulated one-way delay per player slot, the last entry repeats. Empty for none.
+    uint32_t jitterMs;                // Simulated extra delay, uniform in [0, jitterMs] per message
+    unsigned int seed;
+};
+
+MatchServerConfig GetDefaultMatchServerConfig(void);
+
+// Authoritative head-to-head server: owns the question order, the countdown and the answer evaluation.
+// Clients only display what it broadcasts and report answers. Update() never blocks, so the server can run
+// in its own process or on a thread next to loopback clients.
+class MatchServer {
+    public:
+        explicit MatchServer(const MatchServerConfig& config);
+        ~MatchServer();
+
+        bool Start();
+        void Stop();
+        void Update(uint64_t nowNs);
+
+        bool IsFinished() const { return phase == PHASE_GAME_OVER; }
+        int GetRoundsPlayed() const { return roundsPlayed; }
+        const std::vector<Player>& GetPlayers() const { return players; }
+        const std::vector<MatchRoundResult>& GetResults() const { return results; }
+        uint64_t GetRoundTripNs(int playerIndex) const;
+
+    private:
+        enum Phase { PHASE_LOBBY, PHASE_READY, PHASE_QUESTION, PHASE_REVEAL, PHASE_RESULT, PHASE_TIMEOUT, PHASE_GAME_OVER };
+
+        struct DelayedMessage {
+            uint64_t releaseNs;
+            std::vector<uint8_t> data;
+        };
+
+        struct Client {
+            NetConnection connection;
+            int playerIndex;                   // -1 until the client said hello
+            uint64_t oneWayDelayNs;
+            std::deque<DelayedMessage> inbound;
+            std::deque<DelayedMessage> outbound;
+            uint64_t lastInboundReleaseNs;     // Releases never go backwards, like a real TCP stream
+            uint64_t lastOutboundReleaseNs;
+            uint64_t roundTripNs;
+            bool hasRoundTrip;
+            uint64_t lastPingNs;
+        };
+
+        void AcceptClients(uint64_t nowNs);
+        void PumpClient(Client& client, uint64_t nowNs);
+        void HandleMessage(Client& client, const std::vector<uint8_t>& message, uint64_t nowNs);
+        void SendTo(Client& client, const MessageWriter& message, uint64_t nowNs);
+        void Broadcast(const MessageWriter& message, uint64_t nowNs);
+        void BroadcastPlayers(uint64_t nowNs);
+        void StartRound(uint64_t nowNs);
+        void EndMatch(uint64_t nowNs);
+        uint64_t SimulatedDelayNs(const Client& client);
+        int PickQuestion(void);
+
+        MatchServerConfig config;
+        NetSocket listener;
+        std::vector<Client> clients;
+        std::vector<Player> players;
+        std::vector<Question> questions;
+        std::vector<int> history;
+        SessionRandom random;
+
+        Phase phase;
+        uint64_t phaseStartNs;
+        uint64_t questionSentNs;
+        uint64_t lastTickNs;
+        uint32_t roundId;
+        int questionIndex;
+        int secondsLeft;
+        int roundsPlayed;
+        std::vector<MatchRoundResult> results;
+};
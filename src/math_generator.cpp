@@ -0,0 +1,242 @@
+#include "math_generator.hpp"
+#include <cstdlib>
+#include "session_random.hpp"
+
+#define MATH_TEXT_SIZE 128
+#define MATH_MAX_CANDIDATES 8
+
+enum MathKind { MATH_ADD_SUBTRACT = 0, MATH_MULTIPLY_DIVIDE, MATH_ORDER_OF_OPERATIONS, MATH_LINEAR_EQUATION, MATH_PERCENTAGE, MATH_KIND_COUNT };
+
+// Fixed-size text buffer, formats without snprintf or the heap
+struct MathText {
+    char buffer[MATH_TEXT_SIZE];
+    int length;
+
+    MathText() : length(0) {}
+
+    MathText& Text(const char* text) {
+        while (*text && length < MATH_TEXT_SIZE - 1) buffer[length++] = *text++;
+        return *this;
+    }
+
+    MathText& Int(long value) {
+        char digits[24];
+        int count = 0;
+        unsigned long magnitude = value < 0 ? 0ul - (unsigned long) value : (unsigned long) value;
+        do {
+            digits[count++] = (char) ('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0 && length < MATH_TEXT_SIZE - 1) buffer[length++] = '-';
+        while (count > 0 && length < MATH_TEXT_SIZE - 1) buffer[length++] = digits[--count];
+        return *this;
+    }
+};
+
+struct MathProblem {
+    MathText text;
+    long answer;
+    long candidates[MATH_MAX_CANDIDATES];    // Wrong answers, most plausible first
+    int candidateCount;
+    bool allowNegative;
+
+    MathProblem() : answer(0), candidateCount(0), allowNegative(false) {}
+
+    void Candidate(long value) {
+        if (candidateCount < MATH_MAX_CANDIDATES) candidates[candidateCount++] = value;
+    }
+};
+
+uint32_t MakeMathSeed(uint32_t random, int level) {
+    if (level < 0) level = 0;
+    if (level >= MATH_LEVELS) level = MATH_LEVELS - 1;
+    return (random & 0x3FFFFFFFu) | ((uint32_t) level << 30);
+}
+
+int GetMathLevel(uint32_t seed) {
+    int level = (int) (seed >> 30);
+    return level < MATH_LEVELS ? level : MATH_LEVELS - 1;
+}
+
+static void AddSubtract(SessionRandom& random, int level, MathProblem& problem) {
+    static const int limits[MATH_LEVELS][2] = {{1, 20}, {10, 99}, {100, 999}};
+    long a = random.Range(limits[level][0], limits[level][1]);
+    long b = random.Range(limits[level][0], limits[level][1]);
+    if (random.NextBelow(2) == 0) {
+        problem.text.Text("What is ").Int(a).Text(" + ").Int(b).Text("?");
+        problem.answer = a + b;
+        problem.Candidate(a + b + 10);    // Carry mistakes
+        problem.Candidate(a + b - 10);
+        problem.Candidate(std::labs(a - b));
+    }
+    else {
+        if (a < b) std::swap(a, b);
+        problem.text.Text("What is ").Int(a).Text(" - ").Int(b).Text("?");
+        problem.answer = a - b;
+        problem.Candidate(a - b + 10);    // Borrow mistakes
+        problem.Candidate(a - b - 10);
+        problem.Candidate(a + b);
+    }
+    problem.Candidate(problem.answer + 1);
+    problem.Candidate(problem.answer - 1);
+}
+
+static void MultiplyDivide(SessionRandom& random, int level, MathProblem& problem) {
+    static const int limits[MATH_LEVELS][4] = {{2, 10, 2, 10}, {2, 12, 11, 25}, {11, 30, 11, 30}};
+    long a = random.Range(limits[level][0], limits[level][1]);
+    long b = random.Range(limits[level][2], limits[level][3]);
+    if (random.NextBelow(2) == 0) {
+        problem.text.Text("What is ").Int(a).Text(" x ").Int(b).Text("?");
+        problem.answer = a * b;
+        problem.Candidate(a * (b + 1));    // One row too many or too few
+        problem.Candidate(a * (b - 1));
+        problem.Candidate(a + b);
+        problem.Candidate(a * b + 10);
+    }
+    else {
+        problem.text.Text("What is ").Int(a * b).Text(" / ").Int(a).Text("?");
+        problem.answer = b;
+        problem.Candidate(b + 1);
+        problem.Candidate(b - 1);
+        problem.Candidate(a * b - a);
+        problem.Candidate(b + 10);
+    }
+}
+
+static void OrderOfOperations(SessionRandom& random, int level, MathProblem& problem) {
+    static const int limits[MATH_LEVELS] = {9, 15, 25};
+    long a = random.Range(2, limits[level]);
+    long b = random.Range(2, limits[level]);
+    long c = random.Range(2, limits[level]);
+    if (level < 2) {
+        problem.text.Text("What is ").Int(a).Text(" + ").Int(b).Text(" x ").Int(c).Text("?");
+        problem.answer = a + b * c;
+        problem.Candidate((a + b) * c);    // Left to right
+        problem.Candidate(a * b + c);
+        problem.Candidate(a + b + c);
+    }
+    else {
+        long d = random.Range(2, 9);
+        problem.text.Text("What is ").Int(a).Text(" x ").Int(b).Text(" - ").Int(c).Text(" x ").Int(d).Text("?");
+        problem.answer = a * b - c * d;
+        problem.allowNegative = true;
+        problem.Candidate((a * b - c) * d);    // Left to right
+        problem.Candidate(a * (b - c) * d);
+        problem.Candidate(a * b + c * d);
+    }
+    problem.Candidate(problem.answer + 1);
+    problem.Candidate(problem.answer - 1);
+}
+
+static void LinearEquation(SessionRandom& random, int level, MathProblem& problem) {
+    static const int limits[MATH_LEVELS][3] = {{1, 20, 20}, {9, 12, 30}, {12, 12, 50}};    // Coefficient, |x|, |b|
+    long a = level == 0 ? 1 : random.Range(2, limits[level][0]);
+    long x = level < 2 ? random.Range(1, limits[level][1]) : random.Range(-limits[level][1], limits[level][1]);
+    long b = random.Range(level < 2 ? 1 : -limits[level][2], limits[level][2]);
+    if (b == 0) b = 1;
+    long c = a * x + b;
+
+    problem.text.Text("Solve for x: ");
+    if (a != 1) problem.text.Int(a);
+    problem.text.Text("x ").Text(b < 0 ? "- " : "+ ").Int(std::labs(b)).Text(" = ").Int(c);
+    problem.answer = x;
+    problem.allowNegative = true;
+    if (a != 1) {
+        problem.Candidate(c - b);    // Forgot to divide
+        if ((c + b) % a == 0) problem.Candidate((c + b) / a);    // Moved b with the wrong sign
+    }
+    else problem.Candidate(c + b);
+    problem.Candidate(-x);
+    problem.Candidate(x + 1);
+    problem.Candidate(x - 1);
+    problem.Candidate(x + 2);
+}
+
+static void Percentage(SessionRandom& random, int level, MathProblem& problem) {
+    static const int easy[] = {10, 20, 25, 50};
+    static const int harder[] = {5, 15, 30, 40, 60, 75};
+    long percent = level == 0 ? easy[random.NextBelow(4)] : harder[random.NextBelow(6)];
+
+    // The smallest whole that gives a whole-number result, times a small multiplier
+    long step = 100;
+    while (step % 2 == 0 && (percent * (step / 2)) % 100 == 0) step /= 2;
+    while (step % 5 == 0 && (percent * (step / 5)) % 100 == 0) step /= 5;
+    long whole = step * random.Range(1, level == 0 ? 10 : 20);
+    if (whole < 20) whole *= 10;
+    long part = whole * percent / 100;
+
+    if (level < 2) {
+        problem.text.Text("What is ").Int(percent).Text("% of ").Int(whole).Text("?");
+        problem.answer = part;
+        problem.Candidate(whole - part);    // The rest instead of the share
+        problem.Candidate(whole * percent / 10);
+        problem.Candidate(part + percent);
+        problem.Candidate(part * 2);
+    }
+    else {
+        bool rise = random.NextBelow(2) == 0;
+        problem.text.Text("A price of ").Int(whole).Text(rise ? " rises by " : " falls by ").Int(percent).Text("%. What is the new price?");
+        problem.answer = rise ? whole + part : whole - part;
+        problem.Candidate(rise ? whole + percent : whole - percent);    // Percent points taken as units
+        problem.Candidate(part);
+        problem.Candidate(rise ? whole - part : whole + part);
+        problem.Candidate(problem.answer + 10);
+    }
+}
+
+static void WriteNumber(std::string& text, long value) {
+    MathText number;
+    number.Int(value);
+    text.assign(number.buffer, number.length);
+}
+
+void GenerateMathQuestion(uint32_t seed, Question& question) {
+    SessionRandom random(seed);
+    int level = GetMathLevel(seed);
+    MathProblem problem;
+    switch ((MathKind) random.NextBelow(MATH_KIND_COUNT)) {
+        case MATH_ADD_SUBTRACT: AddSubtract(random, level, problem); break;
+        case MATH_MULTIPLY_DIVIDE: MultiplyDivide(random, level, problem); break;
+        case MATH_ORDER_OF_OPERATIONS: OrderOfOperations(random, level, problem); break;
+        case MATH_LINEAR_EQUATION: LinearEquation(random, level, problem); break;
+        default: Percentage(random, level, problem); break;
+    }
+
+    // The three most plausible distinct wrong answers, then near misses if the mistakes collided
+    long values[4] = {problem.answer, 0, 0, 0};
+    int count = 1;
+    for (int i = 0; i < problem.candidateCount && count < 4; i++) {
+        long value = problem.candidates[i];
+        bool usable = problem.allowNegative || value >= 0;
+        for (int j = 0; j < count && usable; j++) usable = values[j] != value;
+        if (usable) values[count++] = value;
+    }
+    for (long offset = 2; count < 4; offset++) {
+        long value = problem.answer + ((offset & 1) ? -offset / 2 : offset / 2 + 1);
+        bool usable = problem.allowNegative || value >= 0;
+        for (int j = 0; j < count && usable; j++) usable = values[j] != value;
+        if (usable) values[count++] = value;
+    }
+
+    // Fisher-Yates over the four options
+    for (int i = 3; i > 0; i--) {
+        int j = (int) random.NextBelow((uint32_t) i + 1);
+        long swap = values[i];
+        values[i] = values[j];
+        values[j] = swap;
+    }
+
+    question.questionText.assign(problem.text.buffer, problem.text.length);
+    if (question.answers.size() != 4) question.answers.resize(4);
+    for (int i = 0; i < 4; i++) {
+        WriteNumber(question.answers[i], values[i]);
+        if (values[i] == problem.answer) question.correctAnswerIndex = i;
+    }
+}
+
+const Question* ResolveQuestion(const std::vector<Question>& bank, int64_t id, Question& scratch) {
+    if (id >= 0 && id < (int64_t) bank.size()) return &bank[id];
+    if (!IsGeneratedQuestion(id)) return nullptr;
+    GenerateMathQuestion((uint32_t) (id - GENERATED_QUESTION_BASE), scratch);
+    return &scratch;
+}
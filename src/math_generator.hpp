@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "questions.hpp"
+
+// Procedural math questions: arithmetic, order of operations, linear equations and percentages, with distractors
+// built from the usual mistakes (off by one or ten, the wrong operation, left-to-right evaluation, a forgotten step).
+//
+// A question is a pure function of a 32-bit seed, so replays and the history only log the seed. The top two bits
+// of the seed are the level (0 easy to 2 hard). Generating into the same Question again reuses its strings, and
+// answers fit the small-string buffer, so a warm Question costs no heap allocation.
+#define MATH_LEVELS 3
+#define MATH_GENERATED_SHARE 0.5    // Share of the math questions a game replaces with generated ones
+
+// Question ids as logged in replays: bank positions below GENERATED_QUESTION_BASE, generated questions above it
+#define GENERATED_QUESTION_BASE (1LL << 32)
+
+// Seed of a question at `level` (0 to MATH_LEVELS - 1), the other bits taken from `random`
+uint32_t MakeMathSeed(uint32_t random, int level);
+int GetMathLevel(uint32_t seed);
+
+void GenerateMathQuestion(uint32_t seed, Question& question);
+
+inline bool IsGeneratedQuestion(int64_t id) { return id >= GENERATED_QUESTION_BASE && id < 2 * GENERATED_QUESTION_BASE; }
+inline int64_t GetGeneratedQuestionId(uint32_t seed) { return GENERATED_QUESTION_BASE + seed; }
+
+// The question behind a logged id: a bank entry, or a generated one written into `scratch`. nullptr when the id
+// is neither.
+const Question* ResolveQuestion(const std::vector<Question>& bank, int64_t id, Question& scratch);
@@ -0,0 +1,74 @@
+#include "mixer.hpp"
+#include <algorithm>
+#include <atomic>
+
+#define MIXER_CHANNELS 2    // Processors see the mixing format, interleaved float stereo
+
+// Settings from the game thread, the duck envelope from the audio thread, and the product of both that the
+// processors read on the device thread. Whichever thread changes an input recomputes the product.
+static std::atomic<float> masterGain(1.0f);
+static std::atomic<float> busGains[BUS_COUNT] = {{1.0f}, {1.0f}, {1.0f}};
+static std::atomic<bool> busMuted[BUS_COUNT] = {{false}, {false}, {false}};
+static std::atomic<float> duckLevel(1.0f);
+static std::atomic<float> effectiveGains[BUS_COUNT] = {{1.0f}, {1.0f}, {1.0f}};
+
+static void Publish(int bus) {
+    float gain = busMuted[bus].load(std::memory_order_relaxed) ? 0.0f : busGains[bus].load(std::memory_order_relaxed);
+    gain *= masterGain.load(std::memory_order_relaxed);
+    if (bus == BUS_MUSIC) gain *= duckLevel.load(std::memory_order_relaxed);
+    effectiveGains[bus].store(gain, std::memory_order_relaxed);
+}
+
+// raylib processors take no user pointer, so there is one per bus
+template <int bus>
+static void ProcessBus(void* buffer, unsigned int frames) {
+    float gain = effectiveGains[bus].load(std::memory_order_relaxed);
+    if (gain == 1.0f) return;
+    float* samples = (float*) buffer;
+    for (unsigned int i = 0; i < frames * MIXER_CHANNELS; i++) samples[i] *= gain;
+}
+
+static const AudioCallback processors[BUS_COUNT] = {ProcessBus<BUS_MUSIC>, ProcessBus<BUS_UI>, ProcessBus<BUS_GAMEPLAY>};
+
+void SetMasterGain(float gain) {
+    masterGain.store(std::max(0.0f, gain), std::memory_order_relaxed);
+    for (int i = 0; i < BUS_COUNT; i++) Publish(i);
+}
+
+void SetBusGain(MixerBus bus, float gain) {
+    busGains[bus].store(std::max(0.0f, gain), std::memory_order_relaxed);
+    Publish(bus);
+}
+
+void SetBusMuted(MixerBus bus, bool muted) {
+    busMuted[bus].store(muted, std::memory_order_relaxed);
+    Publish(bus);
+}
+
+float GetBusGain(MixerBus bus) {
+    return busGains[bus].load(std::memory_order_relaxed);
+}
+
+bool IsBusMuted(MixerBus bus) {
+    return busMuted[bus].load(std::memory_order_relaxed);
+}
+
+void AttachToBus(AudioStream stream, MixerBus bus) {
+    AttachAudioStreamProcessor(stream, processors[bus]);
+}
+
+void DetachFromBus(AudioStream stream, MixerBus bus) {
+    DetachAudioStreamProcessor(stream, processors[bus]);
+}
+
+void UpdateMixer(float seconds, bool ducking) {
+    float level = duckLevel.load(std::memory_order_relaxed);
+    float target = ducking ? MIXER_DUCK_GAIN : 1.0f;
+    if (level == target) return;
+
+    float span = 1.0f - MIXER_DUCK_GAIN;
+    if (level > target) level = std::max(target, level - span * seconds * 1000.0f / MIXER_DUCK_ATTACK_MS);
+    else level = std::min(target, level + span * seconds * 1000.0f / MIXER_DUCK_RELEASE_MS);
+    duckLevel.store(level, std::memory_order_relaxed);
+    Publish(BUS_MUSIC);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <raylib.h>
+
+// Every stream and sound plays through one of three buses under a master gain. A bus applies its gain in the mix
+// callback (an audio stream processor), so changing a setting is one store however many sounds sit on the bus, and
+// new sounds only need to be attached to a bus.
+//
+// The music bus ducks while a ducking sound plays (see SoundBank::SetDucking): it dips over MIXER_DUCK_ATTACK_MS
+// and comes back over MIXER_DUCK_RELEASE_MS. The envelope is stepped by the audio thread.
+#define MIXER_DUCK_GAIN 0.35f
+#define MIXER_DUCK_ATTACK_MS 80
+#define MIXER_DUCK_RELEASE_MS 400
+
+enum MixerBus {
+    BUS_MUSIC = 0,
+    BUS_UI,          // Menu clicks
+    BUS_GAMEPLAY,    // Answers, stingers, timers
+    BUS_COUNT
+};
+
+void SetMasterGain(float gain);
+void SetBusGain(MixerBus bus, float gain);
+void SetBusMuted(MixerBus bus, bool muted);
+float GetBusGain(MixerBus bus);
+bool IsBusMuted(MixerBus bus);
+
+// Routes a stream (Sound.stream, Music.stream) through a bus. Detach before unloading the stream.
+void AttachToBus(AudioStream stream, MixerBus bus);
+void DetachFromBus(AudioStream stream, MixerBus bus);
+
+// Audio thread, once per tick
+void UpdateMixer(float seconds, bool ducking);
@@ -0,0 +1,200 @@
+#include "net.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    typedef int socklen_t;
+    #define NET_WOULD_BLOCK (WSAGetLastError() == WSAEWOULDBLOCK)
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #define NET_WOULD_BLOCK (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+#endif
+
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0
+#endif
+
+#define MAX_MESSAGE_SIZE 65535    // Frames carry a 16-bit length
+
+bool NetInit(void) {
+#ifdef _WIN32
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+    return true;
+#endif
+}
+
+void NetShutdown(void) {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void NetSetNonBlocking(NetSocket socket) {
+#ifdef _WIN32
+    u_long enabled = 1;
+    ioctlsocket((SOCKET) socket, FIONBIO, &enabled);
+#else
+    fcntl((int) socket, F_SETFL, fcntl((int) socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    // Answers are tiny and latency matters more than throughput
+    int noDelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*) &noDelay, sizeof(noDelay));
+}
+
+void NetClose(NetSocket socket) {
+    if (socket == INVALID_NET_SOCKET) return;
+#ifdef _WIN32
+    closesocket((SOCKET) socket);
+#else
+    close((int) socket);
+#endif
+}
+
+NetSocket NetListen(uint16_t port, int backlog) {
+    NetSocket listener = (NetSocket) socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_NET_SOCKET) return INVALID_NET_SOCKET;
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*) &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+
+    if (bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || listen(listener, backlog) != 0) {
+        NetClose(listener);
+        return INVALID_NET_SOCKET;
+    }
+    NetSetNonBlocking(listener);
+    return listener;
+}
+
+NetSocket NetAccept(NetSocket listener) {
+    NetSocket client = (NetSocket) accept(listener, nullptr, nullptr);
+    if (client == INVALID_NET_SOCKET) return INVALID_NET_SOCKET;
+    NetSetNonBlocking(client);
+    return client;
+}
+
+NetSocket NetConnect(const char* host, uint16_t port) {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &result) != 0 || result == nullptr) return INVALID_NET_SOCKET;
+
+    sockaddr_in address;
+    memcpy(&address, result->ai_addr, sizeof(address));
+    address.sin_port = htons(port);
+    freeaddrinfo(result);
+
+    NetSocket connection = (NetSocket) socket(AF_INET, SOCK_STREAM, 0);
+    if (connection == INVALID_NET_SOCKET) return INVALID_NET_SOCKET;
+    if (connect(connection, (sockaddr*) &address, sizeof(address)) != 0) {
+        NetClose(connection);
+        return INVALID_NET_SOCKET;
+    }
+    NetSetNonBlocking(connection);
+    return connection;
+}
+
+int NetSend(NetSocket socket, const uint8_t* data, int size) {
+    int sent = (int) send(socket, (const char*) data, size, MSG_NOSIGNAL);
+    if (sent < 0) return NET_WOULD_BLOCK ? 0 : -1;
+    return sent;
+}
+
+int NetReceive(NetSocket socket, uint8_t* data, int size) {
+    int received = (int) recv(socket, (char*) data, size, 0);
+    if (received == 0) return -1;    // Orderly shutdown by the peer
+    if (received < 0) return NET_WOULD_BLOCK ? 0 : -1;
+    return received;
+}
+
+NetConnection::NetConnection() : socket(INVALID_NET_SOCKET), inboundRead(0) {}
+
+NetConnection::NetConnection(NetSocket socket) : socket(socket), inboundRead(0) {}
+
+void NetConnection::Close() {
+    NetClose(socket);
+    socket = INVALID_NET_SOCKET;
+    inbound.clear();
+    outbound.clear();
+    inboundRead = 0;
+}
+
+void NetConnection::Send(const std::vector<uint8_t>& message) {
+    if (message.size() > MAX_MESSAGE_SIZE) return;
+    outbound.push_back((uint8_t) (message.size() & 0xFF));
+    outbound.push_back((uint8_t) (message.size() >> 8));
+    outbound.insert(outbound.end(), message.begin(), message.end());
+}
+
+bool NetConnection::Flush() {
+    if (!IsOpen()) return false;
+
+    size_t written = 0;
+    while (written < outbound.size()) {
+        int sent = NetSend(socket, outbound.data() + written, (int) (outbound.size() - written));
+        if (sent < 0) {
+            Close();
+            return false;
+        }
+        if (sent == 0) break;
+        written += sent;
+    }
+    outbound.erase(outbound.begin(), outbound.begin() + written);
+    return true;
+}
+
+bool NetConnection::Receive() {
+    if (!IsOpen()) return false;
+
+    uint8_t chunk[4096];
+    while (true) {
+        int received = NetReceive(socket, chunk, sizeof(chunk));
+        if (received < 0) {
+            Close();
+            return false;
+        }
+        if (received == 0) break;
+        inbound.insert(inbound.end(), chunk, chunk + received);
+    }
+    return true;
+}
+
+bool NetConnection::PopMessage(std::vector<uint8_t>& message) {
+    size_t available = inbound.size() - inboundRead;
+    if (available < 2) return false;
+
+    size_t length = inbound[inboundRead] | (inbound[inboundRead + 1] << 8);
+    if (available < 2 + length) return false;
+
+    message.assign(inbound.begin() + inboundRead + 2, inbound.begin() + inboundRead + 2 + length);
+    inboundRead += 2 + length;
+
+    // Compact once most of what is buffered has been consumed
+    if (inboundRead == inbound.size()) {
+        inbound.clear();
+        inboundRead = 0;
+    } else if (inboundRead > 4096 && inboundRead * 2 > inbound.size()) {
+        inbound.erase(inbound.begin(), inbound.begin() + inboundRead);
+        inboundRead = 0;
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Thin non-blocking TCP layer shared by the online match server, the game client and the classroom host
+typedef intptr_t NetSocket;
+#define INVALID_NET_SOCKET ((NetSocket) -1)
+
+bool NetInit(void);
+void NetShutdown(void);
+
+NetSocket NetListen(uint16_t port, int backlog);    // Listens on every interface, returns INVALID_NET_SOCKET on failure
+NetSocket NetAccept(NetSocket listener);            // Returns INVALID_NET_SOCKET when nobody is waiting
+NetSocket NetConnect(const char* host, uint16_t port);
+void NetSetNonBlocking(NetSocket socket);
+void NetClose(NetSocket socket);
+
+// Sends/receives as much as the socket accepts right now. Returns the byte count, 0 when it would block
+// and -1 when the connection is closed or broken.
+int NetSend(NetSocket socket, const uint8_t* data, int size);
+int NetReceive(NetSocket socket, uint8_t* data, int size);
+
+// Length-prefixed message stream on top of a non-blocking socket
+class NetConnection {
+    public:
+        NetConnection();
+        explicit NetConnection(NetSocket socket);
+
+        bool IsOpen() const { return socket != INVALID_NET_SOCKET; }
+        void Close();
+
+        void Send(const std::vector<uint8_t>& message);    // Queues one framed message
+        bool Flush();                                      // Writes queued bytes, false once the connection is gone
+        bool Receive();                                    // Reads what has arrived, false once the connection is gone
+        bool PopMessage(std::vector<uint8_t>& message);    // Next complete message, in arrival order
+
+    private:
+        NetSocket socket;
+        std::vector<uint8_t> inbound;
+        std::vector<uint8_t> outbound;
+        size_t inboundRead;
+};
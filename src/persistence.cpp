@@ -0,0 +1,185 @@
+#include "persistence.hpp"
+#include <cstdio>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <io.h>
+    #include <fcntl.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#ifdef _WIN32
+bool WriteFileAtomic(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string tempPath = path + ".tmp";
+    int descriptor = _open(tempPath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+    if (descriptor < 0) return false;
+
+    size_t written = 0;
+    while (written < data.size()) {
+        int result = _write(descriptor, data.data() + written, (unsigned int) (data.size() - written));
+        if (result <= 0) break;
+        written += result;
+    }
+    bool ok = (written == data.size()) && _commit(descriptor) == 0;
+    ok = (_close(descriptor) == 0) && ok;
+
+    ok = ok && MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!ok) DeleteFileA(tempPath.c_str());
+    return ok;
+}
+
+bool AppendFileDurable(const std::string& path, const std::vector<uint8_t>& data) {
+    int descriptor = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644);
+    if (descriptor < 0) return false;
+
+    size_t written = 0;
+    while (written < data.size()) {
+        int result = _write(descriptor, data.data() + written, (unsigned int) (data.size() - written));
+        if (result <= 0) break;
+        written += result;
+    }
+    bool ok = (written == data.size()) && _commit(descriptor) == 0;
+    return (_close(descriptor) == 0) && ok;
+}
+#else
+bool WriteFileAtomic(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string tempPath = path + ".tmp";
+    int descriptor = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) return false;
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = write(descriptor, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += (size_t) result;
+    }
+    bool ok = (written == data.size()) && fsync(descriptor) == 0;
+    ok = (close(descriptor) == 0) && ok;
+
+    ok = ok && rename(tempPath.c_str(), path.c_str()) == 0;
+    if (!ok) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+
+    // The rename itself only survives a power cut once the directory entry is flushed too
+    size_t slash = path.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    int directoryDescriptor = open(directory.c_str(), O_RDONLY);
+    if (directoryDescriptor >= 0) {
+        fsync(directoryDescriptor);
+        close(directoryDescriptor);
+    }
+    return true;
+}
+
+bool AppendFileDurable(const std::string& path, const std::vector<uint8_t>& data) {
+    int descriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (descriptor < 0) return false;
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = write(descriptor, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += (size_t) result;
+    }
+    bool ok = (written == data.size()) && fsync(descriptor) == 0;
+    return (close(descriptor) == 0) && ok;
+}
+#endif
+
+static bool WritePending(const std::string& path, const std::vector<uint8_t>& data, bool append) {
+    return append ? AppendFileDurable(path, data) : WriteFileAtomic(path, data);
+}
+
+PersistenceWriter::PersistenceWriter() : running(false), writing(false), failures(0) {}
+
+PersistenceWriter::~PersistenceWriter() {
+    Stop();
+}
+
+void PersistenceWriter::Start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) return;
+    running = true;
+    thread = std::thread(&PersistenceWriter::Run, this);
+}
+
+void PersistenceWriter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void PersistenceWriter::Write(const std::string& path, std::vector<uint8_t> data) {
+    Queue(path, data, false);
+}
+
+void PersistenceWriter::Append(const std::string& path, std::vector<uint8_t> data) {
+    Queue(path, data, true);
+}
+
+void PersistenceWriter::Queue(const std::string& path, std::vector<uint8_t>& data, bool append) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!running) {
+        lock.unlock();
+        if (!WritePending(path, data, append)) {
+            failures++;
+            printf("PERSIST: Could not write %s\n", path.c_str());
+        }
+        return;
+    }
+
+    // Only the newest queued entry of the same file may be replaced, and only snapshot by snapshot
+    if (!append) {
+        for (auto pending = queue.rbegin(); pending != queue.rend(); ++pending) {
+            if (pending->path != path) continue;
+            if (!pending->append) {
+                pending->data.swap(data);
+                return;
+            }
+            break;
+        }
+    }
+    queue.push_back(PendingWrite{path, std::move(data), append});
+    lock.unlock();
+    wake.notify_one();
+}
+
+void PersistenceWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() && !writing; });
+}
+
+void PersistenceWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return !queue.empty() || !running; });
+        if (queue.empty()) break;    // Stopped and drained
+
+        PendingWrite pending = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        lock.unlock();
+
+        if (!WritePending(pending.path, pending.data, pending.append)) {
+            failures++;
+            printf("PERSIST: Could not write %s\n", pending.path.c_str());
+        }
+
+        lock.lock();
+        writing = false;
+        if (queue.empty()) idle.notify_all();
+    }
+    idle.notify_all();
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes `data` to `path + ".tmp"`, flushes it to the device and renames it over `path`, so a power cut or crash
+// leaves either the old or the new file on disk, never a torn one
+bool WriteFileAtomic(const std::string& path, const std::vector<uint8_t>& data);
+
+// Appends `data` to `path` (creating it when missing) and flushes it to the device. A crash can leave a partial
+// tail, which is why appended formats carry their own checksums, see score_store.hpp.
+bool AppendFileDurable(const std::string& path, const std::vector<uint8_t>& data);
+
+// Write-behind saver: the game thread queues complete file snapshots and a background thread writes them with
+// WriteFileAtomic, so slow storage (SD cards on kiosks) never stalls a frame
+class PersistenceWriter {
+    public:
+        PersistenceWriter();
+        ~PersistenceWriter();
+
+        void Start();
+        void Stop();    // Writes everything still queued, then joins the thread
+
+        // Queues a snapshot of `path`. A newer snapshot replaces an older one of the same file that is still waiting.
+        // Before Start() (or after Stop()) the file is written immediately on the calling thread.
+        void Write(const std::string& path, std::vector<uint8_t> data);
+
+        // Queues bytes to append to `path`. Appends are never merged and keep their order with the snapshots of the
+        // same file, so a compaction snapshot followed by appends lands exactly in that order.
+        void Append(const std::string& path, std::vector<uint8_t> data);
+
+        // Blocks until the queue is empty and the current write finished
+        void Flush();
+
+        int GetFailureCount() const { return failures.load(); }
+
+    private:
+        struct PendingWrite {
+            std::string path;
+            std::vector<uint8_t> data;
+            bool append;
+        };
+
+        void Queue(const std::string& path, std::vector<uint8_t>& data, bool append);
+        void Run();
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::deque<PendingWrite> queue;
+        bool running;
+        bool writing;
+        std::atomic<int> failures;
+};
@@ -0,0 +1,104 @@
+#include "players.hpp"
+#include <algorithm>
+
+void ResetPlayers(std::vector<Player>& players, int count) {
+    count = std::max(MIN_PLAYERS, std::min(MAX_PLAYERS, count));
+    players.assign(count, Player{"", 0, PLAYER_START_HEALTH, -1, false, 0});
+}
+
+void SetPlayerCount(std::vector<Player>& players, int count) {
+    count = std::max(MIN_PLAYERS, std::min(MAX_PLAYERS, count));
+    players.resize(count, Player{"", 0, PLAYER_START_HEALTH, -1, false, 0});
+}
+
+void ResetPlayerAnswers(std::vector<Player>& players) {
+    for (Player& player : players) {
+        player.answer = -1;
+        player.selected = false;
+        player.answerTimeNs = 0;
+    }
+}
+
+bool HaveAllPlayersAnswered(const std::vector<Player>& players) {
+    for (const Player& player : players) {
+        if (!player.selected) return false;
+    }
+    return !players.empty();
+}
+
+bool IsAnyPlayerAtHealth(const std::vector<Player>& players, int healthPoints) {
+    for (const Player& player : players) {
+        if (player.healthPoints == healthPoints) return true;
+    }
+    return false;
+}
+
+bool IsAnyPlayerOutOfHealth(const std::vector<Player>& players) {
+    for (const Player& player : players) {
+        if (player.healthPoints <= 0) return true;
+    }
+    return false;
+}
+
+RoundResult EvaluateRound(std::vector<Player>& players, int correctAnswerIndex) {
+    RoundResult result{-1, 0, 0};
+
+    int order[MAX_PLAYERS];
+    int count = std::min((int) players.size(), MAX_PLAYERS);
+    // Insertion sort: at most MAX_PLAYERS entries, and equal timestamps keep the player order
+    for (int i = 0; i < count; i++) {
+        int j = i;
+        while (j > 0 && players[order[j - 1]].answerTimeNs > players[i].answerTimeNs) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int i = 0; i < count; i++) {
+        Player& player = players[order[i]];
+        if (player.answer == correctAnswerIndex) {
+            if (result.fastestCorrectPlayer == -1) {
+                result.fastestCorrectPlayer = order[i];
+                player.score++;
+            }
+            result.correctCount++;
+        } else {
+            player.healthPoints--;
+            result.wrongCount++;
+        }
+    }
+
+    return result;
+}
+
+std::string DescribeRoundResult(const RoundResult& result, int playerCount) {
+    std::string fastestPlayer = "Player " + std::to_string(result.fastestCorrectPlayer + 1);
+
+    if (result.correctCount == 0) return (playerCount == 2) ? "Both players got the wrong answer!" : "Everyone got the wrong answer!";
+    if (result.correctCount == 1) return fastestPlayer + " got the correct answer!";
+
+    std::string correctPlayers = (result.correctCount == 2) ? "Both players" : std::to_string(result.correctCount) + " players";
+    return correctPlayers + " are correct, but " + fastestPlayer + " was faster!";
+}
+
+std::string DescribeTimeout(int playerCount) {
+    return (playerCount == 2) ? "You both ran out of time!" : "Everyone ran out of time!";
+}
+
+int GetWinningPlayer(const std::vector<Player>& players) {
+    int winner = -1;
+    int bestScore = -1;
+    bool isShared = false;
+
+    for (int i = 0; i < (int) players.size(); i++) {
+        if (players[i].score > bestScore) {
+            bestScore = players[i].score;
+            winner = i;
+            isShared = false;
+        } else if (players[i].score == bestScore) {
+            isShared = true;
+        }
+    }
+    return isShared ? -1 : winner;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define MIN_PLAYERS 2
+#define MAX_PLAYERS 8
+#define PLAYER_START_HEALTH 10
+
+// One local multiplayer participant. Keyboard zones and gamepads map onto the player index through the input bindings.
+struct Player {
+    std::string name;
+    int score;
+    int healthPoints;
+    int answer;              // -1 until the player locks in a choice
+    bool selected;
+    uint64_t answerTimeNs;   // Monotonic timestamp of the locked-in answer
+};
+
+struct RoundResult {
+    int fastestCorrectPlayer;    // -1 when nobody answered correctly
+    int correctCount;
+    int wrongCount;
+};
+
+// Sets up `count` players with full health and empty names
+void ResetPlayers(std::vector<Player>& players, int count);
+
+// Adds or removes players at the end, keeping the names already typed in
+void SetPlayerCount(std::vector<Player>& players, int count);
+
+// Clears the per-question answer state but keeps names, scores and health
+void ResetPlayerAnswers(std::vector<Player>& players);
+
+bool HaveAllPlayersAnswered(const std::vector<Player>& players);
+bool IsAnyPlayerAtHealth(const std::vector<Player>& players, int healthPoints);
+bool IsAnyPlayerOutOfHealth(const std::vector<Player>& players);
+
+// Sorts the answers by timestamp and awards everything in one pass: the fastest correct player scores a point,
+// every wrong player loses a health point, and if nobody is correct everyone loses a health point
+RoundResult EvaluateRound(std::vector<Player>& players, int correctAnswerIndex);
+
+// Messages shown once a round is evaluated or runs out of time, shared by the local and online modes
+std::string DescribeRoundResult(const RoundResult& result, int playerCount);
+std::string DescribeTimeout(int playerCount);
+
+// Returns the index of the player with the highest score, or -1 when the top score is shared
+int GetWinningPlayer(const std::vector<Player>& players);
@@ -0,0 +1,247 @@
+#include "practice.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "score_store.hpp"
+
+#define PRACTICE_MAGIC "BBPD"
+#define PRACTICE_VERSION 1
+#define PRACTICE_HEADER_SIZE 20
+#define PRACTICE_CARD_SIZE 16
+#define PRACTICE_EASE_START 2500
+#define PRACTICE_EASE_MIN 1300
+#define PRACTICE_MINUTES_PER_DAY 1440
+#define PRACTICE_INTERVAL_MAX (3650u * PRACTICE_MINUTES_PER_DAY)    // Ten years, keeps due times far from overflowing
+
+int GetPracticeGrade(bool answered, bool correct, uint32_t latencyMs) {
+    if (!answered) return 0;
+    if (!correct) return 1;
+    if (latencyMs < PRACTICE_FAST_MS) return 5;
+    return latencyMs < PRACTICE_SLOW_MS ? 4 : 3;
+}
+
+void ScheduleReview(ReviewCard& card, int grade, uint32_t nowMinutes) {
+    grade = std::max(0, std::min(5, grade));
+    if (grade < 3) {
+        card.repetitions = 0;
+        card.interval = PRACTICE_RELEARN_MINUTES;
+        if (card.lapses < 255) card.lapses++;
+    }
+    else {
+        if (card.repetitions == 0) card.interval = PRACTICE_MINUTES_PER_DAY;
+        else if (card.repetitions == 1) card.interval = 6 * PRACTICE_MINUTES_PER_DAY;
+        else card.interval = (uint32_t) std::min<uint64_t>(PRACTICE_INTERVAL_MAX, (uint64_t) card.interval * card.ease / 1000);
+        if (card.repetitions < 255) card.repetitions++;
+    }
+
+    // EF' = EF + 0.1 - (5 - q) * (0.08 + (5 - q) * 0.02), in thousandths
+    int miss = 5 - grade;
+    card.ease = (uint16_t) std::max(PRACTICE_EASE_MIN, (int) card.ease + 100 - miss * (80 + miss * 20));
+    card.due = nowMinutes + card.interval;
+}
+
+std::string GetPracticeProfilePath(const std::string& name) {
+    std::string safeName;
+    for (char c : name) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_') safeName += c;
+    }
+    if (safeName.empty()) safeName = PRACTICE_DEFAULT_PROFILE;
+    return std::string(PRACTICE_FILE_DIRECTORY) + "/practice-" + safeName + ".bpd";
+}
+
+PracticeDeck::PracticeDeck() {}
+
+void PracticeDeck::Reset(const std::vector<uint8_t>& questionCategories, int categoryCount) {
+    categories = questionCategories;
+    cards.clear();
+    heap.clear();
+    heapPositions.clear();
+    cardOf.assign(categories.size(), -1);
+    unseen.assign(categoryCount, std::vector<int>());
+    unseenPositions.assign(categories.size(), -1);
+    for (int question = 0; question < (int) categories.size(); question++) {
+        if (categories[question] >= categoryCount) continue;    // Never offered as a new card
+        unseenPositions[question] = (int) unseen[categories[question]].size();
+        unseen[categories[question]].push_back(question);
+    }
+    categoryAttempts.assign(categoryCount, 0);
+    categoryCorrect.assign(categoryCount, 0);
+}
+
+bool PracticeDeck::Load(const uint8_t* data, size_t size) {
+    if (size < PRACTICE_HEADER_SIZE || memcmp(data, PRACTICE_MAGIC, 4) != 0 || ReadU32(data + 4) != PRACTICE_VERSION) return false;
+    if (Crc32(data + 12, size - 12) != ReadU32(data + 8)) return false;
+    if (ReadU32(data + 12) != categories.size()) {
+        printf("PRACTICE: The profile has %u questions, the game has %i, starting over\n", ReadU32(data + 12), (int) categories.size());
+        return false;
+    }
+    uint64_t categoryCount = ReadU32(data + 16);
+    uint64_t statsSize = categoryCount * 8;
+    if (categoryCount != unseen.size() || size - PRACTICE_HEADER_SIZE < statsSize ||
+        (size - PRACTICE_HEADER_SIZE - statsSize) % PRACTICE_CARD_SIZE != 0) return false;
+
+    Reset(categories, (int) categoryCount);
+    const uint8_t* stats = data + PRACTICE_HEADER_SIZE;
+    for (size_t i = 0; i < categoryCount; i++) {
+        categoryAttempts[i] = ReadU32(stats + 8 * i);
+        categoryCorrect[i] = ReadU32(stats + 8 * i + 4);
+    }
+
+    const uint8_t* end = data + size;
+    cards.reserve((end - stats - statsSize) / PRACTICE_CARD_SIZE);
+    for (const uint8_t* entry = stats + statsSize; entry < end; entry += PRACTICE_CARD_SIZE) {
+        uint32_t question = ReadU32(entry);
+        if (question >= cardOf.size() || cardOf[question] != -1) continue;    // Stale or duplicate card
+        int card = AddCard((int) question, 0);
+        cards[card].due = ReadU32(entry + 4);
+        cards[card].interval = ReadU32(entry + 8);
+        cards[card].ease = (uint16_t) std::max(PRACTICE_EASE_MIN, entry[12] | (entry[13] << 8));
+        cards[card].repetitions = entry[14];
+        cards[card].lapses = entry[15];
+    }
+
+    // The cards were added with due time 0, so the heap is rebuilt once, in linear time
+    for (size_t position = heap.size() / 2; position-- > 0; ) SiftDown(position);
+    return true;
+}
+
+std::vector<uint8_t> PracticeDeck::Encode() const {
+    std::vector<uint8_t> data(PRACTICE_MAGIC, PRACTICE_MAGIC + 4);
+    data.reserve(PRACTICE_HEADER_SIZE + unseen.size() * 8 + cards.size() * PRACTICE_CARD_SIZE);
+    AppendU32(data, PRACTICE_VERSION);
+    AppendU32(data, 0);    // CRC-32, filled in below
+    AppendU32(data, (uint32_t) categories.size());
+    AppendU32(data, (uint32_t) unseen.size());
+    for (size_t i = 0; i < unseen.size(); i++) {
+        AppendU32(data, categoryAttempts[i]);
+        AppendU32(data, categoryCorrect[i]);
+    }
+    for (const ReviewCard& card : cards) {
+        AppendU32(data, card.question);
+        AppendU32(data, card.due);
+        AppendU32(data, card.interval);
+        data.push_back((uint8_t) card.ease);
+        data.push_back((uint8_t) (card.ease >> 8));
+        data.push_back(card.repetitions);
+        data.push_back(card.lapses);
+    }
+
+    uint32_t crc = Crc32(data.data() + 12, data.size() - 12);
+    for (int i = 0; i < 4; i++) data[8 + i] = (uint8_t) (crc >> (8 * i));
+    return data;
+}
+
+int PracticeDeck::AddCard(int question, uint32_t nowMinutes) {
+    int card = (int) cards.size();
+    cards.push_back(ReviewCard{(uint32_t) question, nowMinutes, 0, PRACTICE_EASE_START, 0, 0});
+    cardOf[question] = card;
+    heapPositions.push_back((int) heap.size());
+    heap.push_back(card);
+
+    // Swap-removes the question from its category's unseen list
+    int position = unseenPositions[question];
+    if (position != -1) {
+        std::vector<int>& list = unseen[categories[question]];
+        list[position] = list.back();
+        unseenPositions[list[position]] = position;
+        list.pop_back();
+        unseenPositions[question] = -1;
+    }
+    return card;
+}
+
+bool PracticeDeck::Earlier(int a, int b) const {
+    if (cards[a].due != cards[b].due) return cards[a].due < cards[b].due;
+    return cards[a].question < cards[b].question;
+}
+
+void PracticeDeck::Place(size_t position, int card) {
+    heap[position] = card;
+    heapPositions[card] = (int) position;
+}
+
+void PracticeDeck::SiftUp(size_t position) {
+    int card = heap[position];
+    while (position > 0 && Earlier(card, heap[(position - 1) / 2])) {
+        Place(position, heap[(position - 1) / 2]);
+        position = (position - 1) / 2;
+    }
+    Place(position, card);
+}
+
+void PracticeDeck::SiftDown(size_t position) {
+    int card = heap[position];
+    for (;;) {
+        size_t child = 2 * position + 1;
+        if (child >= heap.size()) break;
+        if (child + 1 < heap.size() && Earlier(heap[child + 1], heap[child])) child++;
+        if (!Earlier(heap[child], card)) break;
+        Place(position, heap[child]);
+        position = child;
+    }
+    Place(position, card);
+}
+
+int PracticeDeck::GetWeakestCategory() const {
+    // Success rate with one right and one wrong answer assumed, so an untried category counts as 50%
+    int weakest = -1;
+    double weakestRate = 2.0;
+    for (int category = 0; category < (int) unseen.size(); category++) {
+        if (unseen[category].empty()) continue;
+        double rate = (categoryCorrect[category] + 1.0) / (categoryAttempts[category] + 2.0);
+        if (rate < weakestRate) weakest = category, weakestRate = rate;
+    }
+    return weakest;
+}
+
+int PracticeDeck::Next(SessionRandom& random, uint32_t nowMinutes, int exclude) {
+    // The earliest card that is not `exclude`: the root, or when the root is excluded the earlier of its children
+    int candidate = heap.empty() ? -1 : heap[0];
+    if (candidate != -1 && (int) cards[candidate].question == exclude) {
+        candidate = heap.size() > 1 ? heap[1] : -1;
+        if (heap.size() > 2 && Earlier(heap[2], heap[1])) candidate = heap[2];
+    }
+    if (candidate != -1 && cards[candidate].due <= nowMinutes) return (int) cards[candidate].question;
+
+    int category = GetWeakestCategory();
+    if (category != -1) {
+        const std::vector<int>& list = unseen[category];
+        return list[random.NextBelow((uint32_t) list.size())];
+    }
+
+    // Every question has a card and none is due: practice ahead
+    if (candidate != -1) return (int) cards[candidate].question;
+    return heap.empty() ? -1 : (int) cards[heap[0]].question;
+}
+
+void PracticeDeck::Review(int question, int grade, uint32_t nowMinutes) {
+    if (question < 0 || question >= (int) cardOf.size()) return;
+    int card = cardOf[question];
+    bool isNew = card == -1;
+    if (isNew) card = AddCard(question, nowMinutes);
+
+    if (categories[question] < unseen.size()) {
+        categoryAttempts[categories[question]]++;
+        if (grade >= 3) categoryCorrect[categories[question]]++;
+    }
+
+    uint32_t previousDue = cards[card].due;
+    ScheduleReview(cards[card], grade, nowMinutes);
+    // A new card sits at the end of the heap, not yet in order with its parent, so it can only move up
+    if (isNew || cards[card].due < previousDue) SiftUp(heapPositions[card]);
+    else SiftDown(heapPositions[card]);
+}
+
+void PracticeDeck::CountDue(size_t position, uint32_t nowMinutes, size_t& count) const {
+    // Children are never due before their parent, so a subtree whose root is not due is skipped whole
+    if (position >= heap.size() || cards[heap[position]].due > nowMinutes) return;
+    count++;
+    CountDue(2 * position + 1, nowMinutes, count);
+    CountDue(2 * position + 2, nowMinutes, count);
+}
+
+size_t PracticeDeck::GetDueCount(uint32_t nowMinutes) const {
+    size_t count = 0;
+    CountDue(0, nowMinutes, count);
+    return count;
+}
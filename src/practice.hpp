@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "session_random.hpp"
+
+// Spaced repetition for the practice mode: every question a student has seen is a card scheduled with SM-2.
+//
+// A right answer pushes the card out by a growing interval (1 day, 6 days, then the last interval times the card's
+// ease), a wrong one brings it back within minutes and lowers the ease. Cards wait in a binary min-heap keyed by due
+// time, which also tracks every card's position, so popping the next due card and rescheduling one are both
+// O(log n). When nothing is due, new cards come from the category the student answers worst.
+//
+// A profile is saved as one snapshot: "BBPD", u32 version, u32 CRC-32 of the rest, u32 question count,
+// u32 category count, then u32 attempts and u32 correct per category and 16 bytes per card.
+#define PRACTICE_FILE_DIRECTORY "data"
+#define PRACTICE_DEFAULT_PROFILE "default"
+#define PRACTICE_RELEARN_MINUTES 1       // A lapsed card comes back this soon
+#define PRACTICE_SAVE_EVERY 25           // Reviews between saves while practicing
+#define PRACTICE_FAST_MS 4000            // Answers faster than this count as easy recalls,
+#define PRACTICE_SLOW_MS 10000           // slower than this as hard ones
+
+// 16 bytes, the same in memory and on disk
+struct ReviewCard {
+    uint32_t question;
+    uint32_t due;           // Unix minutes
+    uint32_t interval;      // Minutes
+    uint16_t ease;          // Interval factor in thousandths, at least 1300
+    uint8_t repetitions;    // Right answers in a row
+    uint8_t lapses;
+};
+
+// SM-2 grade, 0-5, of an answer that took `latencyMs`. Timeouts are 0, wrong answers 1, right ones 3-5 by speed.
+int GetPracticeGrade(bool answered, bool correct, uint32_t latencyMs);
+
+// Sets the card's next interval and due time after a review graded 0-5
+void ScheduleReview(ReviewCard& card, int grade, uint32_t nowMinutes);
+
+// data/practice-<name>.bpd, with the name reduced to letters, digits, '-' and '_'
+std::string GetPracticeProfilePath(const std::string& name);
+
+class PracticeDeck {
+    public:
+        PracticeDeck();
+
+        // `categories` holds the category of every question id, `categoryCount` the number of categories. Drops all cards.
+        void Reset(const std::vector<uint8_t>& categories, int categoryCount);
+
+        // Replaces the cards with a saved profile. Fails on a corrupt file or one made for a different question
+        // count, question ids being positions in the question list.
+        bool Load(const uint8_t* data, size_t size);
+        std::vector<uint8_t> Encode() const;
+
+        // The question to practice next: the most overdue card, else a new card from the weakest category, else
+        // (every question seen) the card due soonest. Avoids `exclude`, the question just asked, when it can.
+        // -1 when the bank is empty.
+        int Next(SessionRandom& random, uint32_t nowMinutes, int exclude);
+
+        // Reschedules the question's card, adding it if it is new
+        void Review(int question, int grade, uint32_t nowMinutes);
+
+        size_t GetCardCount() const { return cards.size(); }
+        size_t GetDueCount(uint32_t nowMinutes) const;    // O(due cards)
+        int GetWeakestCategory() const;                   // -1 once every question has a card
+
+    private:
+        int AddCard(int question, uint32_t nowMinutes);
+        bool Earlier(int a, int b) const;
+        void SiftUp(size_t position);
+        void SiftDown(size_t position);
+        void Place(size_t position, int card);
+        void CountDue(size_t position, uint32_t nowMinutes, size_t& count) const;
+
+        std::vector<ReviewCard> cards;
+        std::vector<int> heap;             // Card indices, earliest due first
+        std::vector<int> heapPositions;    // Card index -> position in `heap`
+        std::vector<int> cardOf;           // Question id -> card index, -1 when unseen
+        std::vector<uint8_t> categories;
+        std::vector<std::vector<int>> unseen;    // Per category, questions without a card
+        std::vector<int> unseenPositions;        // Question id -> position in its `unseen` list
+        std::vector<uint32_t> categoryAttempts;
+        std::vector<uint32_t> categoryCorrect;
+};
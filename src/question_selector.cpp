@@ -0,0 +1,100 @@
+#include "question_selector.hpp"
+#include <algorithm>
+#include <cmath>
+
+AdaptiveQuestionSelector::AdaptiveQuestionSelector() : highestBit(0) {}
+
+void AdaptiveQuestionSelector::Rebuild(const std::vector<float>& difficulties) {
+    size_t count = difficulties.size();
+    order.resize(count);
+    for (size_t i = 0; i < count; i++) order[i] = (int) i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return difficulties[a] < difficulties[b]; });
+
+    sortedDifficulties.resize(count);
+    positions.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        sortedDifficulties[i] = difficulties[order[i]];
+        positions[order[i]] = (int) i;
+    }
+
+    // Every question starts available. A Fenwick tree of ones is built in linear time by pushing each node's
+    // count up to its parent.
+    available.assign(count, 1);
+    tree.assign(count + 1, 1);
+    tree[0] = 0;
+    for (size_t i = 1; i <= count; i++) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= count) tree[parent] += tree[i];
+    }
+    highestBit = 1;
+    while (highestBit * 2 <= count) highestBit *= 2;
+}
+
+void AdaptiveQuestionSelector::SetAvailable(int position, bool value) {
+    if (available[position] == value) return;
+    available[position] = value;
+    int delta = value ? 1 : -1;
+    for (size_t i = position + 1; i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+}
+
+int AdaptiveQuestionSelector::CountBefore(size_t position) const {
+    int count = 0;
+    for (size_t i = position; i > 0; i -= i & (~i + 1)) count += tree[i];
+    return count;
+}
+
+size_t AdaptiveQuestionSelector::FindAvailable(int index) const {
+    // Descends the implicit tree: skips every block whose count is not larger than what is left
+    size_t position = 0;
+    for (size_t step = highestBit; step > 0; step /= 2) {
+        if (position + step < tree.size() && tree[position + step] <= index) {
+            position += step;
+            index -= tree[position];
+        }
+    }
+    return position;
+}
+
+// One standard normal draw (Box-Muller)
+static double NextNormal(SessionRandom& random) {
+    double u = 1.0 - random.NextUnit();    // (0, 1], keeps log() finite
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * random.NextUnit());
+}
+
+int AdaptiveQuestionSelector::Pick(SessionRandom& random, float ability, std::vector<int>& history, size_t historySize) {
+    if (order.empty()) return -1;
+
+    // The history is masked only for this pick, so it can be cleared or replaced between picks
+    masked.clear();
+    for (int question : history) {
+        if (question < 0 || question >= (int) order.size() || !available[positions[question]]) continue;
+        SetAvailable(positions[question], false);
+        masked.push_back(positions[question]);
+    }
+
+    int total = CountBefore(order.size());
+    int question;
+    if (total == 0) question = (int) random.NextBelow((uint32_t) order.size());    // Bank smaller than the history
+    else {
+        size_t low = 0, high = order.size();
+        if (random.NextUnit() >= SELECTOR_EXPLORE) {
+            // Where P(correct) = 1 / (1 + e^(difficulty - ability)) equals the target success rate
+            float target = ability - std::log(SELECTOR_TARGET_SUCCESS / (1.0f - SELECTOR_TARGET_SUCCESS)) +
+                           SELECTOR_SPREAD * (float) NextNormal(random);
+            for (float window = SELECTOR_WINDOW; ; window *= 2) {
+                low = std::lower_bound(sortedDifficulties.begin(), sortedDifficulties.end(), target - window) - sortedDifficulties.begin();
+                high = std::upper_bound(sortedDifficulties.begin(), sortedDifficulties.end(), target + window) - sortedDifficulties.begin();
+                if (CountBefore(high) > CountBefore(low) || (low == 0 && high == order.size())) break;
+            }
+        }
+        int first = CountBefore(low);
+        int count = CountBefore(high) - first;
+        question = order[FindAvailable(first + (int) random.NextBelow((uint32_t) count))];
+    }
+
+    for (int position : masked) SetAvailable(position, true);
+
+    if (history.size() >= historySize && !history.empty()) history.erase(history.begin());
+    history.push_back(question);
+    return question;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "session_random.hpp"
+
+// Picks questions that match a player's skill, using the difficulty estimates from question_telemetry.hpp.
+//
+// Questions are kept sorted by difficulty with a Fenwick tree of which ones may be asked. A pick draws a target
+// difficulty around the level the player answers correctly SELECTOR_TARGET_SUCCESS of the time, then takes a
+// uniform question from the smallest window around the target that still has one available. Both steps are
+// binary searches, so a pick is O(log n) for any bank size, and a new ability needs no rebuild.
+#define SELECTOR_TARGET_SUCCESS 0.7f
+#define SELECTOR_SPREAD 0.6f        // Logits, standard deviation of the target so the level varies a little
+#define SELECTOR_WINDOW 0.25f       // Logits, starting half-width of the window, doubled until it has a question
+#define SELECTOR_EXPLORE 0.15       // Share of picks made uniformly, so new and rarely asked questions get rated
+
+class AdaptiveQuestionSelector {
+    public:
+        AdaptiveQuestionSelector();
+
+        // Difficulty per question id, in logits. O(n log n), done once per session.
+        void Rebuild(const std::vector<float>& difficulties);
+        size_t Size() const { return order.size(); }
+
+        // Picks a question for a player of `ability` that is not in `history`, then records it there and drops the
+        // oldest entry past `historySize`, the same contract as GetUniqueRandomValue
+        int Pick(SessionRandom& random, float ability, std::vector<int>& history, size_t historySize);
+
+    private:
+        void SetAvailable(int position, bool value);
+        int CountBefore(size_t position) const;    // Available questions in positions [0, position)
+        size_t FindAvailable(int index) const;     // Position of the index-th (0-based) available question
+
+        std::vector<int> order;                    // Question ids, easiest first
+        std::vector<float> sortedDifficulties;
+        std::vector<int> positions;                // Question id -> position in `order`
+        std::vector<int> tree;                     // Fenwick tree over positions, 1 per available question
+        std::vector<uint8_t> available;
+        std::vector<int> masked;                   // Positions of the history during a pick, kept to reuse its memory
+        size_t highestBit;
+};
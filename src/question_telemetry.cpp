@@ -0,0 +1,243 @@
+#include "question_telemetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "score_store.hpp"
+
+#define TELEMETRY_MAGIC "BBQT"
+#define DIFFICULTY_MAGIC "BBQD"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_FRAME_SIZE 12          // Magic, payload length, CRC-32
+#define TELEMETRY_SAMPLE_SIZE 20
+#define DIFFICULTY_HEADER_SIZE 12
+#define DIFFICULTY_ENTRY_SIZE 40
+#define QUESTION_STEP_MIN 0.02f          // Difficulty step once a question has hundreds of answers
+#define ABILITY_STEP_MIN 0.15f           // Ability keeps adapting within a game
+#define DIFFICULTY_LIMIT 6.0f            // Logits, e^6 is about 400:1 odds
+
+float ExpectedCorrect(float ability, float difficulty) {
+    return 1.0f / (1.0f + std::exp(difficulty - ability));
+}
+
+void UpdateEstimate(QuestionEstimate& estimate, const AnswerSample& sample) {
+    // The step starts large so a new question finds its level in a few dozen answers, then settles
+    float step = std::max(QUESTION_STEP_MIN, 1.0f / std::sqrt(1.0f + estimate.attempts));
+    float surprise = (sample.correct ? 1.0f : 0.0f) - ExpectedCorrect(sample.ability, estimate.difficulty);
+    estimate.difficulty = std::max(-DIFFICULTY_LIMIT, std::min(DIFFICULTY_LIMIT, estimate.difficulty - step * surprise));
+
+    estimate.attempts++;
+    if (sample.correct) estimate.correct++;
+    if (sample.answer >= 0 && sample.answer < 4) {
+        estimate.choices[sample.answer]++;
+        estimate.totalLatencyMs += sample.latencyMs;
+    }
+    else estimate.timeouts++;
+}
+
+float UpdateAbility(float ability, float difficulty, bool correct, int answered) {
+    float step = std::max(ABILITY_STEP_MIN, 1.0f / std::sqrt(1.0f + answered));
+    float surprise = (correct ? 1.0f : 0.0f) - ExpectedCorrect(ability, difficulty);
+    return std::max(-DIFFICULTY_LIMIT, std::min(DIFFICULTY_LIMIT, ability + step * surprise));
+}
+
+std::vector<uint8_t> EncodeEstimates(const std::vector<QuestionEstimate>& estimates) {
+    std::vector<uint8_t> data(DIFFICULTY_MAGIC, DIFFICULTY_MAGIC + 4);
+    data.reserve(DIFFICULTY_HEADER_SIZE + estimates.size() * DIFFICULTY_ENTRY_SIZE);
+    AppendU32(data, TELEMETRY_VERSION);
+    AppendU32(data, (uint32_t) estimates.size());
+    for (const QuestionEstimate& estimate : estimates) {
+        AppendFloat(data, estimate.difficulty);
+        AppendU32(data, estimate.attempts);
+        AppendU32(data, estimate.correct);
+        AppendU32(data, estimate.timeouts);
+        for (uint32_t choice : estimate.choices) AppendU32(data, choice);
+        AppendU32(data, (uint32_t) estimate.totalLatencyMs);
+        AppendU32(data, (uint32_t) (estimate.totalLatencyMs >> 32));
+    }
+    return data;
+}
+
+bool ParseEstimates(const uint8_t* data, size_t size, std::vector<QuestionEstimate>& estimates) {
+    if (size < DIFFICULTY_HEADER_SIZE || memcmp(data, DIFFICULTY_MAGIC, 4) != 0 || ReadU32(data + 4) != TELEMETRY_VERSION) return false;
+    uint64_t count = ReadU32(data + 8);
+    if (size != DIFFICULTY_HEADER_SIZE + count * DIFFICULTY_ENTRY_SIZE) return false;
+
+    estimates.clear();
+    for (const uint8_t* entry = data + DIFFICULTY_HEADER_SIZE; entry < data + size; entry += DIFFICULTY_ENTRY_SIZE) {
+        QuestionEstimate estimate;
+        estimate.difficulty = ReadFloat(entry);
+        if (!(estimate.difficulty >= -DIFFICULTY_LIMIT && estimate.difficulty <= DIFFICULTY_LIMIT)) estimate.difficulty = 0.0f;    // Also NaN
+        estimate.attempts = ReadU32(entry + 4);
+        estimate.correct = ReadU32(entry + 8);
+        estimate.timeouts = ReadU32(entry + 12);
+        for (int i = 0; i < 4; i++) estimate.choices[i] = ReadU32(entry + 16 + 4 * i);
+        estimate.totalLatencyMs = ReadU32(entry + 32) | ((uint64_t) ReadU32(entry + 36) << 32);
+        estimates.push_back(estimate);
+    }
+    return true;
+}
+
+std::vector<uint8_t> EncodeTelemetryBatch(const AnswerSample* samples, size_t count) {
+    std::vector<uint8_t> payload;
+    payload.reserve(5 + count * TELEMETRY_SAMPLE_SIZE);
+    payload.push_back(TELEMETRY_VERSION);
+    AppendU32(payload, (uint32_t) count);
+    for (size_t i = 0; i < count; i++) {
+        const AnswerSample& sample = samples[i];
+        AppendU32(payload, (uint32_t) sample.timestamp);
+        AppendU32(payload, (uint32_t) ((uint64_t) sample.timestamp >> 32));
+        payload.push_back((uint8_t) sample.question);
+        payload.push_back((uint8_t) (sample.question >> 8));
+        payload.push_back((uint8_t) sample.answer);
+        payload.push_back(sample.correct ? 1 : 0);
+        AppendU32(payload, sample.latencyMs);
+        AppendFloat(payload, sample.ability);
+    }
+
+    std::vector<uint8_t> data(TELEMETRY_MAGIC, TELEMETRY_MAGIC + 4);
+    AppendU32(data, (uint32_t) payload.size());
+    AppendU32(data, Crc32(payload.data(), payload.size()));
+    data.insert(data.end(), payload.begin(), payload.end());
+    return data;
+}
+
+size_t ParseTelemetryLog(const uint8_t* data, size_t size, std::vector<AnswerSample>& samples) {
+    size_t offset = 0, skipped = 0;
+    while (offset < size) {
+        bool good = size - offset >= TELEMETRY_FRAME_SIZE + 5 && memcmp(data + offset, TELEMETRY_MAGIC, 4) == 0;
+        uint64_t length = good ? ReadU32(data + offset + 4) : 0;
+        const uint8_t* payload = data + offset + TELEMETRY_FRAME_SIZE;
+        good = good && length >= 5 && size - offset - TELEMETRY_FRAME_SIZE >= length && payload[0] == TELEMETRY_VERSION &&
+               length == 5 + (uint64_t) ReadU32(payload + 1) * TELEMETRY_SAMPLE_SIZE &&
+               Crc32(payload, length) == ReadU32(data + offset + 8);
+        if (!good) {
+            // Skip to the next batch
+            size_t next = offset + 1;
+            while (next + 4 <= size && memcmp(data + next, TELEMETRY_MAGIC, 4) != 0) next++;
+            if (next + 4 > size) next = size;
+            skipped += next - offset;
+            offset = next;
+            continue;
+        }
+
+        for (const uint8_t* sample = payload + 5; sample < payload + length; sample += TELEMETRY_SAMPLE_SIZE) {
+            AnswerSample decoded;
+            decoded.timestamp = (int64_t) (ReadU32(sample) | ((uint64_t) ReadU32(sample + 4) << 32));
+            decoded.question = (uint16_t) (sample[8] | (sample[9] << 8));
+            decoded.answer = (int8_t) sample[10];
+            decoded.correct = sample[11] != 0;
+            decoded.latencyMs = ReadU32(sample + 12);
+            decoded.ability = ReadFloat(sample + 16);
+            samples.push_back(decoded);
+        }
+        offset += TELEMETRY_FRAME_SIZE + length;
+    }
+    return skipped;
+}
+
+QuestionTelemetry::QuestionTelemetry(size_t questionCount)
+    : questionCount(questionCount), difficulties(new std::atomic<float>[questionCount]),
+      estimates(questionCount, QuestionEstimate{0.0f, 0, 0, 0, {0, 0, 0, 0}, 0}), writer(nullptr), running(false), dropped(0) {
+    for (size_t i = 0; i < questionCount; i++) difficulties[i].store(0.0f, std::memory_order_relaxed);
+}
+
+QuestionTelemetry::~QuestionTelemetry() {
+    Stop();
+}
+
+bool QuestionTelemetry::Load(const std::string& path) {
+    std::vector<uint8_t> data;
+    std::vector<QuestionEstimate> loaded;
+    if (!ReadWholeFile(path, data) || !ParseEstimates(data.data(), data.size(), loaded)) return false;
+    if (loaded.size() != questionCount) {
+        printf("TELEMETRY: %s has %i questions, the game has %i, starting over\n", path.c_str(), (int) loaded.size(), (int) questionCount);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(estimatesMutex);
+    estimates = loaded;
+    for (size_t i = 0; i < questionCount; i++) difficulties[i].store(estimates[i].difficulty, std::memory_order_relaxed);
+    return true;
+}
+
+void QuestionTelemetry::Start(PersistenceWriter* persistence) {
+    if (running) return;
+    writer = persistence;
+    running = true;
+    thread = std::thread(&QuestionTelemetry::Run, this);
+}
+
+void QuestionTelemetry::Stop() {
+    if (running) {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            running = false;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+    Flush();
+}
+
+bool QuestionTelemetry::Record(const AnswerSample& sample) {
+    if (sample.question >= questionCount || !ring.Push(sample)) {
+        dropped.fetch_add(1);
+        return false;
+    }
+    return true;
+}
+
+float QuestionTelemetry::GetDifficulty(int question) const {
+    if (question < 0 || (size_t) question >= questionCount) return 0.0f;
+    return difficulties[question].load(std::memory_order_relaxed);
+}
+
+std::vector<QuestionEstimate> QuestionTelemetry::GetEstimates() const {
+    std::lock_guard<std::mutex> lock(estimatesMutex);
+    return estimates;
+}
+
+size_t QuestionTelemetry::PopBatch(AnswerSample* samples, size_t maxCount) {
+    size_t count = 0;
+    while (count < maxCount && ring.Pop(samples[count])) count++;
+    return count;
+}
+
+void QuestionTelemetry::Flush() {
+    AnswerSample batch[TELEMETRY_BATCH_SIZE];
+    std::vector<uint8_t> appended;
+    size_t count;
+    while ((count = PopBatch(batch, TELEMETRY_BATCH_SIZE)) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(estimatesMutex);
+            for (size_t i = 0; i < count; i++) {
+                QuestionEstimate& estimate = estimates[batch[i].question];
+                UpdateEstimate(estimate, batch[i]);
+                difficulties[batch[i].question].store(estimate.difficulty, std::memory_order_relaxed);
+            }
+        }
+        std::vector<uint8_t> encoded = EncodeTelemetryBatch(batch, count);
+        appended.insert(appended.end(), encoded.begin(), encoded.end());
+    }
+    if (appended.empty() || !writer) return;
+
+    writer->Append(TELEMETRY_FILE_PATH, std::move(appended));
+    writer->Write(DIFFICULTY_FILE_PATH, EncodeEstimates(GetEstimates()));    // Snapshots coalesce in the writer
+}
+
+void QuestionTelemetry::Run() {
+    auto lastFlush = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running) {
+        wake.wait_for(lock, std::chrono::milliseconds(TELEMETRY_POLL_MS));
+        auto now = std::chrono::steady_clock::now();
+        if (ring.GetSize() < TELEMETRY_BATCH_SIZE && now - lastFlush < std::chrono::milliseconds(TELEMETRY_FLUSH_MS)) continue;
+
+        lock.unlock();
+        Flush();
+        lock.lock();
+        lastFlush = now;
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "input_queue.hpp"
+#include "persistence.hpp"
+
+// Per-question answer telemetry and online difficulty estimates.
+//
+// Difficulty follows the Rasch model from item response theory: a player with ability `a` answers a question of
+// difficulty `d` correctly with probability 1 / (1 + e^(d - a)), both in logits, 0 being an average player or
+// question. Every answer moves the question's difficulty and the player's ability Elo-style by the surprise
+// (actual - expected), with steps that shrink as a question collects answers.
+//
+// The game thread records samples into a lock-free ring (SpscQueue) and never waits. A flusher thread drains it in
+// batches, updates the estimates and appends the samples to the telemetry log:
+//   "BBQT" | u32 payload length | u32 CRC-32 | payload: u8 version, u32 count, 20 byte samples
+// The estimates are saved as one snapshot: "BBQD", u32 version, u32 question count, then 40 bytes per question.
+#define TELEMETRY_FILE_PATH "data/question-telemetry.bin"
+#define DIFFICULTY_FILE_PATH "data/question-difficulty.bin"
+#define TELEMETRY_RING_SIZE 1024       // Samples, a power of two
+#define TELEMETRY_BATCH_SIZE 64        // The flusher drains as soon as this many samples are waiting,
+#define TELEMETRY_FLUSH_MS 2000        // or whatever arrived once this long passed
+#define TELEMETRY_POLL_MS 100          // How often the flusher looks, so Record() never has to signal it
+#define TELEMETRY_NO_ANSWER -1         // Answer of a timed out question
+
+struct AnswerSample {
+    int64_t timestamp;      // Unix seconds
+    uint16_t question;
+    int8_t answer;          // 0-3 or TELEMETRY_NO_ANSWER
+    bool correct;
+    uint32_t latencyMs;     // From the question appearing to the press
+    float ability;          // The player's ability estimate when answering
+};
+
+struct QuestionEstimate {
+    float difficulty;       // Logits, harder questions are higher
+    uint32_t attempts;
+    uint32_t correct;
+    uint32_t timeouts;
+    uint32_t choices[4];    // How often each option was picked
+    uint64_t totalLatencyMs;    // Over answered attempts
+};
+
+// Probability that a player of `ability` answers a question of `difficulty` correctly
+float ExpectedCorrect(float ability, float difficulty);
+
+// Moves the question's estimate towards the sample's outcome
+void UpdateEstimate(QuestionEstimate& estimate, const AnswerSample& sample);
+
+// The player's ability after an answer. `answered` is how many answers the estimate is already based on, early
+// answers move it further.
+float UpdateAbility(float ability, float difficulty, bool correct, int answered);
+
+std::vector<uint8_t> EncodeEstimates(const std::vector<QuestionEstimate>& estimates);
+bool ParseEstimates(const uint8_t* data, size_t size, std::vector<QuestionEstimate>& estimates);
+
+std::vector<uint8_t> EncodeTelemetryBatch(const AnswerSample* samples, size_t count);
+
+// Every sample of every intact batch in the log, corrupt batches are skipped. Returns the bytes skipped.
+size_t ParseTelemetryLog(const uint8_t* data, size_t size, std::vector<AnswerSample>& samples);
+
+class QuestionTelemetry {
+    public:
+        explicit QuestionTelemetry(size_t questionCount);
+        ~QuestionTelemetry();
+
+        // Loads saved estimates. They are dropped when the file was made for a different question count, because
+        // question ids are positions in the question list.
+        bool Load(const std::string& path);
+
+        // Starts the flusher thread. Without it, Flush() drains on the calling thread.
+        void Start(PersistenceWriter* writer);
+        void Stop();    // Drains the ring, saves the estimates and joins the thread
+
+        // Game thread, never blocks. False when the ring is full and the sample was dropped.
+        bool Record(const AnswerSample& sample);
+
+        // Lock-free, may lag the latest answers by one flush
+        float GetDifficulty(int question) const;
+
+        std::vector<QuestionEstimate> GetEstimates() const;
+        int GetDroppedCount() const { return dropped.load(); }
+
+        void Flush();    // Only while the flusher thread is not running, it is the ring's one consumer
+
+    private:
+        void Run();
+        size_t PopBatch(AnswerSample* samples, size_t maxCount);    // The ring's consumer side
+
+        size_t questionCount;
+        SpscQueue<AnswerSample, TELEMETRY_RING_SIZE> ring;     // Record() is the one producer
+        std::unique_ptr<std::atomic<float>[]> difficulties;    // Published copy of estimates[i].difficulty
+        std::vector<QuestionEstimate> estimates;               // Flusher only, or under estimatesMutex for snapshots
+        mutable std::mutex estimatesMutex;
+        PersistenceWriter* writer;
+        std::thread thread;
+        std::mutex wakeMutex;    // Only the flusher and Stop() use it, recording stays lock-free
+        std::condition_variable wake;
+        bool running;
+        std::atomic<int> dropped;
+};
@@ -1,6 +1,7 @@
 #include "questions.hpp"
 
-std::vector<Question> questions = {
+// One table per subject, in the order of QuestionCategory
+static const Question scienceQuestions[] = {
     // Science Questions
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     {"What is the basic unit of life?", {"Cell", "Tissue", "Organ", "Organism"}, 0},
@@ -254,7 +255,9 @@ std::vector<Question> questions = {
     {"What is the term for the measure of the amount of energy released during an earthquake?", {"Magnitude", "Intensity", "Frequency", "Amplitude"}, 0},
     {"What is the term for the increase in Earth's average temperature due to human activity?", {"Global warming", "Greenhouse effect", "Ozone depletion", "Acid rain"}, 0},
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+};
 
+static const Question itQuestions[] = {
     // IT Questions
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     {"What does 'HTTP' stand for?", {"Hypertext Transfer Protocol", "Hypertext Transmission Protocol", "HyperTerminal Text Protocol", "Hyper Transfer Text Protocol"}, 0},
@@ -502,7 +505,9 @@ std::vector<Question> questions = {
     {"What is the use of the 'try' block?", {"To handle exceptions in a program", "To define a function", "To declare variables", "To start a loop"}, 0},
     {"What does the term 'iteration' refer to in programming?", {"Repeating a block of code multiple times", "Defining a function", "Declaring a variable", "Handling errors"}, 0},
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+};
 
+static const Question historyQuestions[] = {
     // History Questions
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         {"When did the construction of the Great Wall of China begin?", {"Paris", "London", "Berlin", "Madrid"}, 1},
@@ -755,8 +760,9 @@ std::vector<Question> questions = {
     {"The Rosetta Stone, which helped scholars understand ancient Egyptian writing, was discovered in which year?", {"1799", "1805", "1822", "1871"}, 0},
 
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+};
 
-
+static const Question mathQuestions[] = {
     // Math Questions
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     {"What is 2 + 3?", {"5", "6", "4", "7"}, 0},
@@ -1030,7 +1036,9 @@ std::vector<Question> questions = {
     {"What is the sum of 18 and 28?", {"46", "47", "45", "44"}, 0},
     {"What is the formula for the area of a parallelogram?", {"A = b * h", "A = 2b * h", "A = b + h", "A = b * 2h"}, 2},
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+};
 
+static const Question englishQuestions[] = {
     // English Questions
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     {"What is the synonym of 'happy'?", {"sad", "joyful", "angry", "calm"}, 1},
@@ -1287,6 +1295,31 @@ std::vector<Question> questions = {
     //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 };
 
+#define SECTION(questions) {questions, (int) (sizeof(questions) / sizeof(questions[0]))}
+
+// The bank is the sections back to back, so a question's subject follows from the section sizes
+static const struct {
+    const Question* questions;
+    int count;
+} sections[CATEGORY_COUNT] = {
+    SECTION(scienceQuestions), SECTION(itQuestions), SECTION(historyQuestions), SECTION(mathQuestions), SECTION(englishQuestions)
+};
+
 std::vector<Question> GetQuestionsVector(void) {
+    std::vector<Question> questions;
+    for (int category = 0; category < CATEGORY_COUNT; category++) {
+        questions.insert(questions.end(), sections[category].questions, sections[category].questions + sections[category].count);
+    }
     return questions;
 }
+
+QuestionCategory GetQuestionCategory(int questionIndex) {
+    int category = 0;
+    while (category < CATEGORY_COUNT - 1 && questionIndex >= sections[category].count) questionIndex -= sections[category++].count;
+    return (QuestionCategory) category;
+}
+
+const char* GetQuestionCategoryName(QuestionCategory category) {
+    static const char* names[CATEGORY_COUNT] = {"Science", "IT", "History", "Math", "English"};
+    return (category >= 0 && category < CATEGORY_COUNT) ? names[category] : "Unknown";
+}
@@ -8,4 +8,17 @@ struct Question {
     int correctAnswerIndex;
 };
 
-std::vector<Question> GetQuestionsVector();
\ No newline at end of file
+// Subjects in the order their sections appear in the question table
+enum QuestionCategory {
+    CATEGORY_SCIENCE = 0,
+    CATEGORY_IT,
+    CATEGORY_HISTORY,
+    CATEGORY_MATH,
+    CATEGORY_ENGLISH,
+    CATEGORY_COUNT
+};
+
+std::vector<Question> GetQuestionsVector();
+
+QuestionCategory GetQuestionCategory(int questionIndex);
+const char* GetQuestionCategoryName(QuestionCategory category);
\ No newline at end of file
@@ -0,0 +1,379 @@
+#include "quiz_host.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <unistd.h>
+    #define QUIZ_USE_EPOLL
+#elif defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #define poll WSAPoll
+#else
+    #include <poll.h>
+#endif
+
+#define LISTENER_SLOT 0xFFFFFFFFu
+#define MAX_EVENTS 256
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Questions travel on one line with tab separated fields
+static int AppendField(char* buffer, int size, int capacity, const char* text) {
+    for (const char* c = text; *c && size < capacity - 2; c++) {
+        buffer[size++] = (*c == '\t' || *c == '\n' || *c == '\r') ? ' ' : *c;
+    }
+    return size;
+}
+
+QuizHost::QuizHost() : listener(INVALID_NET_SOCKET), eventHandle(-1), frameSize(0), roundStartNs(0), roundOpen(false), openCorrectIndex(-1), running(false) {
+    memset(&results, 0, sizeof(results));
+    results.correctAnswerIndex = -1;
+}
+
+QuizHost::~QuizHost() {
+    Stop();
+}
+
+bool QuizHost::Start(uint16_t port, int maxClients) {
+    listener = NetListen(port, 128);
+    if (listener == INVALID_NET_SOCKET) {
+        fprintf(stderr, "QUIZ: Failed to listen on port %u\n", port);
+        return false;
+    }
+
+    slots.assign(maxClients, QuizClient());
+    freeSlots.clear();
+    freeSlots.reserve(maxClients);
+    activeSlots.clear();
+    activeSlots.reserve(maxClients);
+    for (int i = maxClients - 1; i >= 0; i--) {
+        slots[i].socket = INVALID_NET_SOCKET;
+        freeSlots.push_back(i);
+    }
+
+#ifdef QUIZ_USE_EPOLL
+    eventHandle = epoll_create1(0);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u32 = LISTENER_SLOT;
+    epoll_ctl(eventHandle, EPOLL_CTL_ADD, (int) listener, &event);
+#endif
+
+    printf("QUIZ: Hosting on port %u for up to %i clients\n", port, maxClients);
+    return true;
+}
+
+void QuizHost::RunInBackground() {
+    running = true;
+    thread = std::thread([this]() {
+        while (running) Update(10);
+    });
+}
+
+void QuizHost::Stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!activeSlots.empty()) DropClient(activeSlots.back());
+    NetClose(listener);
+    listener = INVALID_NET_SOCKET;
+#ifdef QUIZ_USE_EPOLL
+    if (eventHandle != -1) close(eventHandle);
+    eventHandle = -1;
+#endif
+}
+
+void QuizHost::WatchWrites(int slot, bool enabled) {
+    QuizClient& client = slots[slot];
+    if (client.waitingForWrite == enabled) return;
+    client.waitingForWrite = enabled;
+#ifdef QUIZ_USE_EPOLL
+    epoll_event event;
+    event.events = EPOLLIN | (enabled ? EPOLLOUT : 0);
+    event.data.u32 = (uint32_t) slot;
+    epoll_ctl(eventHandle, EPOLL_CTL_MOD, (int) client.socket, &event);
+#endif
+}
+
+void QuizHost::AcceptClients(void) {
+    while (true) {
+        NetSocket socket = NetAccept(listener);
+        if (socket == INVALID_NET_SOCKET) return;
+        if (freeSlots.empty()) {
+            NetClose(socket);
+            continue;
+        }
+
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        QuizClient& client = slots[slot];
+        client.socket = socket;
+        client.activeIndex = (int) activeSlots.size();
+        snprintf(client.name, sizeof(client.name), "Client %i", slot + 1);
+        client.inboundSize = 0;
+        client.outboundSize = 0;
+        client.answeredRound = 0;
+        client.waitingForWrite = false;
+        activeSlots.push_back(slot);
+
+#ifdef QUIZ_USE_EPOLL
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = (uint32_t) slot;
+        epoll_ctl(eventHandle, EPOLL_CTL_ADD, (int) socket, &event);
+#endif
+
+        // Late joiners get the question that is currently open
+        if (roundOpen) SendToClient(slot, frame, frameSize);
+    }
+}
+
+void QuizHost::DropClient(int slot) {
+    QuizClient& client = slots[slot];
+    if (client.socket == INVALID_NET_SOCKET) return;
+
+#ifdef QUIZ_USE_EPOLL
+    epoll_ctl(eventHandle, EPOLL_CTL_DEL, (int) client.socket, nullptr);
+#endif
+    NetClose(client.socket);
+    client.socket = INVALID_NET_SOCKET;
+
+    // Swap-remove from the dense active list
+    int last = activeSlots.back();
+    activeSlots[client.activeIndex] = last;
+    slots[last].activeIndex = client.activeIndex;
+    activeSlots.pop_back();
+    freeSlots.push_back(slot);
+}
+
+void QuizHost::SendToClient(int slot, const char* data, int size) {
+    QuizClient& client = slots[slot];
+    if (client.socket == INVALID_NET_SOCKET) return;
+
+    // Try the socket first, only what it can't take right now is buffered
+    int sent = 0;
+    if (client.outboundSize == 0) {
+        sent = NetSend(client.socket, (const uint8_t*) data, size);
+        if (sent < 0) {
+            DropClient(slot);
+            return;
+        }
+    }
+    if (sent == size) return;
+
+    // A client that can't keep up with a few lines is too slow for a live quiz
+    if (client.outboundSize + (size - sent) > QUIZ_OUTBOUND_SIZE) {
+        DropClient(slot);
+        return;
+    }
+    memcpy(client.outbound + client.outboundSize, data + sent, size - sent);
+    client.outboundSize += size - sent;
+    WatchWrites(slot, true);
+}
+
+void QuizHost::WriteClient(int slot) {
+    QuizClient& client = slots[slot];
+    if (client.outboundSize == 0) return;
+
+    int sent = NetSend(client.socket, (const uint8_t*) client.outbound, client.outboundSize);
+    if (sent < 0) {
+        DropClient(slot);
+        return;
+    }
+    memmove(client.outbound, client.outbound + sent, client.outboundSize - sent);
+    client.outboundSize -= sent;
+    if (client.outboundSize == 0) WatchWrites(slot, false);
+}
+
+void QuizHost::ReadClient(int slot) {
+    QuizClient& client = slots[slot];
+
+    while (client.socket != INVALID_NET_SOCKET) {
+        int received = NetReceive(client.socket, (uint8_t*) client.inbound + client.inboundSize, QUIZ_LINE_SIZE - 1 - client.inboundSize);
+        if (received < 0) {
+            DropClient(slot);
+            return;
+        }
+        if (received == 0) return;
+        client.inboundSize += received;
+
+        // Handle every complete line, keep the partial tail for the next read
+        int lineStart = 0;
+        for (int i = 0; i < client.inboundSize; i++) {
+            if (client.inbound[i] != '\n') continue;
+            client.inbound[i] = '\0';
+            if (i > lineStart && client.inbound[i - 1] == '\r') client.inbound[i - 1] = '\0';
+            HandleLine(slot, client.inbound + lineStart);
+            if (client.socket == INVALID_NET_SOCKET) return;
+            lineStart = i + 1;
+        }
+        memmove(client.inbound, client.inbound + lineStart, client.inboundSize - lineStart);
+        client.inboundSize -= lineStart;
+
+        // A line longer than the buffer is not something our clients send
+        if (client.inboundSize >= QUIZ_LINE_SIZE - 1) {
+            DropClient(slot);
+            return;
+        }
+    }
+}
+
+void QuizHost::HandleLine(int slot, char* line) {
+    QuizClient& client = slots[slot];
+    uint64_t nowNs = NowNs();
+
+    if (strncmp(line, "HELLO ", 6) == 0) {
+        snprintf(client.name, sizeof(client.name), "%s", line + 6);
+    }
+    else if (strncmp(line, "ANSWER ", 7) == 0) {
+        char* end = nullptr;
+        uint32_t round = (uint32_t) strtoul(line + 7, &end, 10);
+        int choice = (int) strtol(end, nullptr, 10) - 1;
+        if (!roundOpen || round != results.round || choice < 0 || choice > 3 || client.answeredRound == round) return;
+
+        client.answeredRound = round;
+        uint64_t responseNs = nowNs - roundStartNs;
+        results.answered++;
+        results.counts[choice]++;
+        results.totalResponseNs += responseNs;
+
+        char ack[48];
+        int size = snprintf(ack, sizeof(ack), "ACK %u %llu\n", round, (unsigned long long) (responseNs / 1000000ULL));
+        SendToClient(slot, ack, size);
+
+        // Answers are handled in arrival order, so the first correct one is the fastest
+        if (choice == openCorrectIndex && results.fastestCorrectName[0] == '\0') {
+            results.fastestCorrectNs = responseNs;
+            snprintf(results.fastestCorrectName, sizeof(results.fastestCorrectName), "%s", client.name);
+        }
+    }
+}
+
+int QuizHost::Update(int timeoutMs) {
+    if (listener == INVALID_NET_SOCKET) return 0;
+
+#ifdef QUIZ_USE_EPOLL
+    epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(eventHandle, events, MAX_EVENTS, timeoutMs);
+    if (count <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < count; i++) {
+        uint32_t slot = events[i].data.u32;
+        if (slot == LISTENER_SLOT) {
+            AcceptClients();
+            continue;
+        }
+        if (slots[slot].socket == INVALID_NET_SOCKET) continue;    // Dropped earlier in this batch
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            DropClient((int) slot);
+            continue;
+        }
+        if (events[i].events & EPOLLOUT) WriteClient((int) slot);
+        if (events[i].events & EPOLLIN) ReadClient((int) slot);
+    }
+    return count;
+#else
+    // Portable fallback: rebuild the poll set from the active slots every call
+    std::vector<pollfd> descriptors;
+    std::vector<int> descriptorSlots;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pollfd descriptor;
+        descriptor.fd = (decltype(descriptor.fd)) listener;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        descriptors.push_back(descriptor);
+        descriptorSlots.push_back(-1);
+        for (int slot : activeSlots) {
+            descriptor.fd = (decltype(descriptor.fd)) slots[slot].socket;
+            descriptor.events = (short) (POLLIN | (slots[slot].waitingForWrite ? POLLOUT : 0));
+            descriptors.push_back(descriptor);
+            descriptorSlots.push_back(slot);
+        }
+    }
+
+    int count = poll(descriptors.data(), (unsigned) descriptors.size(), timeoutMs);
+    if (count <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < descriptors.size(); i++) {
+        int slot = descriptorSlots[i];
+        short events = descriptors[i].revents;
+        if (events == 0) continue;
+        if (slot == -1) {
+            AcceptClients();
+            continue;
+        }
+        if (slots[slot].socket != (NetSocket) descriptors[i].fd) continue;    // Dropped earlier in this batch
+        if (events & (POLLERR | POLLHUP)) {
+            DropClient(slot);
+            continue;
+        }
+        if (events & POLLOUT) WriteClient(slot);
+        if (events & POLLIN) ReadClient(slot);
+    }
+    return count;
+#endif
+}
+
+uint64_t QuizHost::BroadcastQuestion(const Question& question, int seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t round = results.round + 1;
+    memset(&results, 0, sizeof(results));
+    results.round = round;
+    results.correctAnswerIndex = -1;
+    openCorrectIndex = question.correctAnswerIndex;
+
+    // Format the frame once, every client gets the same bytes
+    // The fields stop short of the end, so the four tabs and the newline after them always fit
+    int fieldCapacity = (int) sizeof(frame) - 5;
+    frameSize = std::min(snprintf(frame, sizeof(frame), "QUESTION %u %i\t", round, seconds), fieldCapacity);
+    frameSize = AppendField(frame, frameSize, fieldCapacity, question.questionText.c_str());
+    for (size_t i = 0; i < question.answers.size() && i < 4; i++) {
+        if (frameSize >= (int) sizeof(frame) - 1) break;
+        frame[frameSize++] = '\t';
+        frameSize = AppendField(frame, frameSize, fieldCapacity, question.answers[i].c_str());
+    }
+    if (frameSize < (int) sizeof(frame)) frame[frameSize++] = '\n';
+
+    roundOpen = true;
+    roundStartNs = NowNs();
+
+    // Walk backwards so a client dropped mid-loop doesn't make us skip the one swapped into its place
+    for (int i = (int) activeSlots.size() - 1; i >= 0; i--) SendToClient(activeSlots[i], frame, frameSize);
+    return NowNs() - roundStartNs;
+}
+
+void QuizHost::BroadcastResults(int correctAnswerIndex) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    roundOpen = false;
+    results.correctAnswerIndex = correctAnswerIndex;
+
+    char line[96];
+    int size = snprintf(line, sizeof(line), "RESULT %u %i %i %i %i %i\n", results.round, correctAnswerIndex + 1,
+                        results.counts[0], results.counts[1], results.counts[2], results.counts[3]);
+    for (int i = (int) activeSlots.size() - 1; i >= 0; i--) SendToClient(activeSlots[i], line, size);
+}
+
+QuizResults QuizHost::GetResults() {
+    std::lock_guard<std::mutex> lock(mutex);
+    results.clientCount = (int) activeSlots.size();
+    return results;
+}
+
+int QuizHost::GetClientCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int) activeSlots.size();
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "net.hpp"
+#include "questions.hpp"
+
+// Classroom quiz host: one Brain Bloom screen broadcasts questions to many answer clients over a line-based
+// TCP protocol and aggregates their answers live.
+//
+//   client -> host   HELLO <name>
+//                    ANSWER <round> <1-4>
+//   host -> client   QUESTION <round> <seconds>\t<question>\t<answer 1>\t<answer 2>\t<answer 3>\t<answer 4>
+//                    ACK <round> <milliseconds since the question was sent>
+//                    RESULT <round> <correct 1-4> <count 1> <count 2> <count 3> <count 4>
+//
+// Every buffer is sized up front: client slots, their line buffers and the broadcast frame are allocated once
+// in Start(), so a round with hundreds of clients doesn't touch the heap.
+#define QUIZ_DEFAULT_PORT 47400
+#define QUIZ_MAX_CLIENTS 1024
+#define QUIZ_NAME_SIZE 24
+#define QUIZ_LINE_SIZE 128
+#define QUIZ_OUTBOUND_SIZE 2048
+
+struct QuizResults {
+    uint32_t round;
+    int clientCount;
+    int answered;
+    int counts[4];
+    int correctAnswerIndex;            // -1 until the round is revealed
+    uint64_t totalResponseNs;
+    uint64_t fastestCorrectNs;         // Only meaningful once revealed and someone was correct
+    char fastestCorrectName[QUIZ_NAME_SIZE];
+};
+
+class QuizHost {
+    public:
+        QuizHost();
+        ~QuizHost();
+
+        bool Start(uint16_t port, int maxClients);
+        void RunInBackground();            // Handles the sockets on its own thread so answers are stamped on arrival
+        void Stop();
+
+        // Waits up to timeoutMs for socket events and handles them. Only call this yourself when not running in the background.
+        int Update(int timeoutMs);
+
+        // Starts a new round and sends the question to every connected client. Returns the time the fan-out took.
+        uint64_t BroadcastQuestion(const Question& question, int seconds);
+        // Ends the round and sends the per-choice counts to every client
+        void BroadcastResults(int correctAnswerIndex);
+
+        QuizResults GetResults();
+        int GetClientCount();
+
+    private:
+        struct QuizClient {
+            NetSocket socket;              // INVALID_NET_SOCKET while the slot is free
+            int activeIndex;               // Position in activeSlots
+            char name[QUIZ_NAME_SIZE];
+            char inbound[QUIZ_LINE_SIZE];
+            int inboundSize;
+            char outbound[QUIZ_OUTBOUND_SIZE];
+            int outboundSize;
+            uint32_t answeredRound;
+            bool waitingForWrite;
+        };
+
+        void AcceptClients(void);
+        void ReadClient(int slot);
+        void WriteClient(int slot);
+        void HandleLine(int slot, char* line);
+        void SendToClient(int slot, const char* data, int size);
+        void DropClient(int slot);
+        void WatchWrites(int slot, bool enabled);
+
+        NetSocket listener;
+        int eventHandle;                   // epoll instance on Linux, unused by the poll() fallback
+        std::vector<QuizClient> slots;
+        std::vector<int> freeSlots;
+        std::vector<int> activeSlots;      // Dense list of connected slots, fan-out only walks these
+        char frame[QUIZ_OUTBOUND_SIZE];
+        int frameSize;
+
+        QuizResults results;
+        uint64_t roundStartNs;
+        bool roundOpen;
+        int openCorrectIndex;              // Kept to itself until the reveal
+
+        std::mutex mutex;
+        std::thread thread;
+        std::atomic<bool> running;
+};
@@ -0,0 +1,209 @@
+#include "replay.hpp"
+#include <cstring>
+#include <fstream>
+#include "math_generator.hpp"
+
+static void WriteVarint(std::vector<uint8_t>& data, uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back((uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((uint8_t) value);
+}
+
+static uint64_t ZigzagEncode(int64_t value) {
+    return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+static int64_t ZigzagDecode(uint64_t value) {
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+ReplayRecorder::ReplayRecorder() : startNs(0), lastNs(0), recording(false) {}
+
+void ReplayRecorder::Begin(ReplayMode mode, uint64_t seed, const std::vector<Player>& players, uint64_t nowNs) {
+    const char magic[] = REPLAY_MAGIC;
+    data.assign(magic, magic + 4);
+    data.push_back(REPLAY_VERSION);
+    data.reserve(4096);
+
+    startNs = nowNs;
+    lastNs = nowNs;
+    recording = true;
+
+    Record(REPLAY_SESSION, 0, mode | ((int64_t) players.size() << 1), nowNs);
+    Record(REPLAY_SEED, 0, (int64_t) seed, nowNs);
+    for (int i = 0; i < (int) players.size(); i++) {
+        Record(REPLAY_PLAYER_NAME, i, (int64_t) players[i].name.size(), nowNs);
+        data.insert(data.end(), players[i].name.begin(), players[i].name.end());
+    }
+}
+
+void ReplayRecorder::Record(ReplayEventType type, int player, int64_t value, uint64_t timeNs) {
+    if (!recording) return;
+
+    // Inputs are stamped when they happened, which can be a little before the last frame-stamped event
+    data.push_back((uint8_t) ((type << 4) | (player & 0x0F)));
+    WriteVarint(data, ZigzagEncode((int64_t) (timeNs - lastNs)));
+    WriteVarint(data, (type == REPLAY_SEED) ? (uint64_t) value : ZigzagEncode(value));
+    lastNs = timeNs;
+}
+
+void ReplayRecorder::End(const std::vector<Player>& players, uint64_t nowNs) {
+    for (int i = 0; i < (int) players.size(); i++) {
+        Record(REPLAY_FINAL_SCORE, i, players[i].score, nowNs);
+        Record(REPLAY_FINAL_HEALTH, i, players[i].healthPoints, nowNs);
+    }
+    recording = false;
+}
+
+bool ReplayRecorder::Save(const char* fileName) const {
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return file.good();
+}
+
+bool LoadReplayFile(const char* fileName, std::vector<uint8_t>& data) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+ReplayReader::ReplayReader(const std::vector<uint8_t>& data) : data(data), position(5), timeNs(0) {
+    valid = data.size() >= 5 && memcmp(data.data(), REPLAY_MAGIC, 4) == 0 && data[4] == REPLAY_VERSION;
+}
+
+bool ReplayReader::ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= data.size()) return false;
+        uint8_t byte = data[position++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool ReplayReader::Next(ReplayEvent& event) {
+    if (!valid || position >= data.size()) return false;
+
+    uint8_t header = data[position++];
+    uint64_t delta, value;
+    if (!ReadVarint(delta) || !ReadVarint(value) || (header >> 4) >= REPLAY_EVENT_COUNT) {
+        valid = false;
+        return false;
+    }
+
+    timeNs += ZigzagDecode(delta);
+    event.type = (ReplayEventType) (header >> 4);
+    event.player = header & 0x0F;
+    event.value = (event.type == REPLAY_SEED) ? (int64_t) value : ZigzagDecode(value);
+    event.timeNs = timeNs;
+    event.text.clear();
+
+    if (event.type == REPLAY_PLAYER_NAME) {
+        if (event.value < 0 || position + event.value > data.size()) {
+            valid = false;
+            return false;
+        }
+        event.text.assign(data.begin() + position, data.begin() + position + event.value);
+        position += event.value;
+    }
+    return true;
+}
+
+ReplayOutcome PlayReplay(const std::vector<uint8_t>& data, const std::vector<Question>& questions,
+                         const std::function<void(const ReplayEvent&, const ReplayOutcome&)>& onEvent) {
+    ReplayOutcome outcome{REPLAY_SINGLEPLAYER, 0, {}, 0, 0, 0, false, true};
+    ReplayReader reader(data);
+    ReplayEvent event;
+
+    const Question* question = nullptr;
+    Question generated;    // Holds the current question when it was generated
+    bool bonusHealth = false;    // Ability D: one extra health point if the round ends well
+    bool answeredCorrectly = false;
+    int finalStates = 0;
+
+    while (reader.Next(event)) {
+        if (onEvent) onEvent(event, outcome);
+        outcome.events++;
+        outcome.durationNs = event.timeNs;
+
+        bool hasPlayer = event.player < (int) outcome.players.size();
+        switch (event.type) {
+            case REPLAY_SESSION:
+                outcome.mode = (ReplayMode) (event.value & 1);
+                ResetPlayers(outcome.players, (int) (event.value >> 1));
+                // Singleplayer is one player; ResetPlayers keeps at least MIN_PLAYERS
+                if (outcome.mode == REPLAY_SINGLEPLAYER) outcome.players.resize(1);
+                break;
+            case REPLAY_SEED:
+                outcome.seed = (uint64_t) event.value;
+                break;
+            case REPLAY_PLAYER_NAME:
+                if (hasPlayer) outcome.players[event.player].name = event.text;
+                break;
+            case REPLAY_QUESTION:
+                question = ResolveQuestion(questions, event.value, generated);
+                if (!question) question = &questions[0];
+                ResetPlayerAnswers(outcome.players);
+                answeredCorrectly = false;
+                break;
+            case REPLAY_ANSWER: {
+                if (!hasPlayer) break;
+                Player& player = outcome.players[event.player];
+                if (outcome.mode == REPLAY_SINGLEPLAYER) {
+                    // Singleplayer scores the moment an answer is picked
+                    answeredCorrectly = question && event.value == question->correctAnswerIndex;
+                    if (answeredCorrectly) player.score++;
+                    else {
+                        player.healthPoints--;
+                        bonusHealth = false;
+                    }
+                } else if (!player.selected) {
+                    player.answer = (int) event.value;
+                    player.selected = true;
+                    player.answerTimeNs = event.timeNs;
+                }
+                break;
+            }
+            case REPLAY_ABILITY:
+                if (event.value == 2) bonusHealth = true;
+                break;
+            case REPLAY_ROUND_END:
+                outcome.rounds++;
+                if (outcome.mode == REPLAY_SINGLEPLAYER && hasPlayer) {
+                    Player& player = outcome.players[event.player];
+                    if (event.value == ROUND_END_TIMEOUT) player.healthPoints--;
+                    else {
+                        if (event.value == ROUND_END_SKIPPED) player.score++;
+                        if (bonusHealth && (answeredCorrectly || event.value == ROUND_END_SKIPPED)) player.healthPoints++;
+                    }
+                    bonusHealth = false;
+                } else if (outcome.mode == REPLAY_MULTIPLAYER) {
+                    if (event.value == ROUND_END_TIMEOUT) {
+                        for (Player& player : outcome.players) player.healthPoints--;
+                    } else {
+                        EvaluateRound(outcome.players, question ? question->correctAnswerIndex : -1);
+                    }
+                }
+                break;
+            case REPLAY_FINAL_SCORE:
+                if (hasPlayer && outcome.players[event.player].score != event.value) outcome.matchesRecording = false;
+                finalStates++;
+                break;
+            case REPLAY_FINAL_HEALTH:
+                if (hasPlayer && outcome.players[event.player].healthPoints != event.value) outcome.matchesRecording = false;
+                finalStates++;
+                break;
+            default:
+                break;
+        }
+    }
+
+    outcome.complete = reader.IsValid() && finalStates == 2 * (int) outcome.players.size() && finalStates > 0;
+    if (!outcome.complete) outcome.matchesRecording = false;
+    return outcome;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "players.hpp"
+#include "questions.hpp"
+
+// Compact session log. After a small header every event is one byte (type in the high nibble, player in the low
+// nibble), the time since the previous event as a zigzag varint in nanoseconds, and the value as a zigzag varint.
+// Random outcomes (which wrong answers an ability removed) are logged too, so a replay never depends on the RNG.
+#define REPLAY_FILE_PATH "data/last-session.bbr"
+#define REPLAY_MAGIC "BBRP"
+#define REPLAY_VERSION 1
+
+enum ReplayMode { REPLAY_SINGLEPLAYER = 0, REPLAY_MULTIPLAYER };
+
+enum ReplayEventType {
+    REPLAY_SESSION = 0,      // value: mode | playerCount << 1
+    REPLAY_SEED,             // value: the session's random seed
+    REPLAY_PLAYER_NAME,      // value: name length, followed by the raw bytes
+    REPLAY_QUESTION,         // value: question id, a bank position or a generated question, see math_generator.hpp
+    REPLAY_ANSWER,           // value: choice 0-3, time is the input timestamp
+    REPLAY_ABILITY,          // value: ability 0-3 (A, S, D, F)
+    REPLAY_REMOVED_ANSWERS,  // value: bitmask of the answers an ability removed
+    REPLAY_ROUND_END,        // value: ReplayRoundEnd
+    REPLAY_FINAL_SCORE,      // value: score the game ended with, used to verify playback
+    REPLAY_FINAL_HEALTH,     // value: health the game ended with
+    REPLAY_EVENT_COUNT
+};
+
+enum ReplayRoundEnd { ROUND_END_ANSWERED = 0, ROUND_END_TIMEOUT, ROUND_END_SKIPPED };
+
+struct ReplayEvent {
+    ReplayEventType type;
+    int player;
+    int64_t value;
+    uint64_t timeNs;       // Since the session started
+    std::string text;      // Only for REPLAY_PLAYER_NAME
+};
+
+class ReplayRecorder {
+    public:
+        ReplayRecorder();
+
+        void Begin(ReplayMode mode, uint64_t seed, const std::vector<Player>& players, uint64_t nowNs);
+        void Record(ReplayEventType type, int player, int64_t value, uint64_t timeNs);
+        void End(const std::vector<Player>& players, uint64_t nowNs);    // Logs the final state and stops recording
+        bool Save(const char* fileName) const;
+
+        bool IsRecording() const { return recording; }
+        const std::vector<uint8_t>& GetData() const { return data; }
+
+    private:
+        std::vector<uint8_t> data;
+        uint64_t startNs;
+        uint64_t lastNs;
+        bool recording;
+};
+
+class ReplayReader {
+    public:
+        explicit ReplayReader(const std::vector<uint8_t>& data);
+
+        bool IsValid() const { return valid; }
+        bool Next(ReplayEvent& event);    // False at the end or on a corrupt event
+
+    private:
+        bool ReadVarint(uint64_t& value);
+
+        const std::vector<uint8_t>& data;
+        size_t position;
+        uint64_t timeNs;
+        bool valid;
+};
+
+bool LoadReplayFile(const char* fileName, std::vector<uint8_t>& data);
+
+struct ReplayOutcome {
+    ReplayMode mode;
+    uint64_t seed;
+    std::vector<Player> players;
+    int rounds;
+    int events;
+    uint64_t durationNs;
+    bool complete;               // The log ended with its final state
+    bool matchesRecording;       // Replaying the events reproduced the recorded final state
+};
+
+// Re-applies the game rules to every event in order. `onEvent`, when given, runs before each event is applied,
+// which is where a real-time player waits for the event's timestamp.
+ReplayOutcome PlayReplay(const std::vector<uint8_t>& data, const std::vector<Question>& questions,
+                         const std::function<void(const ReplayEvent&, const ReplayOutcome&)>& onEvent);
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Append-only multiplayer score log. After an 8 byte header ("BBSW" and a version) every record is
+//   u32 payload length | u32 CRC-32 of the payload | payload: u8 type, u8 name length, name, i32 score
+// all little endian. A game over appends one record per player, so saving costs only the bytes appended. Loading
+// keeps every record whose checksum matches and drops torn or corrupt ones, and compaction rewrites the log with
+// just the live entries once enough records piled up.
+#define SCORE_LOG_MAGIC "BBSW"
+#define SCORE_LOG_VERSION 1
+#define SCORE_LOG_HEADER_SIZE 8
+#define SCORE_NAME_MAX_LENGTH 64
+
+enum ScoreRecordType { SCORE_RECORD_MULTIPLAYER = 1 };
+
+struct ScoreRecord {
+    std::string name;
+    int32_t score;
+};
+
+struct ScoreLogContents {
+    std::vector<ScoreRecord> records;    // In append order
+    bool valid;                          // The header was intact
+    size_t validBytes;                   // End of the last good record
+    size_t droppedBytes;                 // Bytes that were not part of a good record (torn tail, corruption)
+};
+
+// Never trusts a length field: every record is bounds- and checksum-checked, whatever the input
+ScoreLogContents ParseScoreLog(const uint8_t* data, size_t size);
+
+// One record ready to append to an existing log
+std::vector<uint8_t> EncodeScoreRecord(const ScoreRecord& record);
+
+// A complete log: the header followed by `records`, used for new files and compaction
+std::vector<uint8_t> EncodeScoreLog(const std::vector<ScoreRecord>& records);
+
+// Reads the pre-log leaderboard file (int count, then int name length, name, int score per entry) with every field
+// bounds-checked. Returns false when the data is not a complete legacy file; the entries read so far are kept.
+bool ParseLegacyLeaderboard(const uint8_t* data, size_t size, std::vector<ScoreRecord>& records);
+
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& data);
+
+uint32_t Crc32(const uint8_t* data, size_t size);
+
+// Little endian fields, shared by every file format of the game
+uint32_t ReadU32(const uint8_t* data);
+void AppendU32(std::vector<uint8_t>& data, uint32_t value);
+float ReadFloat(const uint8_t* data);
+void AppendFloat(std::vector<uint8_t>& data, float value);
@@ -0,0 +1,93 @@
+#include "session_random.hpp"
+#include <algorithm>
+
+static uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t SplitMix64(uint64_t& value) {
+    uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+SessionRandom::SessionRandom(uint64_t seed) {
+    Seed(seed);
+}
+
+void SessionRandom::Seed(uint64_t seed) {
+    this->seed = seed;
+    uint64_t mix = seed;
+    for (int i = 0; i < 4; i++) state[i] = SplitMix64(mix);
+}
+
+uint64_t SessionRandom::Next() {
+    uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = RotateLeft(state[3], 45);
+
+    return result;
+}
+
+uint32_t SessionRandom::NextBelow(uint32_t bound) {
+    if (bound == 0) return 0;
+
+    uint64_t product = (Next() >> 32) * bound;
+    uint32_t low = (uint32_t) product;
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = (Next() >> 32) * bound;
+            low = (uint32_t) product;
+        }
+    }
+    return (uint32_t) (product >> 32);
+}
+
+double SessionRandom::NextUnit() {
+    return (double) (Next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int SessionRandom::Range(int min, int max) {
+    if (max < min) std::swap(min, max);
+    return min + (int) NextBelow((uint32_t) (max - min) + 1);
+}
+
+int SessionRandom::RangeExcluding(int min, int max, const std::vector<int>& excluded) {
+    if (max < min) std::swap(min, max);
+
+    // Only distinct values inside the range shrink the pool
+    std::vector<int> skipped;
+    skipped.reserve(excluded.size());
+    for (int value : excluded) {
+        if (value >= min && value <= max) skipped.push_back(value);
+    }
+    std::sort(skipped.begin(), skipped.end());
+    skipped.erase(std::unique(skipped.begin(), skipped.end()), skipped.end());
+
+    int available = (max - min + 1) - (int) skipped.size();
+    if (available <= 0) return Range(min, max);
+
+    // Draw a rank among the allowed values, then step over every excluded value at or below it
+    int value = min + (int) NextBelow((uint32_t) available);
+    for (int skippedValue : skipped) {
+        if (skippedValue <= value) value++;
+        else break;
+    }
+    return value;
+}
+
+void SessionRandom::SampleInPlace(int* values, int count, int k) {
+    k = std::min(k, count);
+    for (int i = 0; i < k; i++) {
+        int j = i + (int) NextBelow((uint32_t) (count - i));
+        std::swap(values[i], values[j]);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Small seedable PRNG (xoshiro256**, seeded through splitmix64). Every session owns one and logs its seed,
+// so the same seed regenerates every question and every ability outcome of that session.
+class SessionRandom {
+    public:
+        explicit SessionRandom(uint64_t seed = 0);
+
+        void Seed(uint64_t seed);
+        uint64_t GetSeed() const { return seed; }
+
+        uint64_t Next();
+
+        // Uniform in [0, bound) without modulo bias (Lemire's multiply-shift, rejects with probability < bound / 2^32)
+        uint32_t NextBelow(uint32_t bound);
+
+        // Uniform in [0, 1) with 53 bits of precision
+        double NextUnit();
+
+        // Uniform in [min, max], inclusive like raylib's GetRandomValue
+        int Range(int min, int max);
+
+        // Uniform over [min, max] minus `excluded`, using one draw instead of retrying on a hit
+        int RangeExcluding(int min, int max, const std::vector<int>& excluded);
+
+        // Partial Fisher-Yates: afterwards the first k entries of `values` are a uniform k-of-count sample
+        void SampleInPlace(int* values, int count, int k);
+
+    private:
+        uint64_t state[4];
+        uint64_t seed;
+};
@@ -0,0 +1,202 @@
+#include "sound_bank.hpp"
+#include "asset_preload.hpp"
+
+static size_t GetStreamBytes(AudioStream stream, unsigned int frames) {
+    return (size_t) frames * stream.channels * (stream.sampleSize / 8);
+}
+
+SoundBank::~SoundBank() {
+    Unload();
+}
+
+bool SoundBank::AddVoice(Entry& entry) {
+    if (entry.data == nullptr) {
+        entry.voices.push_back(LoadSoundAlias(entry.voices[0]));
+        AttachToBus(entry.voices.back().stream, entry.bus);
+        return true;
+    }
+
+    // Small buffers, the effect is decoded a little ahead of where it plays rather than in full
+    SetAudioStreamBufferSizeDefault(SOUND_VOICE_BUFFER_FRAMES);
+    Music stream = LoadMusicStreamFromMemory(GetFileExtension(entry.fileName.c_str()), entry.data, entry.dataSize);
+    SetAudioStreamBufferSizeDefault(0);
+    if (!IsMusicReady(stream)) return false;
+    stream.looping = false;
+    AttachToBus(stream.stream, entry.bus);
+    entry.streams.push_back(stream);
+    return true;
+}
+
+SoundId SoundBank::Load(const char* fileName, MixerBus bus, int voices) {
+    if (voices < 1) voices = 1;
+
+    SoundId id;
+    auto found = ids.find(fileName);
+    if (found != ids.end()) id = found->second;
+    else {
+        Entry entry = {fileName, {}, {}, nullptr, 0, 0, bus, false};
+        if (compressNext) {
+            entry.data = LoadFileData(fileName, &entry.dataSize);
+            if (entry.data != nullptr && !AddVoice(entry)) {
+                UnloadFileData(entry.data);
+                entry.data = nullptr;
+            }
+            if (entry.data == nullptr) {
+                TraceLog(LOG_WARNING, "SOUND: Could not load %s", fileName);
+                return SOUND_NONE;
+            }
+            hasStreams = true;
+        }
+        else {
+            Sound sound = LoadPreloadedSound(fileName);
+            if (!IsSoundReady(sound)) {
+                TraceLog(LOG_WARNING, "SOUND: Could not load %s", fileName);
+                return SOUND_NONE;
+            }
+            AttachToBus(sound.stream, bus);
+            entry.voices.push_back(sound);
+        }
+        id = (SoundId) entries.size();
+        entries.push_back(entry);
+        ids[fileName] = id;
+    }
+
+    std::lock_guard<std::mutex> lock(streamMutex);
+    Entry& entry = entries[id];
+    while ((int) (entry.voices.size() + entry.streams.size()) < voices && AddVoice(entry)) {}
+    return id;
+}
+
+void SoundBank::Play(SoundId id) {
+    if (id < 0 || id >= (int) entries.size()) return;
+    Entry& entry = entries[id];
+
+    // Voices are started in order, so the first idle one from nextVoice on is also the one idle longest
+    if (entry.data == nullptr) {
+        int count = (int) entry.voices.size();
+        int voice = entry.nextVoice;
+        for (int i = 0; i < count; i++) {
+            int candidate = (entry.nextVoice + i) % count;
+            if (!IsSoundPlaying(entry.voices[candidate])) {
+                voice = candidate;
+                break;
+            }
+        }
+        PlaySound(entry.voices[voice]);
+        entry.nextVoice = (voice + 1) % count;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(streamMutex);
+    int count = (int) entry.streams.size();
+    int voice = entry.nextVoice;
+    for (int i = 0; i < count; i++) {
+        int candidate = (entry.nextVoice + i) % count;
+        if (!IsMusicStreamPlaying(entry.streams[candidate])) {
+            voice = candidate;
+            break;
+        }
+    }
+    StopMusicStream(entry.streams[voice]);    // Rewinds a voice taken over mid-effect
+    PlayMusicStream(entry.streams[voice]);
+    UpdateMusicStream(entry.streams[voice]);    // Decode the first buffers now, not on the next audio tick
+    entry.nextVoice = (voice + 1) % count;
+}
+
+void SoundBank::Stop(SoundId id) {
+    if (id < 0 || id >= (int) entries.size()) return;
+    std::lock_guard<std::mutex> lock(streamMutex);
+    for (const Sound& voice : entries[id].voices) StopSound(voice);
+    for (const Music& stream : entries[id].streams) StopMusicStream(stream);
+}
+
+bool SoundBank::IsPlaying(SoundId id) const {
+    if (id < 0 || id >= (int) entries.size()) return false;
+    std::lock_guard<std::mutex> lock(streamMutex);
+    for (const Sound& voice : entries[id].voices) {
+        if (IsSoundPlaying(voice)) return true;
+    }
+    for (const Music& stream : entries[id].streams) {
+        if (IsMusicStreamPlaying(stream)) return true;
+    }
+    return false;
+}
+
+void SoundBank::SetVolume(SoundId id, float volume) {
+    if (id < 0 || id >= (int) entries.size()) return;
+    std::lock_guard<std::mutex> lock(streamMutex);
+    for (const Sound& voice : entries[id].voices) SetSoundVolume(voice, volume);
+    for (const Music& stream : entries[id].streams) SetMusicVolume(stream, volume);
+}
+
+void SoundBank::SetDucking(SoundId id, bool ducking) {
+    if (id < 0 || id >= (int) entries.size()) return;
+    std::lock_guard<std::mutex> lock(streamMutex);
+    entries[id].ducking = ducking;
+    hasDucking = false;
+    for (const Entry& entry : entries) hasDucking = hasDucking || entry.ducking;
+}
+
+bool SoundBank::IsDuckingPlaying() const {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (!hasDucking) return false;
+    for (const Entry& entry : entries) {
+        if (!entry.ducking) continue;
+        for (const Sound& voice : entry.voices) {
+            if (IsSoundPlaying(voice)) return true;
+        }
+        for (const Music& stream : entry.streams) {
+            if (IsMusicStreamPlaying(stream)) return true;
+        }
+    }
+    return false;
+}
+
+void SoundBank::Update() {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (!hasStreams) return;
+    for (const Entry& entry : entries) {
+        for (const Music& stream : entry.streams) {
+            if (IsMusicStreamPlaying(stream)) UpdateMusicStream(stream);
+        }
+    }
+}
+
+void SoundBank::LogMemoryReport() const {
+    size_t total = 0;
+    for (const Entry& entry : entries) {
+        if (entry.data == nullptr) {
+            size_t bytes = GetStreamBytes(entry.voices[0].stream, entry.voices[0].frameCount);
+            TraceLog(LOG_INFO, "SOUND: %-40s %9zu bytes PCM, %zu voices", entry.fileName.c_str(), bytes, entry.voices.size());
+            total += bytes;
+        }
+        else {
+            size_t buffers = 0;
+            for (const Music& stream : entry.streams) buffers += GetStreamBytes(stream.stream, 2 * SOUND_VOICE_BUFFER_FRAMES);
+            TraceLog(LOG_INFO, "SOUND: %-40s %9zu bytes PCM in voice buffers, %i bytes compressed, %zu voices",
+                     entry.fileName.c_str(), buffers, entry.dataSize, entry.streams.size());
+            total += buffers + entry.dataSize;
+        }
+    }
+    TraceLog(LOG_INFO, "SOUND: %zu sounds, %zu bytes", entries.size(), total);
+}
+
+void SoundBank::Unload() {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    for (Entry& entry : entries) {
+        for (const Music& stream : entry.streams) {
+            DetachFromBus(stream.stream, entry.bus);
+            UnloadMusicStream(stream);
+        }
+        if (entry.data != nullptr) UnloadFileData(entry.data);
+
+        // Aliases first, they point into the PCM the first voice owns
+        for (const Sound& voice : entry.voices) DetachFromBus(voice.stream, entry.bus);
+        for (size_t i = entry.voices.size(); i-- > 1;) UnloadSoundAlias(entry.voices[i]);
+        if (!entry.voices.empty()) UnloadSound(entry.voices[0]);
+    }
+    entries.clear();
+    ids.clear();
+    hasStreams = false;
+    hasDucking = false;
+}
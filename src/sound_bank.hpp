@@ -0,0 +1,74 @@
+#pragma once
+#include <raylib.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mixer.hpp"
+
+// Sound effects keyed by file path, each routed through a mixer bus. Loading a path twice returns the same id, so
+// every sound is decoded and kept in memory once.
+//
+// Each sound plays through a small pool of voices: the loaded sound plus aliases (LoadSoundAlias) that share its
+// PCM. Playing picks an idle voice, or takes over the one started longest ago, so two players answering in the same
+// frame both hear their sound instead of one restarting the other.
+//
+// With compression on, sounds loaded afterwards keep only their file bytes in memory. Each voice is then a small
+// stream that decodes from those bytes while it plays; the audio thread refills it through Update(). That trades
+// a little decoding per effect for the full PCM, which matters for the long stingers on 512 MB boards.
+#define SOUND_BANK_VOICES 4                // Default voices per sound, one per player on a local keyboard
+#define SOUND_VOICE_BUFFER_FRAMES 4096     // Per sub-buffer of a compressed voice, 85 ms at 48 kHz
+
+typedef int SoundId;
+#define SOUND_NONE -1
+
+class SoundBank {
+    public:
+        SoundBank() : compressNext(false), hasStreams(false), hasDucking(false) {}
+        ~SoundBank();
+
+        // Storage of the sounds loaded after this call
+        void SetCompressed(bool compressed) { compressNext = compressed; }
+
+        // After InitAudioDevice() and before the audio thread starts. Loading a path already in the bank grows its
+        // pool to `voices` and returns its id. SOUND_NONE when the file can not be loaded.
+        SoundId Load(const char* fileName, MixerBus bus, int voices = SOUND_BANK_VOICES);
+
+        // The music bus ducks while a ducking sound plays
+        void SetDucking(SoundId id, bool ducking);
+        bool IsDuckingPlaying() const;
+
+        void Play(SoundId id);
+        void Stop(SoundId id);
+        bool IsPlaying(SoundId id) const;    // Any of its voices
+        void SetVolume(SoundId id, float volume);    // The sound's own level, the bus gain applies on top
+
+        // Refills the compressed voices that are playing, from the audio thread (see AudioEngine::AttachSounds)
+        void Update();
+
+        // Logs the memory of every sound: PCM when decoded, file bytes and voice buffers when compressed
+        void LogMemoryReport() const;
+
+        void Unload();    // Call it before CloseAudioDevice()
+
+    private:
+        struct Entry {
+            std::string fileName;
+            std::vector<Sound> voices;     // Decoded: voices[0] owns the PCM, the others are aliases of it
+            std::vector<Music> streams;    // Compressed: one decoder per voice, all reading `data`
+            unsigned char* data;
+            int dataSize;
+            int nextVoice;                 // Oldest voice, taken over when every voice is busy
+            MixerBus bus;
+            bool ducking;
+        };
+
+        bool AddVoice(Entry& entry);
+
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, SoundId> ids;
+        bool compressNext;
+        bool hasStreams;
+        bool hasDucking;
+        mutable std::mutex streamMutex;    // Compressed voices are played here and refilled on the audio thread
+};
@@ -0,0 +1,94 @@
+#include "timeline.hpp"
+#include <cmath>
+#include <utility>
+
+static uint32_t GetTicks(float seconds) {
+    if (seconds <= 0.0f) return 0;
+    return (uint32_t) std::ceil(seconds * (1000.0f / TIMELINE_TICK_MS) - 0.001f);    // 1.5 s is 150 ticks, not 151
+}
+
+Timeline::Sequence& Timeline::Sequence::Wait(float seconds) {
+    waitTicks += GetTicks(seconds);
+    return *this;
+}
+
+Timeline::Sequence& Timeline::Sequence::Then(std::function<void()> action) {
+    steps.push_back(TimelineStep{waitTicks, std::move(action)});
+    waitTicks = 0;
+    return *this;
+}
+
+TimelineTask Timeline::Sequence::Start() {
+    if (waitTicks > 0) Then(std::function<void()>());
+    return timeline.Start(steps);
+}
+
+TimelineTask Timeline::Start(std::vector<TimelineStep>& steps) {
+    if (steps.empty()) return TIMELINE_NONE;
+    if (++lastTask == TIMELINE_NONE) ++lastTask;
+    TimelineTask task = lastTask;
+
+    uint32_t ticks = steps[0].ticks;
+    tasks[task] = Task{std::move(steps), 0};
+    if (ticks > 0) Sleep(task, ticks);
+    else Resume(task);
+    return task;
+}
+
+void Timeline::CancelAll() {
+    tasks.clear();
+    for (std::vector<Sleeper>& slot : slots) slot.clear();
+}
+
+void Timeline::Sleep(TimelineTask task, uint32_t ticks) {
+    slots[(cursor + ticks) % TIMELINE_WHEEL_SLOTS].push_back(Sleeper{task, (ticks - 1) / TIMELINE_WHEEL_SLOTS});
+}
+
+void Timeline::Resume(TimelineTask task) {
+    for (;;) {
+        // Looked up again after every action, which may have cancelled the task or grown the map
+        auto found = tasks.find(task);
+        if (found == tasks.end()) return;
+        if (found->second.next >= found->second.steps.size()) {
+            tasks.erase(found);
+            return;
+        }
+
+        TimelineStep& step = found->second.steps[found->second.next++];
+        std::function<void()> action = std::move(step.action);
+        if (action) action();
+
+        found = tasks.find(task);
+        if (found == tasks.end()) return;
+        if (found->second.next >= found->second.steps.size()) {
+            tasks.erase(found);
+            return;
+        }
+        uint32_t ticks = found->second.steps[found->second.next].ticks;
+        if (ticks > 0) {
+            Sleep(task, ticks);
+            return;
+        }
+    }
+}
+
+void Timeline::Advance(float seconds) {
+    elapsed += seconds;
+    std::vector<Sleeper> due;
+    while (elapsed >= TIMELINE_TICK_MS / 1000.0f) {
+        elapsed -= TIMELINE_TICK_MS / 1000.0f;
+        cursor = (cursor + 1) % TIMELINE_WHEEL_SLOTS;
+        if (slots[cursor].empty()) continue;
+
+        // Taken out first, steps may sleep into this same slot again a full turn from now
+        due.clear();
+        due.swap(slots[cursor]);
+        for (Sleeper& sleeper : due) {
+            if (sleeper.turns > 0) {
+                sleeper.turns--;
+                slots[cursor].push_back(sleeper);
+            }
+            else Resume(sleeper.task);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Timed sequences for the round flow, written in the order they play:
+//
+//   timeline.Begin().Wait(0.5f).Then(reveal).Wait(2.5f).Then(nextQuestion).Start();
+//
+// A started sequence runs its steps up to the first Wait right away, then sleeps in a timer wheel until the wait is
+// over. Advance() only looks at the wheel slot of each tick that passed, so sleeping sequences cost nothing per
+// frame. Waits are rounded to TIMELINE_TICK_MS.
+//
+// Only the thread that calls Advance() may use the timeline. Steps may start, cancel or clear sequences, their own
+// included.
+#define TIMELINE_TICK_MS 10
+#define TIMELINE_WHEEL_SLOTS 256    // One turn of the wheel is 2.56 s, longer waits also count the turns
+
+typedef uint32_t TimelineTask;
+#define TIMELINE_NONE 0
+
+struct TimelineStep {
+    uint32_t ticks;                  // Wait before the action
+    std::function<void()> action;    // Empty for a trailing Wait
+};
+
+class Timeline {
+    public:
+        class Sequence {
+            public:
+                Sequence& Wait(float seconds);
+                Sequence& Then(std::function<void()> action);
+                TimelineTask Start();
+
+            private:
+                friend class Timeline;
+                explicit Sequence(Timeline& timeline) : timeline(timeline), waitTicks(0) {}
+
+                Timeline& timeline;
+                std::vector<TimelineStep> steps;
+                uint32_t waitTicks;    // Waited since the last action, goes to the next one
+        };
+
+        Timeline() : cursor(0), lastTask(TIMELINE_NONE), elapsed(0.0f) {}
+
+        Sequence Begin() { return Sequence(*this); }
+        TimelineTask After(float seconds, std::function<void()> action) { return Begin().Wait(seconds).Then(action).Start(); }
+
+        bool IsPending(TimelineTask task) const { return tasks.count(task) > 0; }
+        void Cancel(TimelineTask task) { tasks.erase(task); }    // Its wheel entry is skipped when it comes up
+        void CancelAll();
+
+        // Moves time forward, running the steps whose wait is over in the order they are due
+        void Advance(float seconds);
+
+    private:
+        struct Task {
+            std::vector<TimelineStep> steps;
+            size_t next;
+        };
+        struct Sleeper {
+            TimelineTask task;
+            uint32_t turns;    // Full turns of the wheel left before it is due
+        };
+
+        TimelineTask Start(std::vector<TimelineStep>& steps);
+        void Sleep(TimelineTask task, uint32_t ticks);
+        void Resume(TimelineTask task);
+
+        std::vector<Sleeper> slots[TIMELINE_WHEEL_SLOTS];
+        std::unordered_map<TimelineTask, Task> tasks;
+        uint32_t cursor;
+        TimelineTask lastTask;
+        float elapsed;    // Time not yet worth a whole tick
+};
@@ -0,0 +1,333 @@
+#include "tournament.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "math_generator.hpp"
+#include "replay.hpp"
+#include "work_stealing.hpp"
+
+bool FitProfileFromReplay(const std::vector<uint8_t>& data, const std::vector<Question>& questions, int player,
+                          BotProfile& profile, std::string& name) {
+    ReplayReader reader(data);
+    if (!reader.IsValid()) return false;
+
+    int answered[CATEGORY_COUNT] = {0};
+    int correct[CATEGORY_COUNT] = {0};
+    double logSum = 0.0, logSquareSum = 0.0;
+    int samples = 0;
+    const Question* question = nullptr;
+    QuestionCategory questionCategory = CATEGORY_SCIENCE;
+    Question generated;
+    uint64_t questionTimeNs = 0;
+    bool hasAnswered = false;
+
+    ReplayEvent event;
+    while (reader.Next(event)) {
+        if (event.type == REPLAY_PLAYER_NAME && event.player == player) name = event.text;
+        else if (event.type == REPLAY_QUESTION) {
+            question = ResolveQuestion(questions, event.value, generated);
+            questionCategory = IsGeneratedQuestion(event.value) ? CATEGORY_MATH : GetQuestionCategory((int) event.value);
+            questionTimeNs = event.timeNs;
+            hasAnswered = false;
+        }
+        else if (event.type == REPLAY_ANSWER && event.player == player && !hasAnswered &&
+                 question && event.timeNs > questionTimeNs) {
+            // Only the first press counts, like the locked-in answer in the game
+            hasAnswered = true;
+            answered[questionCategory]++;
+            if (event.value == question->correctAnswerIndex) correct[questionCategory]++;
+
+            double logSeconds = std::log((event.timeNs - questionTimeNs) / 1e9);
+            logSum += logSeconds;
+            logSquareSum += logSeconds * logSeconds;
+            samples++;
+        }
+    }
+    if (samples == 0) return false;
+
+    int totalCorrect = 0;
+    for (int i = 0; i < CATEGORY_COUNT; i++) totalCorrect += correct[i];
+    float overall = (float) totalCorrect / samples;
+
+    // Categories with few answers lean on the overall rate (two pseudo answers at the overall accuracy)
+    profile.level = BOT_MEDIUM;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        profile.accuracy[i] = (correct[i] + 2.0f * overall) / (answered[i] + 2.0f);
+    }
+    double mean = logSum / samples;
+    double variance = std::max(0.0, logSquareSum / samples - mean * mean);
+    profile.reactionMedianSeconds = (float) std::exp(mean);
+    profile.reactionSigma = (float) std::max(0.05, std::sqrt(variance));
+    return true;
+}
+
+bool ParseEntrant(const std::string& spec, const std::vector<Question>& questions, Entrant& entrant, std::string& error) {
+    BotLevel level;
+    if (ParseBotLevel(spec.c_str(), level)) {
+        entrant.name = GetBotLevelName(level);
+        entrant.profile = GetBotProfile(level);
+        return true;
+    }
+
+    if (spec.compare(0, 7, "replay:") != 0) {
+        error = "expected easy, medium, hard or replay:FILE[@player], got '" + spec + "'";
+        return false;
+    }
+
+    std::string fileName = spec.substr(7);
+    int player = 0;
+    size_t at = fileName.rfind('@');
+    if (at != std::string::npos) {
+        player = atoi(fileName.c_str() + at + 1);
+        fileName.resize(at);
+    }
+
+    std::vector<uint8_t> data;
+    if (!LoadReplayFile(fileName.c_str(), data)) {
+        error = "could not read replay " + fileName;
+        return false;
+    }
+    std::string name;
+    if (!FitProfileFromReplay(data, questions, player, entrant.profile, name)) {
+        error = "no answers from player " + std::to_string(player) + " in " + fileName;
+        return false;
+    }
+    entrant.name = name.empty() ? fileName : name;
+    return true;
+}
+
+struct Pairing {
+    int first;
+    int second;
+};
+
+struct MatchTask {
+    int pairing;
+    long firstMatch;
+    long matchCount;
+};
+
+struct PairingResult {
+    long firstWins;
+    long secondWins;
+    long draws;
+    long firstScore;
+    long secondScore;
+};
+
+// Everything a worker accumulates while playing, merged once the batch is done
+struct WorkerTally {
+    std::vector<QuestionStats> questions;
+    std::vector<Player> players;
+    long rounds;
+    long abilityUsed[ABILITY_COUNT];
+    long abilityPaidOff[ABILITY_COUNT];
+};
+
+static uint64_t MixSeed(uint64_t seed, uint64_t a, uint64_t b) {
+    SessionRandom mix(seed ^ (a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xC2B2AE3D27D4EB4FULL));
+    return mix.Next();
+}
+
+// Plays every pairing `matchesPerPairing` times, split into fixed-size tasks so the job system can balance them
+static std::vector<PairingResult> PlayPairings(const TournamentConfig& config, const std::vector<Entrant>& entrants,
+                                               const std::vector<Question>& questions, const std::vector<Pairing>& pairings,
+                                               uint64_t stageSeed, JobSystem& jobs, TournamentResult& result) {
+    std::vector<MatchTask> tasks;
+    for (int i = 0; i < (int) pairings.size(); i++) {
+        for (long first = 0; first < config.matchesPerPairing; first += TOURNAMENT_CHUNK_MATCHES) {
+            tasks.push_back(MatchTask{i, first, std::min((long) TOURNAMENT_CHUNK_MATCHES, config.matchesPerPairing - first)});
+        }
+    }
+
+    std::vector<PairingResult> taskResults(tasks.size(), PairingResult{0, 0, 0, 0, 0});
+    std::vector<WorkerTally> tallies(jobs.GetThreadCount() + 1);    // Slot 0 for this thread, it runs tasks while it waits
+    for (WorkerTally& tally : tallies) {
+        ResetQuestionStats(tally.questions, questions.size());
+        tally.rounds = 0;
+        std::fill(tally.abilityUsed, tally.abilityUsed + ABILITY_COUNT, 0);
+        std::fill(tally.abilityPaidOff, tally.abilityPaidOff + ABILITY_COUNT, 0);
+    }
+
+    jobs.Wait(jobs.ParallelFor("matches", (int) tasks.size(), [&](int taskIndex) {
+        const MatchTask& task = tasks[taskIndex];
+        const Pairing& pairing = pairings[task.pairing];
+        WorkerTally& tally = tallies[jobs.GetCurrentWorker() + 1];
+        PairingResult& outcome = taskResults[taskIndex];
+
+        // Seeded from the pairing and the chunk, so the outcome does not depend on which worker runs it
+        uint64_t taskSeed = MixSeed(stageSeed, (uint64_t) task.pairing, (uint64_t) task.firstMatch);
+        SessionRandom random(taskSeed);
+        BotPlayer first(entrants[pairing.first].profile, random.Next());
+        BotPlayer second(entrants[pairing.second].profile, random.Next());
+
+        for (long match = task.firstMatch; match < task.firstMatch + task.matchCount; match++) {
+            int winner = -1;    // 0 first, 1 second
+
+            if (config.mode == MODE_SINGLEPLAYER) {
+                uint64_t orderSeed = random.Next();
+                SessionRandom firstOrder(orderSeed), secondOrder(orderSeed);
+                SingleplayerStats a = SimulateSingleplayerGame(first, questions, firstOrder, config.rules, &tally.questions);
+                SingleplayerStats b = SimulateSingleplayerGame(second, questions, secondOrder, config.rules, &tally.questions);
+
+                if (a.score != b.score) winner = (a.score > b.score) ? 0 : 1;
+                else if (a.elapsedNs != b.elapsedNs) winner = (a.elapsedNs < b.elapsedNs) ? 0 : 1;
+                outcome.firstScore += a.score;
+                outcome.secondScore += b.score;
+                tally.rounds += a.questions + b.questions;
+                for (int i = 0; i < ABILITY_COUNT; i++) {
+                    tally.abilityUsed[i] += a.abilityUsed[i] + b.abilityUsed[i];
+                    tally.abilityPaidOff[i] += a.abilityPaidOff[i] + b.abilityPaidOff[i];
+                }
+            } else {
+                // Equal timestamps go to the lower seat, so the seats swap every match
+                bool swapped = (match % 2) == 1;
+                std::vector<BotPlayer*> seats = swapped ? std::vector<BotPlayer*>{&second, &first} : std::vector<BotPlayer*>{&first, &second};
+                BotMatchStats stats = SimulateBotMatch(seats, tally.players, questions, random, config.rules, 1, &tally.questions);
+
+                if (stats.winner >= 0) winner = swapped ? 1 - stats.winner : stats.winner;
+                outcome.firstScore += tally.players[swapped ? 1 : 0].score;
+                outcome.secondScore += tally.players[swapped ? 0 : 1].score;
+                tally.rounds += stats.rounds;
+            }
+
+            if (winner == 0) outcome.firstWins++;
+            else if (winner == 1) outcome.secondWins++;
+            else outcome.draws++;
+        }
+    }));
+
+    for (const WorkerTally& tally : tallies) {
+        MergeQuestionStats(result.questions, tally.questions);
+        result.rounds += tally.rounds;
+        for (int i = 0; i < ABILITY_COUNT; i++) {
+            result.abilityUsed[i] += tally.abilityUsed[i];
+            result.abilityPaidOff[i] += tally.abilityPaidOff[i];
+        }
+    }
+
+    std::vector<PairingResult> results(pairings.size(), PairingResult{0, 0, 0, 0, 0});
+    for (size_t i = 0; i < tasks.size(); i++) {
+        PairingResult& total = results[tasks[i].pairing];
+        total.firstWins += taskResults[i].firstWins;
+        total.secondWins += taskResults[i].secondWins;
+        total.draws += taskResults[i].draws;
+        total.firstScore += taskResults[i].firstScore;
+        total.secondScore += taskResults[i].secondScore;
+    }
+    result.matches += (long) pairings.size() * config.matchesPerPairing;
+    return results;
+}
+
+static void AddResult(Standing& first, Standing& second, const PairingResult& result, long matches) {
+    first.wins += result.firstWins;
+    first.losses += result.secondWins;
+    first.draws += result.draws;
+    first.totalScore += result.firstScore;
+    first.matches += matches;
+    second.wins += result.secondWins;
+    second.losses += result.firstWins;
+    second.draws += result.draws;
+    second.totalScore += result.secondScore;
+    second.matches += matches;
+}
+
+// Bracket slots for `size` (a power of two) so the top seeds meet as late as possible: 0 7 3 4 1 6 2 5 for eight
+static std::vector<int> GetBracketOrder(int size) {
+    std::vector<int> order{0};
+    while ((int) order.size() < size) {
+        int doubled = (int) order.size() * 2;
+        std::vector<int> next;
+        for (int seed : order) {
+            next.push_back(seed);
+            next.push_back(doubled - 1 - seed);
+        }
+        order.swap(next);
+    }
+    return order;
+}
+
+TournamentResult RunTournament(const TournamentConfig& config, const std::vector<Entrant>& entrants, const std::vector<Question>& questions) {
+    TournamentResult result{};
+    ResetQuestionStats(result.questions, questions.size());
+
+    // This thread helps while it waits for the matches, so it counts as one of the threads
+    JobSystem jobs(config.threadCount > 0 ? std::max(1, config.threadCount - 1) : 0);
+    result.threadCount = jobs.GetThreadCount() + 1;
+
+    std::vector<Standing> standings;
+    for (int i = 0; i < (int) entrants.size(); i++) standings.push_back(Standing{i, 0, 0, 0, 0, 0, 0});
+
+    if (config.format == FORMAT_ROUND_ROBIN) {
+        std::vector<Pairing> pairings;
+        for (int i = 0; i < (int) entrants.size(); i++) {
+            for (int j = i + 1; j < (int) entrants.size(); j++) pairings.push_back(Pairing{i, j});
+        }
+        std::vector<PairingResult> results = PlayPairings(config, entrants, questions, pairings, config.seed, jobs, result);
+        for (size_t i = 0; i < pairings.size(); i++) {
+            AddResult(standings[pairings[i].first], standings[pairings[i].second], results[i], config.matchesPerPairing);
+        }
+
+        // Three points for a win and one for a draw, then wins, then average score, then the entrant order
+        std::sort(standings.begin(), standings.end(), [](const Standing& a, const Standing& b) {
+            long pointsA = 3 * a.wins + a.draws, pointsB = 3 * b.wins + b.draws;
+            if (pointsA != pointsB) return pointsA > pointsB;
+            if (a.wins != b.wins) return a.wins > b.wins;
+            double averageA = a.matches ? (double) a.totalScore / a.matches : 0;
+            double averageB = b.matches ? (double) b.totalScore / b.matches : 0;
+            if (averageA != averageB) return averageA > averageB;
+            return a.entrant < b.entrant;
+        });
+    } else {
+        int size = 1;
+        while (size < (int) entrants.size()) size *= 2;
+        std::vector<int> alive;
+        for (int seed : GetBracketOrder(size)) alive.push_back(seed < (int) entrants.size() ? seed : -1);
+
+        for (int round = 0; alive.size() > 1; round++) {
+            std::vector<Pairing> pairings;
+            std::vector<int> next(alive.size() / 2, -1);
+            std::vector<int> pairingSlot;
+            for (size_t i = 0; i + 1 < alive.size(); i += 2) {
+                int first = alive[i], second = alive[i + 1];
+                if (first < 0 || second < 0) next[i / 2] = std::max(first, second);    // Bye
+                else {
+                    pairings.push_back(Pairing{first, second});
+                    pairingSlot.push_back((int) i / 2);
+                }
+            }
+
+            std::vector<PairingResult> results = PlayPairings(config, entrants, questions, pairings, MixSeed(config.seed, 0xB7AC, round), jobs, result);
+            for (size_t i = 0; i < pairings.size(); i++) {
+                const Pairing& pairing = pairings[i];
+                const PairingResult& series = results[i];
+                AddResult(standings[pairing.first], standings[pairing.second], series, config.matchesPerPairing);
+
+                // A drawn series goes to the higher seed, the lower entrant index
+                int winner = (series.firstWins == series.secondWins) ? std::min(pairing.first, pairing.second) :
+                             (series.secondWins > series.firstWins) ? pairing.second : pairing.first;
+                int loser = (winner == pairing.first) ? pairing.second : pairing.first;
+                next[pairingSlot[i]] = winner;
+                standings[winner].bracketRound = round + 1;
+
+                result.bracketLog.push_back("Round " + std::to_string(round + 1) + ": " + entrants[winner].name + " beat " + entrants[loser].name +
+                    " " + std::to_string(std::max(series.firstWins, series.secondWins)) + "-" + std::to_string(std::min(series.firstWins, series.secondWins)) +
+                    " (" + std::to_string(series.draws) + " drawn)");
+            }
+            for (int entrant : next) {
+                if (entrant >= 0) standings[entrant].bracketRound = std::max(standings[entrant].bracketRound, round + 1);
+            }
+            alive.swap(next);
+        }
+
+        std::sort(standings.begin(), standings.end(), [](const Standing& a, const Standing& b) {
+            if (a.bracketRound != b.bracketRound) return a.bracketRound > b.bracketRound;
+            if (a.wins != b.wins) return a.wins > b.wins;
+            return a.entrant < b.entrant;
+        });
+    }
+
+    result.standings = standings;
+    result.steals = jobs.GetStealCount();
+    return result;
+}
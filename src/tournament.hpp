@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bots.hpp"
+
+#define TOURNAMENT_CHUNK_MATCHES 256    // Matches per scheduled task
+
+enum TournamentFormat { FORMAT_ROUND_ROBIN = 0, FORMAT_BRACKET };
+
+// Singleplayer: both entrants play a full singleplayer game on the same question sequence, the higher score wins
+// (the faster game on equal scores). Multiplayer: head-to-head local multiplayer rules, seats alternate per match.
+enum TournamentMode { MODE_SINGLEPLAYER = 0, MODE_MULTIPLAYER };
+
+struct Entrant {
+    std::string name;
+    BotProfile profile;
+};
+
+// "easy", "medium", "hard", or "replay:FILE[@player]" to play like someone in a recorded session
+bool ParseEntrant(const std::string& spec, const std::vector<Question>& questions, Entrant& entrant, std::string& error);
+
+// Estimates per-category accuracy and the reaction time log-normal from one player's answers in a replay
+bool FitProfileFromReplay(const std::vector<uint8_t>& data, const std::vector<Question>& questions, int player,
+                          BotProfile& profile, std::string& name);
+
+struct TournamentConfig {
+    TournamentFormat format;
+    TournamentMode mode;
+    GameRules rules;
+    long matchesPerPairing;    // Round-robin: matches per pair, bracket: matches per series
+    uint64_t seed;
+    int threadCount;           // 0 uses every hardware thread
+};
+
+struct Standing {
+    int entrant;
+    long wins;
+    long draws;
+    long losses;
+    long matches;
+    long totalScore;     // Singleplayer game scores or multiplayer points, summed over every match
+    int bracketRound;    // Last bracket round reached, 0 based
+};
+
+struct TournamentResult {
+    std::vector<Standing> standings;        // Best first
+    std::vector<std::string> bracketLog;    // One line per bracket series
+    std::vector<QuestionStats> questions;
+    long matches;
+    long rounds;
+    long abilityUsed[ABILITY_COUNT];
+    long abilityPaidOff[ABILITY_COUNT];
+    uint64_t steals;
+    int threadCount;
+};
+
+// Results only depend on the seed, never on the thread count or how tasks were stolen
+TournamentResult RunTournament(const TournamentConfig& config, const std::vector<Entrant>& entrants, const std::vector<Question>& questions);
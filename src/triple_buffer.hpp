@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+
+// Lock-free triple buffer: one thread writes whole values, another reads the latest one. The writer fills Back() and
+// publishes it; the reader always gets the newest published value and keeps it until it asks again, so neither side
+// ever waits for the other or sees a half-written value. Values the reader never got to are skipped.
+template <typename T>
+class TripleBuffer {
+    public:
+        TripleBuffer() : buffers(), back(0), middle(1), front(2) {}
+
+        // Writer: fill the value, then Publish() it
+        T& Back() { return buffers[back]; }
+        void Publish() {
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Reader: the newest published value, valid until the next Read()
+        const T& Read() {
+            if (middle.load(std::memory_order_relaxed) & FRESH) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            }
+            return buffers[front];
+        }
+
+    private:
+        enum { INDEX = 3, FRESH = 4 };    // middle holds a buffer index and whether it was published since the last read
+
+        T buffers[3];
+        int back;                   // Only used by the writer
+        alignas(64) std::atomic<int> middle;
+        alignas(64) int front;      // Only used by the reader
+};
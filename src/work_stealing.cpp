@@ -0,0 +1,199 @@
+#include "work_stealing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+struct Job {
+    std::string name;
+    std::function<void()> work;
+    std::atomic<int> blockers;        // Unfinished jobs it depends on, plus one until it is submitted
+    std::mutex mutex;                 // Guards next and done against Precede()
+    std::vector<JobHandle> next;      // Jobs that depend on this one
+    std::atomic<bool> done;
+    uint64_t readyNs;
+};
+
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentWorker = -1;
+
+static uint64_t GetJobTimeNs() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+JobSystem::JobSystem(int threadCount) : queued(0), nextQueue(0), steals(0), waiting(0), stopping(false) {
+    if (threadCount <= 0) threadCount = (int) std::thread::hardware_concurrency() - 1;
+    this->threadCount = std::min(std::max(1, threadCount), JOB_MAX_THREADS);
+    for (int i = 0; i < this->threadCount; i++) queues.emplace_back(new WorkerQueue());
+    for (int i = 0; i < this->threadCount; i++) threads.emplace_back(&JobSystem::Work, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+int JobSystem::GetCurrentWorker() const {
+    return currentSystem == this ? currentWorker : -1;
+}
+
+JobHandle JobSystem::Create(std::string name, std::function<void()> work) {
+    JobHandle job = std::make_shared<Job>();
+    job->name = std::move(name);
+    job->work = std::move(work);
+    job->blockers = 1;
+    job->done = false;
+    job->readyNs = 0;
+    return job;
+}
+
+void JobSystem::Precede(const JobHandle& first, const JobHandle& then) {
+    std::lock_guard<std::mutex> lock(first->mutex);
+    if (first->done) return;
+    then->blockers++;
+    first->next.push_back(then);
+}
+
+void JobSystem::Submit(const JobHandle& job) {
+    if (--job->blockers == 0) Enqueue(job);
+}
+
+JobHandle JobSystem::Run(std::string name, std::function<void()> work) {
+    JobHandle job = Create(std::move(name), std::move(work));
+    Submit(job);
+    return job;
+}
+
+JobHandle JobSystem::Then(const JobHandle& first, std::string name, std::function<void()> work) {
+    JobHandle job = Create(std::move(name), std::move(work));
+    Precede(first, job);
+    Submit(job);
+    return job;
+}
+
+JobHandle JobSystem::WhenAll(const std::vector<JobHandle>& jobs, std::string name) {
+    JobHandle job = Create(std::move(name), std::function<void()>());
+    for (const JobHandle& first : jobs) Precede(first, job);
+    Submit(job);
+    return job;
+}
+
+JobHandle JobSystem::ParallelFor(std::string name, int count, std::function<void(int i)> work) {
+    // A few chunks per worker, so stealing can even out chunks that take longer than others
+    int chunks = std::min(count, threadCount * 4);
+    std::shared_ptr<std::function<void(int i)>> shared = std::make_shared<std::function<void(int i)>>(std::move(work));
+    std::vector<JobHandle> jobs;
+    for (int chunk = 0; chunk < chunks; chunk++) {
+        int first = (int) ((int64_t) count * chunk / chunks);
+        int last = (int) ((int64_t) count * (chunk + 1) / chunks);
+        jobs.push_back(Run(name, [shared, first, last]() {
+            for (int i = first; i < last; i++) (*shared)(i);
+        }));
+    }
+    return WhenAll(jobs, name);
+}
+
+bool JobSystem::IsDone(const JobHandle& job) const {
+    return job->done.load();
+}
+
+void JobSystem::Enqueue(const JobHandle& job) {
+    job->readyNs = GetJobTimeNs();
+
+    // Jobs released by a worker stay on it, they often use what the job before them just produced
+    int worker = GetCurrentWorker();
+    if (worker < 0) worker = (int) (nextQueue++ % (uint32_t) threadCount);
+    queued++;
+    {
+        std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+        queues[worker]->jobs.push_back(job);
+    }
+
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    wake.notify_one();
+    if (waiting > 0) finished.notify_all();
+}
+
+bool JobSystem::Take(int worker, JobHandle& job) {
+    if (worker >= 0) {
+        WorkerQueue& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    int start = (worker >= 0) ? worker + 1 : (int) (nextQueue.load() % (uint32_t) threadCount);
+    for (int offset = 0; offset < threadCount; offset++) {
+        int victim = (start + offset) % threadCount;
+        if (victim == worker) continue;
+        WorkerQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queued--;
+        steals++;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(const JobHandle& job, int worker) {
+    uint64_t startNs = GetJobTimeNs();
+    if (job->work) job->work();
+    job->work = std::function<void()>();    // Frees what the job captured
+    if (profileHook) profileHook(JobProfile{job->name.c_str(), worker, job->readyNs, startNs, GetJobTimeNs()});
+
+    std::vector<JobHandle> next;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done = true;
+        next.swap(job->next);
+    }
+    for (const JobHandle& then : next) {
+        if (--then->blockers == 0) Enqueue(then);
+    }
+
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    if (waiting > 0) finished.notify_all();
+}
+
+void JobSystem::Work(int worker) {
+    currentSystem = this;
+    currentWorker = worker;
+
+    for (;;) {
+        JobHandle job;
+        if (Take(worker, job)) {
+            Execute(job, worker);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [&]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() <= 0) return;
+    }
+}
+
+void JobSystem::Wait(const JobHandle& job) {
+    int worker = GetCurrentWorker();
+    while (!job->done) {
+        JobHandle other;
+        if (Take(worker, other)) {
+            Execute(other, worker);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        waiting++;
+        finished.wait(lock, [&]() { return job->done.load() || queued.load() > 0; });
+        waiting--;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define JOB_MAX_THREADS 32    // Workers beyond this only add stealing traffic for the game's job sizes
+
+// Long-lived workers for background jobs: the game's startup decoding, question layout and saved data, and the
+// tournament tool's matches. Jobs form graphs: a job runs once it was submitted and every job it depends on has
+// finished, and finishing it releases the jobs that wait on it (continuations). Each worker pops its own newest job
+// first and steals the oldest job of another worker when it runs dry. Idle workers sleep, so a 2-core board keeps a
+// core for the window thread; a thread that waits for a job runs other jobs meanwhile, so waiting never deadlocks,
+// even with a single worker.
+struct Job;
+typedef std::shared_ptr<Job> JobHandle;
+
+// One finished job, handed to the profile hook
+struct JobProfile {
+    const char* name;
+    int worker;          // -1 when a thread waiting in Wait() ran it
+    uint64_t readyNs;    // Queued, its dependencies were done
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+class JobSystem {
+    public:
+        explicit JobSystem(int threadCount = 0);    // 0 leaves one hardware thread to the caller
+        ~JobSystem();                               // Runs what is queued, then stops the workers
+
+        int GetThreadCount() const { return threadCount; }
+        uint64_t GetStealCount() const { return steals.load(); }
+
+        // A job that runs after Submit(), once every job passed to Precede() as `first` finished. Precede() must
+        // come before `then` is submitted; `first` may already be done.
+        JobHandle Create(std::string name, std::function<void()> work);
+        void Precede(const JobHandle& first, const JobHandle& then);
+        void Submit(const JobHandle& job);
+
+        JobHandle Run(std::string name, std::function<void()> work);    // Create() and Submit()
+        JobHandle Then(const JobHandle& first, std::string name, std::function<void()> work);
+        JobHandle WhenAll(const std::vector<JobHandle>& jobs, std::string name);
+
+        // Calls work(i) for i in [0, count) over a few jobs per worker. The returned job finishes after the last one.
+        JobHandle ParallelFor(std::string name, int count, std::function<void(int i)> work);
+
+        bool IsDone(const JobHandle& job) const;
+        void Wait(const JobHandle& job);
+
+        // Called on the thread that ran the job, right after it. Set it before submitting jobs.
+        void SetProfileHook(std::function<void(const JobProfile&)> hook) { profileHook = hook; }
+
+        // The worker running the calling job, in [0, GetThreadCount()), or -1 on a thread that runs jobs in Wait().
+        // Lets jobs write to per-worker state without locking.
+        int GetCurrentWorker() const;
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<JobHandle> jobs;
+        };
+
+        void Enqueue(const JobHandle& job);
+        bool Take(int worker, JobHandle& job);
+        void Execute(const JobHandle& job, int worker);
+        void Work(int worker);
+
+        int threadCount;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> threads;
+        std::atomic<int> queued;             // Jobs in the queues, may briefly run ahead of them
+        std::atomic<uint32_t> nextQueue;     // Round robin for jobs submitted from outside the workers
+        std::atomic<uint64_t> steals;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;        // Workers, a job was queued
+        std::condition_variable finished;    // Wait(), a job finished or was queued
+        int waiting;                         // Threads in Wait(), guarded by sleepMutex
+        bool stopping;
+
+        std::function<void(const JobProfile&)> profileHook;
+};
@@ -0,0 +1,92 @@
+// Plays bot-only multiplayer matches without the game window, to load-test answer evaluation and tie-breaks.
+//
+//   bot-sim [--matches N] [--players N] [--levels easy,medium,hard] [--seed N] [--resolution-ms N]
+//
+// --levels lists one level per seat and repeats the last one for the remaining seats. --resolution-ms rounds
+// reaction times (default 1 ms) so several correct answers can arrive at the same instant.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "bots.hpp"
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char** argv) {
+    long matches = 10000;
+    int playerCount = MIN_PLAYERS;
+    std::vector<BotLevel> levels{BOT_MEDIUM};
+    uint64_t seed = NowNs();
+    double resolutionMs = 1.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--matches") == 0 && value) matches = std::max(1L, atol(value)), i++;
+        else if (strcmp(argv[i], "--players") == 0 && value) playerCount = std::min(MAX_PLAYERS, std::max(MIN_PLAYERS, atoi(value))), i++;
+        else if (strcmp(argv[i], "--seed") == 0 && value) seed = strtoull(value, nullptr, 10), i++;
+        else if (strcmp(argv[i], "--resolution-ms") == 0 && value) resolutionMs = atof(value), i++;
+        else if (strcmp(argv[i], "--levels") == 0 && value) {
+            levels.clear();
+            std::string list = value;
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t comma = list.find(',', start);
+                std::string name = list.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+                BotLevel level;
+                if (!ParseBotLevel(name.c_str(), level)) {
+                    fprintf(stderr, "BOTSIM: Unknown bot level '%s'\n", name.c_str());
+                    return 1;
+                }
+                levels.push_back(level);
+                if (comma == std::string::npos) break;
+                start = comma + 1;
+            }
+            i++;
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--matches N] [--players N] [--levels easy,medium,hard] [--seed N] [--resolution-ms N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Question> questions = GetQuestionsVector();
+    SessionRandom random(seed);
+    std::vector<BotPlayer> bots;
+    for (int i = 0; i < playerCount; i++) {
+        BotLevel level = levels[std::min(i, (int) levels.size() - 1)];
+        bots.push_back(BotPlayer(GetBotProfile(level), random.Next()));
+    }
+    std::vector<BotPlayer*> seats;
+    for (BotPlayer& bot : bots) seats.push_back(&bot);
+    GameRules rules = GetDefaultGameRules();
+
+    printf("BOTSIM: %ld matches, %i players, seed %llu\n", matches, playerCount, (unsigned long long) seed);
+
+    std::vector<Player> players;
+    std::vector<long> wins(playerCount, 0);
+    long draws = 0, rounds = 0, timeouts = 0, tiedFastest = 0;
+    uint64_t resolutionNs = (uint64_t) (resolutionMs * 1e6);
+
+    uint64_t startNs = NowNs();
+    for (long match = 0; match < matches; match++) {
+        BotMatchStats stats = SimulateBotMatch(seats, players, questions, random, rules, resolutionNs, nullptr);
+        if (stats.winner >= 0) wins[stats.winner]++;
+        else draws++;
+        rounds += stats.rounds;
+        timeouts += stats.timeouts;
+        tiedFastest += stats.tiedFastest;
+    }
+    double seconds = (NowNs() - startNs) / 1e9;
+
+    for (int i = 0; i < playerCount; i++) {
+        printf("BOTSIM: Seat %i (%s) won %ld (%.1f%%)\n", i + 1, GetBotLevelName(bots[i].GetProfile().level), wins[i], 100.0 * wins[i] / matches);
+    }
+    printf("BOTSIM: Shared top score %ld, %.1f rounds per match, %ld timeouts, %ld fastest-answer ties\n",
+           draws, (double) rounds / matches, timeouts, tiedFastest);
+    printf("BOTSIM: %.0f matches/s (%.0f rounds/s)\n", matches / seconds, rounds / seconds);
+    return 0;
+}
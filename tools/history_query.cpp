@@ -0,0 +1,150 @@
+// Aggregates over the game history for the operator dashboard: average score per week, accuracy per question
+// category and answer time percentiles, with the time each query took.
+//
+//   history-query [--file PATH] [--mode single|multi|all] [--weeks N] [--generate N] [--seed N] [--compact]
+//
+// --generate replaces the file's contents with N synthetic games, for benchmarking without a real history.
+// --compact rewrites the file in large row groups (with --generate, writes the synthetic games to it).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include "game_history.hpp"
+#include "persistence.hpp"
+#include "replay.hpp"
+#include "score_store.hpp"
+#include "session_random.hpp"
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Games spread over the last two years: 1-4 players answering 5-30 questions each
+static void GenerateGames(GameHistoryColumns& columns, long games, uint64_t seed, int questionCount) {
+    SessionRandom random(seed);
+    int64_t now = (int64_t) time(nullptr);
+    columns.Clear();
+    columns.Reserve(games * 2, games * 35);
+
+    GameHistoryGame game;
+    for (long i = 0; i < games; i++) {
+        game.timestamp = now - (int64_t) random.NextBelow(2 * 52 * 7 * 86400);
+        game.mode = random.NextBelow(2) ? REPLAY_MULTIPLAYER : REPLAY_SINGLEPLAYER;
+        int players = (game.mode == REPLAY_SINGLEPLAYER) ? 1 : random.Range(MIN_PLAYERS, MAX_PLAYERS);
+        int rounds = random.Range(5, 30);
+
+        game.results.assign(players, GameHistoryResult{0, 0, 0});
+        game.answers.clear();
+        for (int round = 0; round < rounds; round++) {
+            uint16_t question = (uint16_t) random.NextBelow(questionCount);
+            for (int p = 0; p < players; p++) {
+                GameHistoryAnswer row{(uint8_t) p, question, GAME_HISTORY_NO_ANSWER, false, 0};
+                if (random.NextBelow(20) != 0) {
+                    row.answer = (int8_t) random.NextBelow(4);
+                    row.correct = random.NextUnit() < 0.7;
+                    // Roughly log-normal around 3 s: the sum of three uniforms is close enough to a normal
+                    double z = (random.NextUnit() + random.NextUnit() + random.NextUnit() - 1.5) * 2.0;
+                    row.latencyMs = (uint32_t) std::min(20000.0, 3000.0 * std::exp(0.5 * z));
+                    game.results[p].score += row.correct;
+                }
+                game.answers.push_back(row);
+            }
+        }
+        for (GameHistoryResult& result : game.results) {
+            result.health = random.Range(0, 3);
+            result.abilities = (uint8_t) random.NextBelow(16);
+        }
+        columns.Append(game);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path = GAME_HISTORY_FILE_PATH;
+    int mode = -1;
+    int weeksShown = 8;
+    long generate = 0;
+    uint64_t seed = NowNs();
+    bool compact = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--file") == 0 && value) path = value, i++;
+        else if (strcmp(argv[i], "--weeks") == 0 && value) weeksShown = std::max(0, atoi(value)), i++;
+        else if (strcmp(argv[i], "--generate") == 0 && value) generate = std::max(1L, atol(value)), i++;
+        else if (strcmp(argv[i], "--seed") == 0 && value) seed = strtoull(value, nullptr, 10), i++;
+        else if (strcmp(argv[i], "--compact") == 0) compact = true;
+        else if (strcmp(argv[i], "--mode") == 0 && value) {
+            if (strcmp(value, "single") == 0) mode = REPLAY_SINGLEPLAYER;
+            else if (strcmp(value, "multi") == 0) mode = REPLAY_MULTIPLAYER;
+            else if (strcmp(value, "all") == 0) mode = -1;
+            else {
+                fprintf(stderr, "HISTORY: Unknown mode '%s'\n", value);
+                return 1;
+            }
+            i++;
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--file PATH] [--mode single|multi|all] [--weeks N] [--generate N] [--seed N] [--compact]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    GameHistoryColumns columns;
+    uint64_t startNs = NowNs();
+    if (generate > 0) {
+        GenerateGames(columns, generate, seed, (int) GetQuestionsVector().size());
+        printf("HISTORY: Generated %ld games (seed %llu) in %.2f s\n", generate, (unsigned long long) seed, (NowNs() - startNs) / 1e9);
+    } else {
+        std::vector<uint8_t> data;
+        if (!ReadWholeFile(path, data)) {
+            fprintf(stderr, "HISTORY: Could not read %s\n", path.c_str());
+            return 1;
+        }
+        GameHistoryContents contents = ParseGameHistory(data.data(), data.size());
+        columns = std::move(contents.columns);
+        printf("HISTORY: Loaded %s, %i row groups, %.1f MB in %.2f s\n", path.c_str(), (int) contents.groups, data.size() / 1e6,
+               (NowNs() - startNs) / 1e9);
+        if (contents.droppedBytes > 0) printf("HISTORY: Skipped %i corrupt bytes\n", (int) contents.droppedBytes);
+    }
+    printf("HISTORY: %i results, %i answers\n", (int) columns.ResultRows(), (int) columns.AnswerRows());
+
+    startNs = NowNs();
+    std::vector<WeeklyScore> weeks = AverageScorePerWeek(columns, mode);
+    double weeksSeconds = (NowNs() - startNs) / 1e9;
+    for (size_t i = weeks.size() > (size_t) weeksShown ? weeks.size() - weeksShown : 0; i < weeks.size(); i++) {
+        time_t weekStart = (time_t) weeks[i].weekStart;
+        char date[16];
+        strftime(date, sizeof(date), "%Y-%m-%d", gmtime(&weekStart));
+        printf("HISTORY: Week of %s: %u results, average score %.2f\n", date, weeks[i].results, weeks[i].averageScore);
+    }
+    printf("HISTORY: Average score per week: %i weeks in %.1f ms\n", (int) weeks.size(), weeksSeconds * 1000);
+
+    startNs = NowNs();
+    CategoryAccuracy accuracy = AccuracyPerCategory(columns);
+    double accuracySeconds = (NowNs() - startNs) / 1e9;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        double percent = accuracy.asked[i] ? 100.0 * accuracy.correct[i] / accuracy.asked[i] : 0.0;
+        printf("HISTORY: %-8s %llu asked, %.1f%% correct\n", GetQuestionCategoryName((QuestionCategory) i),
+               (unsigned long long) accuracy.asked[i], percent);
+    }
+    printf("HISTORY: Accuracy per category in %.1f ms\n", accuracySeconds * 1000);
+
+    startNs = NowNs();
+    std::vector<uint32_t> times = AnswerTimePercentiles(columns, {50, 95, 99});
+    printf("HISTORY: Answer time p50 %u ms, p95 %u ms, p99 %u ms in %.1f ms\n", times[0], times[1], times[2], (NowNs() - startNs) / 1e6);
+
+    if (compact) {
+        std::vector<uint8_t> data = EncodeGameHistory(columns);
+        if (!WriteFileAtomic(path, data)) {
+            fprintf(stderr, "HISTORY: Could not write %s\n", path.c_str());
+            return 1;
+        }
+        printf("HISTORY: Wrote %s, %.1f MB\n", path.c_str(), data.size() / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Plays an online match entirely over loopback: a MatchServer and bot clients run in this process, the server
+// delays every message per player slot to simulate latency and jitter.
+//
+//   match-loopback [--rounds N] [--latency-ms A,B] [--jitter-ms N] [--reaction-ms A,B] [--port N]
+//
+// By default player 2 reacts faster but sits behind a much slower link. Without RTT compensation player 1's
+// answers would arrive first every round; with it player 2 must win every round. Exits non-zero otherwise.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "match_client.hpp"
+#include "match_server.hpp"
+#include "questions.hpp"
+
+struct BotPlayer {
+    MatchClient client;
+    uint64_t reactionNs;
+    uint32_t answeredRound;
+    uint64_t questionSeenNs;
+};
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::vector<uint32_t> ParseList(const char* text) {
+    std::vector<uint32_t> values;
+    std::string item;
+    for (const char* c = text; ; c++) {
+        if (*c == ',' || *c == '\0') {
+            if (!item.empty()) values.push_back((uint32_t) strtoul(item.c_str(), nullptr, 10));
+            item.clear();
+            if (*c == '\0') break;
+        } else {
+            item += *c;
+        }
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    int rounds = 5;
+    std::vector<uint32_t> reactionMs = {700, 500};
+
+    MatchServerConfig config = GetDefaultMatchServerConfig();
+    config.port = MATCH_DEFAULT_PORT + 1;
+    config.latencyMs = {10, 150};
+    config.jitterMs = 15;
+    config.readySeconds = 1.0f;
+    config.revealDelaySeconds = 0.05f;
+    config.resultDelaySeconds = 0.1f;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (strcmp(argv[i], "--rounds") == 0) rounds = atoi(value), i++;
+        else if (strcmp(argv[i], "--latency-ms") == 0) config.latencyMs = ParseList(value), i++;
+        else if (strcmp(argv[i], "--jitter-ms") == 0) config.jitterMs = (uint32_t) atoi(value), i++;
+        else if (strcmp(argv[i], "--reaction-ms") == 0) reactionMs = ParseList(value), i++;
+        else if (strcmp(argv[i], "--port") == 0) config.port = (uint16_t) atoi(value), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--rounds N] [--latency-ms A,B] [--jitter-ms N] [--reaction-ms A,B] [--port N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (reactionMs.size() < 2) reactionMs.resize(2, reactionMs.empty() ? 500 : reactionMs[0]);
+
+    if (!NetInit()) return 1;
+
+    MatchServer server(config);
+    if (!server.Start()) return 1;
+
+    std::vector<Question> questions = GetQuestionsVector();
+    BotPlayer bots[2];
+    for (int i = 0; i < 2; i++) {
+        bots[i].reactionNs = reactionMs[i] * 1000000ULL;
+        bots[i].answeredRound = 0;
+        bots[i].questionSeenNs = 0;
+        if (!bots[i].client.Connect("127.0.0.1", config.port, "Bot " + std::to_string(i + 1))) {
+            fprintf(stderr, "LOOPBACK: Bot %i failed to connect\n", i + 1);
+            return 1;
+        }
+    }
+
+    uint64_t deadlineNs = NowNs() + (uint64_t) (rounds + 5) * 5000000000ULL;
+    while (server.GetRoundsPlayed() < rounds && !server.IsFinished() && NowNs() < deadlineNs) {
+        uint64_t nowNs = NowNs();
+        server.Update(nowNs);
+
+        for (BotPlayer& bot : bots) {
+            uint32_t round = bot.client.GetRoundId();
+            bot.client.Update(nowNs);
+            if (bot.client.GetRoundId() != round) bot.questionSeenNs = nowNs;
+
+            // Both bots always know the answer, only their speed differs
+            round = bot.client.GetRoundId();
+            if (round != 0 && bot.answeredRound != round && nowNs - bot.questionSeenNs >= bot.reactionNs) {
+                bot.client.SendAnswer(questions[bot.client.GetQuestionIndex()].correctAnswerIndex, bot.questionSeenNs + bot.reactionNs);
+                bot.answeredRound = round;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    int expectedWinner = (reactionMs[0] <= reactionMs[1]) ? 0 : 1;
+    int fairRounds = 0;
+    int played = 0;
+    for (const MatchRoundResult& result : server.GetResults()) {
+        if (result.timedOut) continue;
+        played++;
+        if (result.result.fastestCorrectPlayer == expectedWinner) fairRounds++;
+        printf("LOOPBACK: Round %u won by player %i\n", result.roundId, result.result.fastestCorrectPlayer + 1);
+    }
+
+    printf("LOOPBACK: RTT player 1 %.1f ms, player 2 %.1f ms (simulated one-way %u/%u ms, jitter %u ms)\n",
+           server.GetRoundTripNs(0) / 1e6, server.GetRoundTripNs(1) / 1e6, config.latencyMs[0],
+           config.latencyMs[config.latencyMs.size() > 1 ? 1 : 0], config.jitterMs);
+    printf("LOOPBACK: Faster player won %i of %i rounds\n", fairRounds, played);
+
+    for (BotPlayer& bot : bots) bot.client.Disconnect();
+    server.Stop();
+    NetShutdown();
+
+    return (played >= rounds && fairRounds == played) ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// Headless authoritative server for online head-to-head matches.
+//
+//   match-server [--port N] [--players N] [--countdown S] [--seed N] [--latency-ms A[,B...]] [--jitter-ms N]
+//
+// --latency-ms and --jitter-ms simulate a slow network per player slot, so a match can be tried over loopback.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "match_server.hpp"
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::vector<uint32_t> ParseList(const char* text) {
+    std::vector<uint32_t> values;
+    std::string item;
+    for (const char* c = text; ; c++) {
+        if (*c == ',' || *c == '\0') {
+            if (!item.empty()) values.push_back((uint32_t) strtoul(item.c_str(), nullptr, 10));
+            item.clear();
+            if (*c == '\0') break;
+        } else {
+            item += *c;
+        }
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    MatchServerConfig config = GetDefaultMatchServerConfig();
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (strcmp(argv[i], "--port") == 0) config.port = (uint16_t) atoi(value), i++;
+        else if (strcmp(argv[i], "--players") == 0) config.playerCount = atoi(value), i++;
+        else if (strcmp(argv[i], "--countdown") == 0) config.countdownSeconds = atoi(value), i++;
+        else if (strcmp(argv[i], "--seed") == 0) config.seed = (unsigned int) strtoul(value, nullptr, 10), i++;
+        else if (strcmp(argv[i], "--latency-ms") == 0) config.latencyMs = ParseList(value), i++;
+        else if (strcmp(argv[i], "--jitter-ms") == 0) config.jitterMs = (uint32_t) atoi(value), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--port N] [--players N] [--countdown S] [--seed N] [--latency-ms A[,B...]] [--jitter-ms N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!NetInit()) return 1;
+
+    MatchServer server(config);
+    if (!server.Start()) return 1;
+
+    while (!server.IsFinished()) {
+        server.Update(NowNs());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Keep pumping briefly so the delayed GAME_OVER still reaches everyone
+    uint64_t drainUntilNs = NowNs() + 1000000000ULL;
+    while (NowNs() < drainUntilNs) {
+        server.Update(NowNs());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (size_t i = 0; i < server.GetPlayers().size(); i++) {
+        const Player& player = server.GetPlayers()[i];
+        printf("MATCH: %s - score %i, health %i\n", player.name.c_str(), player.score, player.healthPoints);
+    }
+
+    server.Stop();
+    NetShutdown();
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Prints generated math questions and benchmarks the generator.
+//
+//   math-questions [--count N] [--seed N] [--level 0-2] [--bench N]
+//
+// Every generated question is checked: four distinct options, the keyed one holding the answer the same seed
+// gives again. The benchmark counts heap allocations, which must stay at zero once the Question is warm.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "math_generator.hpp"
+#include "session_random.hpp"
+
+static std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool CheckQuestion(uint32_t seed, const Question& question) {
+    if (question.answers.size() != 4 || question.correctAnswerIndex < 0 || question.correctAnswerIndex > 3) return false;
+    for (int i = 0; i < 4; i++) {
+        for (int j = i + 1; j < 4; j++) {
+            if (question.answers[i] == question.answers[j]) return false;
+        }
+    }
+    Question again;
+    GenerateMathQuestion(seed, again);
+    return again.questionText == question.questionText && again.answers == question.answers &&
+           again.correctAnswerIndex == question.correctAnswerIndex;
+}
+
+int main(int argc, char** argv) {
+    int count = 10;
+    long bench = 1000000;
+    int level = -1;    // Any
+    uint64_t seed = NowNs();
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--count") == 0 && value) count = std::max(0, atoi(value)), i++;
+        else if (strcmp(argv[i], "--seed") == 0 && value) seed = strtoull(value, nullptr, 10), i++;
+        else if (strcmp(argv[i], "--level") == 0 && value) level = std::max(0, std::min(MATH_LEVELS - 1, atoi(value))), i++;
+        else if (strcmp(argv[i], "--bench") == 0 && value) bench = std::max(0L, atol(value)), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--count N] [--seed N] [--level 0-2] [--bench N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SessionRandom random(seed);
+    Question question;
+    int invalid = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t questionSeed = MakeMathSeed((uint32_t) random.Next(), level >= 0 ? level : (int) random.NextBelow(MATH_LEVELS));
+        GenerateMathQuestion(questionSeed, question);
+        if (!CheckQuestion(questionSeed, question)) invalid++;
+        printf("MATH: [%u] %s\n", GetMathLevel(questionSeed), question.questionText.c_str());
+        for (int j = 0; j < 4; j++) printf("MATH:     %c %s\n", j == question.correctAnswerIndex ? '*' : ' ', question.answers[j].c_str());
+    }
+
+    if (bench > 0) {
+        // Warm the Question with the longest text first, later questions then fit its buffers
+        for (int i = 0; i < 1000; i++) GenerateMathQuestion(MakeMathSeed((uint32_t) random.Next(), MATH_LEVELS - 1), question);
+        uint64_t checksum = 0;
+        uint64_t allocationsBefore = allocationCount;
+        uint64_t startNs = NowNs();
+        for (long i = 0; i < bench; i++) {
+            GenerateMathQuestion((uint32_t) (seed + i), question);
+            checksum += (uint64_t) question.correctAnswerIndex + question.questionText.size();
+        }
+        double seconds = (NowNs() - startNs) / 1e9;
+        uint64_t allocations = allocationCount - allocationsBefore;
+        for (long i = 0; i < std::min(bench, 100000L); i++) {
+            GenerateMathQuestion((uint32_t) (seed + i), question);
+            if (!CheckQuestion((uint32_t) (seed + i), question)) invalid++;
+        }
+        printf("MATH: %ld questions in %.1f ms, %.0f per ms, %llu heap allocations (checksum %llu)\n", bench, seconds * 1e3,
+               bench / (seconds * 1e3), (unsigned long long) allocations, (unsigned long long) checksum);
+    }
+    if (invalid > 0) printf("MATH: %i invalid questions\n", invalid);
+    return invalid > 0 ? 1 : 0;
+}
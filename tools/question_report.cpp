@@ -0,0 +1,94 @@
+// Lists the questions the answer telemetry flags for review: the hardest and easiest ones by estimated
+// difficulty, and suspects whose most picked option is not the keyed answer (often a wrong answer key).
+//
+//   question-report [--estimates PATH] [--rebuild LOG] [--top N] [--min-attempts N]
+//
+// --rebuild recomputes the estimates from a telemetry log instead of reading the saved ones, e.g. after changing
+// the update rule.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "question_telemetry.hpp"
+#include "questions.hpp"
+#include "score_store.hpp"
+
+static void PrintQuestion(const std::vector<Question>& questions, const QuestionEstimate& estimate, int index) {
+    double accuracy = estimate.attempts ? 100.0 * estimate.correct / estimate.attempts : 0.0;
+    uint32_t answered = estimate.attempts - estimate.timeouts;
+    printf("REPORT: #%-4i %-8s difficulty %+5.2f  %3.0f%% of %u correct, %u timeouts, %.1f s average  %s\n", index,
+           GetQuestionCategoryName(GetQuestionCategory(index)), estimate.difficulty, accuracy, estimate.attempts,
+           estimate.timeouts, answered ? estimate.totalLatencyMs / 1000.0 / answered : 0.0, questions[index].questionText.c_str());
+}
+
+int main(int argc, char** argv) {
+    std::string estimatesPath = DIFFICULTY_FILE_PATH;
+    std::string rebuildPath;
+    int top = 10;
+    uint32_t minAttempts = 20;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--estimates") == 0 && value) estimatesPath = value, i++;
+        else if (strcmp(argv[i], "--rebuild") == 0 && value) rebuildPath = value, i++;
+        else if (strcmp(argv[i], "--top") == 0 && value) top = std::max(0, atoi(value)), i++;
+        else if (strcmp(argv[i], "--min-attempts") == 0 && value) minAttempts = (uint32_t) std::max(1, atoi(value)), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--estimates PATH] [--rebuild LOG] [--top N] [--min-attempts N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Question> questions = GetQuestionsVector();
+    std::vector<QuestionEstimate> estimates;
+    std::vector<uint8_t> data;
+
+    if (!rebuildPath.empty()) {
+        if (!ReadWholeFile(rebuildPath, data)) {
+            fprintf(stderr, "REPORT: Could not read %s\n", rebuildPath.c_str());
+            return 1;
+        }
+        std::vector<AnswerSample> samples;
+        size_t skipped = ParseTelemetryLog(data.data(), data.size(), samples);
+        estimates.assign(questions.size(), QuestionEstimate{0.0f, 0, 0, 0, {0, 0, 0, 0}, 0});
+        for (const AnswerSample& sample : samples) {
+            if (sample.question < estimates.size()) UpdateEstimate(estimates[sample.question], sample);
+        }
+        printf("REPORT: Rebuilt from %i answers in %s, skipped %i corrupt bytes\n", (int) samples.size(), rebuildPath.c_str(), (int) skipped);
+    }
+    else if (!ReadWholeFile(estimatesPath, data) || !ParseEstimates(data.data(), data.size(), estimates)) {
+        fprintf(stderr, "REPORT: Could not read %s\n", estimatesPath.c_str());
+        return 1;
+    }
+    if (estimates.size() != questions.size()) {
+        fprintf(stderr, "REPORT: The estimates cover %i questions, the game has %i\n", (int) estimates.size(), (int) questions.size());
+        return 1;
+    }
+
+    std::vector<int> rated;
+    for (int i = 0; i < (int) estimates.size(); i++) {
+        if (estimates[i].attempts >= minAttempts) rated.push_back(i);
+    }
+    std::sort(rated.begin(), rated.end(), [&](int a, int b) { return estimates[a].difficulty > estimates[b].difficulty; });
+    printf("REPORT: %i of %i questions have at least %u answers\n", (int) rated.size(), (int) questions.size(), minAttempts);
+
+    int shown = std::min(top, (int) rated.size());
+    printf("REPORT: Hardest\n");
+    for (int i = 0; i < shown; i++) PrintQuestion(questions, estimates[rated[i]], rated[i]);
+    printf("REPORT: Easiest\n");
+    for (int i = 0; i < shown; i++) PrintQuestion(questions, estimates[rated[rated.size() - 1 - i]], rated[rated.size() - 1 - i]);
+
+    printf("REPORT: Most picked option is not the keyed answer\n");
+    for (int index : rated) {
+        const QuestionEstimate& estimate = estimates[index];
+        int keyed = questions[index].correctAnswerIndex;
+        int favourite = (int) (std::max_element(estimate.choices, estimate.choices + 4) - estimate.choices);
+        if (estimate.choices[favourite] <= estimate.choices[keyed]) continue;
+        PrintQuestion(questions, estimate, index);
+        printf("REPORT:       option %i picked %u times, keyed option %i %u times\n", favourite + 1, estimate.choices[favourite],
+               keyed + 1, estimate.choices[keyed]);
+    }
+    return 0;
+}
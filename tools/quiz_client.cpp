@@ -0,0 +1,99 @@
+// Command line stand-in for a classroom answer client (POSIX only, it waits on stdin and the socket together).
+//
+//   quiz-client [host] [port] [name]
+//
+// Prints every question the quiz host broadcasts, type 1-4 and Enter to answer.
+
+#include <poll.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "net.hpp"
+#include "quiz_host.hpp"
+
+static void PrintQuestion(char* line, unsigned* round) {
+    char* field = strtok(line + 9, "\t");
+    int seconds = 0;
+    sscanf(field, "%u %i", round, &seconds);
+
+    printf("\nQuestion %u (%i seconds)\n", *round, seconds);
+    field = strtok(nullptr, "\t");
+    if (field) printf("%s\n", field);
+    for (int i = 1; (field = strtok(nullptr, "\t")) != nullptr; i++) printf("  %i) %s\n", i, field);
+    printf("Answer 1-4: ");
+    fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    const char* host = (argc > 1) ? argv[1] : "127.0.0.1";
+    uint16_t port = (argc > 2) ? (uint16_t) atoi(argv[2]) : QUIZ_DEFAULT_PORT;
+    std::string name = (argc > 3) ? argv[3] : "Student";
+
+    NetSocket socket = NetConnect(host, port);
+    if (socket == INVALID_NET_SOCKET) {
+        fprintf(stderr, "Could not connect to %s:%u\n", host, port);
+        return 1;
+    }
+    std::string hello = "HELLO " + name + "\n";
+    NetSend(socket, (const uint8_t*) hello.data(), (int) hello.size());
+    printf("Connected to %s:%u as %s, waiting for the first question...\n", host, port, name.c_str());
+
+    unsigned round = 0;
+    char buffer[4096];
+    int bufferSize = 0;
+
+    while (true) {
+        pollfd descriptors[2] = {{(int) socket, POLLIN, 0}, {STDIN_FILENO, POLLIN, 0}};
+        if (poll(descriptors, 2, -1) < 0) break;
+
+        if (descriptors[0].revents) {
+            int received = NetReceive(socket, (uint8_t*) buffer + bufferSize, (int) sizeof(buffer) - 1 - bufferSize);
+            if (received < 0) {
+                printf("\nThe host closed the quiz.\n");
+                break;
+            }
+            bufferSize += received;
+
+            int lineStart = 0;
+            for (int i = 0; i < bufferSize; i++) {
+                if (buffer[i] != '\n') continue;
+                buffer[i] = '\0';
+                char* line = buffer + lineStart;
+                lineStart = i + 1;
+
+                unsigned lineRound = 0;
+                unsigned long long milliseconds = 0;
+                int correct = 0, counts[4] = {0, 0, 0, 0};
+                if (strncmp(line, "QUESTION ", 9) == 0) PrintQuestion(line, &round);
+                else if (sscanf(line, "ACK %u %llu", &lineRound, &milliseconds) == 2) {
+                    printf("Answer received after %.2f s\n", milliseconds / 1000.0);
+                }
+                else if (sscanf(line, "RESULT %u %i %i %i %i %i", &lineRound, &correct, &counts[0], &counts[1], &counts[2], &counts[3]) == 6) {
+                    printf("\nCorrect answer: %i. Votes: %i / %i / %i / %i\n", correct, counts[0], counts[1], counts[2], counts[3]);
+                }
+            }
+            memmove(buffer, buffer + lineStart, bufferSize - lineStart);
+            bufferSize -= lineStart;
+            if (bufferSize >= (int) sizeof(buffer) - 1) bufferSize = 0;
+        }
+
+        if (descriptors[1].revents) {
+            char input[64];
+            if (!fgets(input, sizeof(input), stdin)) break;
+            int choice = atoi(input);
+            if (round == 0 || choice < 1 || choice > 4) {
+                printf("Answer 1-4: ");
+                fflush(stdout);
+                continue;
+            }
+            char answer[48];
+            int size = snprintf(answer, sizeof(answer), "ANSWER %u %i\n", round, choice);
+            NetSend(socket, (const uint8_t*) answer, size);
+        }
+    }
+
+    NetClose(socket);
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Loopback load generator for the classroom quiz host. Runs a QuizHost and N answer clients in this process,
+// then measures each round: how long the host spends fanning the question out, how long until the last client
+// has it, how long until every answer is in, and how many heap allocations the host made along the way.
+//
+//   quiz-loadgen [--clients N] [--rounds N] [--port N] [--budget-ms N]
+//
+// Exits non-zero when the slowest client got a question later than the budget (10 ms by default).
+
+#include <poll.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+#include <sys/resource.h>
+#include "quiz_host.hpp"
+
+static std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+struct LoadClient {
+    NetSocket socket;
+    char buffer[QUIZ_OUTBOUND_SIZE];
+    int bufferSize;
+    uint64_t questionReceivedNs;
+    bool hasQuestion;
+    bool hasAck;
+};
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Reads what has arrived and returns true when a line starting with `prefix` completed
+static bool ReceiveLine(LoadClient& client, const char* prefix) {
+    int received = NetReceive(client.socket, (uint8_t*) client.buffer + client.bufferSize, (int) sizeof(client.buffer) - 1 - client.bufferSize);
+    if (received <= 0) return false;
+    client.bufferSize += received;
+
+    bool found = false;
+    int lineStart = 0;
+    for (int i = 0; i < client.bufferSize; i++) {
+        if (client.buffer[i] != '\n') continue;
+        if (strncmp(client.buffer + lineStart, prefix, strlen(prefix)) == 0) found = true;
+        lineStart = i + 1;
+    }
+    memmove(client.buffer, client.buffer + lineStart, client.bufferSize - lineStart);
+    client.bufferSize -= lineStart;
+    return found;
+}
+
+static double Percentile(std::vector<uint64_t>& values, double fraction) {
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t) (fraction * (values.size() - 1) + 0.5));
+    return values[index] / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int clientCount = 500;
+    int rounds = 5;
+    uint16_t port = QUIZ_DEFAULT_PORT + 1;
+    double budgetMs = 10.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (strcmp(argv[i], "--clients") == 0) clientCount = atoi(value), i++;
+        else if (strcmp(argv[i], "--rounds") == 0) rounds = atoi(value), i++;
+        else if (strcmp(argv[i], "--port") == 0) port = (uint16_t) atoi(value), i++;
+        else if (strcmp(argv[i], "--budget-ms") == 0) budgetMs = atof(value), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--clients N] [--rounds N] [--port N] [--budget-ms N]\n", argv[0]);
+            return 1;
+        }
+    }
+    clientCount = std::max(1, std::min(clientCount, QUIZ_MAX_CLIENTS));
+
+    // Both ends of every connection live in this process
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < (rlim_t) clientCount * 2 + 64) {
+        limit.rlim_cur = std::min(limit.rlim_max, (rlim_t) clientCount * 2 + 64);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    QuizHost host;
+    if (!host.Start(port, QUIZ_MAX_CLIENTS)) return 1;
+
+    std::vector<LoadClient> clients(clientCount);
+    std::vector<pollfd> descriptors(clientCount);
+    for (int i = 0; i < clientCount; i++) {
+        LoadClient& client = clients[i];
+        client.socket = NetConnect("127.0.0.1", port);
+        if (client.socket == INVALID_NET_SOCKET) {
+            fprintf(stderr, "LOADGEN: Client %i failed to connect\n", i + 1);
+            return 1;
+        }
+        client.bufferSize = 0;
+        char hello[32];
+        int size = snprintf(hello, sizeof(hello), "HELLO bot%i\n", i + 1);
+        NetSend(client.socket, (const uint8_t*) hello, size);
+        descriptors[i].fd = (int) client.socket;
+        descriptors[i].events = POLLIN;
+        host.Update(0);
+    }
+    while (host.GetClientCount() < clientCount) host.Update(10);
+    printf("LOADGEN: %i clients connected\n", clientCount);
+
+    std::vector<Question> questions = GetQuestionsVector();
+    std::mt19937 rng(1234);
+    std::vector<uint64_t> latencies;
+    latencies.reserve(clientCount);
+    double worstMs = 0.0;
+
+    for (int round = 1; round <= rounds; round++) {
+        const Question& question = questions[rng() % questions.size()];
+        for (LoadClient& client : clients) client.hasQuestion = client.hasAck = false;
+        latencies.clear();
+
+        uint64_t allocationsBefore = allocationCount;
+        uint64_t startNs = NowNs();
+        uint64_t fanOutNs = host.BroadcastQuestion(question, 20);
+
+        // Drain until every client has the question, the host keeps flushing anything its sockets couldn't take
+        int received = 0;
+        while (received < clientCount) {
+            host.Update(0);
+            if (poll(descriptors.data(), descriptors.size(), 1) <= 0) continue;
+            uint64_t nowNs = NowNs();
+            for (int i = 0; i < clientCount; i++) {
+                if (!descriptors[i].revents || clients[i].hasQuestion) continue;
+                if (ReceiveLine(clients[i], "QUESTION")) {
+                    clients[i].hasQuestion = true;
+                    clients[i].questionReceivedNs = nowNs;
+                    latencies.push_back(nowNs - startNs);
+                    received++;
+                }
+            }
+        }
+
+        // Everyone answers at once, the worst case for the host's read path
+        uint64_t answersStartNs = NowNs();
+        for (int i = 0; i < clientCount; i++) {
+            char answer[32];
+            int size = snprintf(answer, sizeof(answer), "ANSWER %i %u\n", round, (unsigned) (rng() % 4) + 1);
+            NetSend(clients[i].socket, (const uint8_t*) answer, size);
+        }
+        while (host.GetResults().answered < clientCount) host.Update(1);
+        uint64_t collectNs = NowNs() - answersStartNs;
+
+        host.BroadcastResults(question.correctAnswerIndex);
+        uint64_t hostAllocations = allocationCount - allocationsBefore;
+
+        // Clear the ACK and RESULT lines so the next round starts from empty buffers
+        int results = 0;
+        while (results < clientCount) {
+            host.Update(0);
+            if (poll(descriptors.data(), descriptors.size(), 1) <= 0) continue;
+            for (int i = 0; i < clientCount; i++) {
+                if (descriptors[i].revents && !clients[i].hasAck && ReceiveLine(clients[i], "RESULT")) {
+                    clients[i].hasAck = true;
+                    results++;
+                }
+            }
+        }
+
+        std::vector<uint64_t>& sorted = latencies;
+        double p50 = Percentile(sorted, 0.50);
+        double p99 = Percentile(sorted, 0.99);
+        double maxMs = sorted.back() / 1e6;
+        worstMs = std::max(worstMs, maxMs);
+        QuizResults stats = host.GetResults();
+        printf("LOADGEN: Round %i: fan-out %.2f ms, delivered p50 %.2f ms, p99 %.2f ms, max %.2f ms, "
+               "%i answers in %.2f ms, %llu host allocations, votes %i/%i/%i/%i\n",
+               round, fanOutNs / 1e6, p50, p99, maxMs, stats.answered, collectNs / 1e6, (unsigned long long) hostAllocations,
+               stats.counts[0], stats.counts[1], stats.counts[2], stats.counts[3]);
+    }
+
+    for (LoadClient& client : clients) NetClose(client.socket);
+    host.Stop();
+
+    bool withinBudget = worstMs <= budgetMs;
+    printf("LOADGEN: Slowest delivery %.2f ms, budget %.2f ms: %s\n", worstMs, budgetMs, withinBudget ? "OK" : "OVER BUDGET");
+    return withinBudget ? 0 : 1;
+}
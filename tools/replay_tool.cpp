@@ -0,0 +1,69 @@
+// Replays a recorded session without the game window.
+//
+//   replay-tool [--realtime] [--repeat N] [file]      (file defaults to data/last-session.bbr)
+//
+// By default every event is applied as fast as possible; --realtime waits for each event's timestamp and prints
+// rounds as they happen. --repeat plays the log N times and reports the throughput, for regression workloads.
+// Exits non-zero when the replay does not reproduce the final state the session recorded.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "replay.hpp"
+
+static const char* eventNames[REPLAY_EVENT_COUNT] = {
+    "SESSION", "SEED", "PLAYER_NAME", "QUESTION", "ANSWER", "ABILITY", "REMOVED_ANSWERS", "ROUND_END", "FINAL_SCORE", "FINAL_HEALTH"
+};
+
+int main(int argc, char** argv) {
+    const char* fileName = REPLAY_FILE_PATH;
+    bool realtime = false;
+    int repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--realtime") == 0) realtime = true;
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if (argv[i][0] != '-') fileName = argv[i];
+        else {
+            fprintf(stderr, "Usage: %s [--realtime] [--repeat N] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> data;
+    if (!LoadReplayFile(fileName, data) || !ReplayReader(data).IsValid()) {
+        fprintf(stderr, "REPLAY: %s is missing or not a replay\n", fileName);
+        return 1;
+    }
+    std::vector<Question> questions = GetQuestionsVector();
+
+    ReplayOutcome outcome;
+    if (realtime) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        outcome = PlayReplay(data, questions, [&](const ReplayEvent& event, const ReplayOutcome&) {
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(event.timeNs));
+            printf("%10.3f s  %-16s player %i  %lld\n", event.timeNs / 1e9, eventNames[event.type], event.player + 1, (long long) event.value);
+        });
+    } else {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeat; i++) outcome = PlayReplay(data, questions, nullptr);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (repeat > 1) {
+            printf("REPLAY: %i passes in %.3f s, %.0f events/s\n", repeat, seconds, (double) outcome.events * repeat / seconds);
+        }
+    }
+
+    printf("REPLAY: %s, %s, seed %llu, %i rounds, %i events in %zu bytes, %.1f s of play\n", fileName,
+           (outcome.mode == REPLAY_SINGLEPLAYER) ? "singleplayer" : "multiplayer", (unsigned long long) outcome.seed,
+           outcome.rounds, outcome.events, data.size(), outcome.durationNs / 1e9);
+    for (const Player& player : outcome.players) {
+        printf("REPLAY: %-12s score %i, health %i\n", player.name.c_str(), player.score, player.healthPoints);
+    }
+
+    if (!outcome.complete) printf("REPLAY: The log is incomplete, the session did not end normally\n");
+    else printf("REPLAY: Final state %s the recording\n", outcome.matchesRecording ? "matches" : "DOES NOT match");
+    return outcome.matchesRecording ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Fuzz harness for the score log and legacy leaderboard loaders.
+//
+//   score-fuzz [--iterations N] [--seed N] [file...]
+//
+// Standalone it mutates valid logs (bit flips, torn tails, overwritten length fields, spliced records) and checks
+// that loading never crashes, never reports more data than it was given, keeps every record before the first
+// damaged byte, and that re-encoding what it kept loads back identically. Build with -fsanitize=address,undefined
+// (the make target does) to catch out-of-bounds reads. Files given on the command line are loaded once each.
+// Compiling with -DSCORE_FUZZ_LIBFUZZER -fsanitize=fuzzer exposes the same checks to libFuzzer instead.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "score_store.hpp"
+#include "session_random.hpp"
+
+static void Fail(const char* reason, size_t size) {
+    fprintf(stderr, "FUZZ: %s (input of %zu bytes)\n", reason, size);
+    abort();
+}
+
+// Loads arbitrary bytes and checks the invariants that hold for every input
+static void CheckInput(const uint8_t* data, size_t size) {
+    ScoreLogContents contents = ParseScoreLog(data, size);
+    if (contents.validBytes > size || contents.droppedBytes > size) Fail("offsets past the input", size);
+    if (contents.records.size() * 14 > size) Fail("more records than bytes allow", size);
+    for (const ScoreRecord& record : contents.records) {
+        if (record.name.size() > SCORE_NAME_MAX_LENGTH) Fail("name longer than the limit", size);
+    }
+
+    if (contents.valid) {
+        std::vector<uint8_t> encoded = EncodeScoreLog(contents.records);
+        ScoreLogContents again = ParseScoreLog(encoded.data(), encoded.size());
+        if (!again.valid || again.droppedBytes != 0 || again.records.size() != contents.records.size()) Fail("re-encoded log differs", size);
+        for (size_t i = 0; i < again.records.size(); i++) {
+            if (again.records[i].name != contents.records[i].name || again.records[i].score != contents.records[i].score) {
+                Fail("re-encoded record differs", size);
+            }
+        }
+    }
+
+    std::vector<ScoreRecord> legacy;
+    ParseLegacyLeaderboard(data, size, legacy);
+    if (legacy.size() * 8 > size) Fail("more legacy entries than bytes allow", size);
+}
+
+#ifdef SCORE_FUZZ_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    CheckInput(data, size);
+    return 0;
+}
+#else
+static std::vector<ScoreRecord> RandomRecords(SessionRandom& random) {
+    std::vector<ScoreRecord> records(random.Range(0, 40));
+    for (ScoreRecord& record : records) {
+        record.name.resize(random.Range(0, 12));
+        for (char& c : record.name) c = (char) random.Range(32, 126);
+        record.score = random.Range(-5, 500);
+    }
+    return records;
+}
+
+int main(int argc, char** argv) {
+    long iterations = 200000;
+    uint64_t seed = 1;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) iterations = atol(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (argv[i][0] != '-') files.push_back(argv[i]);
+        else {
+            fprintf(stderr, "Usage: %s [--iterations N] [--seed N] [file...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    for (const std::string& file : files) {
+        std::vector<uint8_t> data;
+        if (!ReadWholeFile(file, data)) {
+            fprintf(stderr, "FUZZ: Could not read %s\n", file.c_str());
+            return 1;
+        }
+        CheckInput(data.data(), data.size());
+    }
+
+    SessionRandom random(seed);
+    long recovered = 0;
+    for (long iteration = 0; iteration < iterations; iteration++) {
+        std::vector<ScoreRecord> records = RandomRecords(random);
+        std::vector<uint8_t> data = EncodeScoreLog(records);
+        size_t firstDamaged = data.size();
+
+        int mutations = random.Range(1, 4);
+        for (int m = 0; m < mutations && !data.empty(); m++) {
+            size_t position = random.NextBelow((uint32_t) data.size());
+            switch (random.Range(0, 4)) {
+                case 0: data[position] ^= (uint8_t) (1 << random.Range(0, 7)); break;            // Bit flip
+                case 1: data.resize(position); break;                                             // Torn tail
+                case 2: for (size_t i = position; i < data.size() && i < position + 4; i++) data[i] = 0xFF; break;    // Huge length
+                case 3: data.insert(data.begin() + position, (uint8_t) random.Range(0, 255)); break;
+                default: {                                                                          // Splice a record copy
+                    std::vector<uint8_t> extra = EncodeScoreRecord(ScoreRecord{"splice", 7});
+                    data.insert(data.begin() + position, extra.begin(), extra.begin() + random.NextBelow((uint32_t) extra.size() + 1));
+                    break;
+                }
+            }
+            firstDamaged = std::min(firstDamaged, position);
+        }
+
+        CheckInput(data.data(), data.size());
+
+        // Every record that ends before the first damaged byte must survive
+        if (firstDamaged >= SCORE_LOG_HEADER_SIZE) {
+            ScoreLogContents contents = ParseScoreLog(data.data(), data.size());
+            size_t offset = SCORE_LOG_HEADER_SIZE, intact = 0;
+            for (const ScoreRecord& record : records) {
+                offset += EncodeScoreRecord(record).size();
+                if (offset > firstDamaged) break;
+                intact++;
+            }
+            if (contents.records.size() < intact) Fail("lost records before the damage", data.size());
+            for (size_t i = 0; i < intact; i++) {
+                if (contents.records[i].name != records[i].name || contents.records[i].score != records[i].score) Fail("intact record changed", data.size());
+            }
+            recovered += intact;
+        }
+    }
+
+    printf("FUZZ: %ld mutated logs loaded, %ld intact records recovered, no failures\n", iterations, recovered);
+    return 0;
+}
+#endif
@@ -0,0 +1,89 @@
+// Times adaptive question picks on a synthetic bank and checks they land at the intended success rate.
+//
+//   selector-bench [--questions N] [--picks N] [--seed N]
+//
+// Simulated players of random skill answer every pick with the Rasch probability while their estimate follows
+// their answers, the way a game session does. The uniform picker is shown for comparison.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "question_selector.hpp"
+#include "question_telemetry.hpp"
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct SessionResult {
+    double seconds;
+    double expectedCorrect;    // Mean true probability of a correct answer over the picks
+};
+
+static SessionResult RunPicks(AdaptiveQuestionSelector* selector, const std::vector<float>& difficulties, long picks, uint64_t seed) {
+    SessionRandom random(seed);
+    std::vector<int> history;
+    double expected = 0.0;
+    float skill = 0.0f, ability = 0.0f;
+    int answered = 0;
+
+    uint64_t startNs = NowNs();
+    for (long i = 0; i < picks; i++) {
+        if (i % 30 == 0) {    // A new player every 30 questions
+            skill = (float) (random.NextUnit() * 4.0 - 2.0);
+            ability = 0.0f;
+            answered = 0;
+        }
+        int question = selector ? selector->Pick(random, ability, history, 10)
+                                : random.RangeExcluding(0, (int) difficulties.size() - 1, history);
+        if (!selector) {
+            if (history.size() >= 10) history.erase(history.begin());
+            history.push_back(question);
+        }
+        float probability = ExpectedCorrect(skill, difficulties[question]);
+        bool correct = random.NextUnit() < probability;
+        ability = UpdateAbility(ability, difficulties[question], correct, answered++);
+        expected += probability;
+    }
+    return SessionResult{(NowNs() - startNs) / 1e9, expected / picks};
+}
+
+int main(int argc, char** argv) {
+    long questionCount = 1000000;
+    long picks = 1000000;
+    uint64_t seed = NowNs();
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--questions") == 0 && value) questionCount = std::max(1L, atol(value)), i++;
+        else if (strcmp(argv[i], "--picks") == 0 && value) picks = std::max(1L, atol(value)), i++;
+        else if (strcmp(argv[i], "--seed") == 0 && value) seed = strtoull(value, nullptr, 10), i++;
+        else {
+            fprintf(stderr, "Usage: %s [--questions N] [--picks N] [--seed N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Difficulties spread like a real bank: mostly average, with long tails
+    SessionRandom random(seed);
+    std::vector<float> difficulties(questionCount);
+    for (float& difficulty : difficulties) {
+        double u = 1.0 - random.NextUnit();
+        difficulty = (float) std::max(-4.0, std::min(4.0, 1.2 * std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * random.NextUnit())));
+    }
+
+    uint64_t startNs = NowNs();
+    AdaptiveQuestionSelector selector;
+    selector.Rebuild(difficulties);
+    printf("SELECTOR: %ld questions, rebuilt in %.1f ms, seed %llu\n", questionCount, (NowNs() - startNs) / 1e6, (unsigned long long) seed);
+
+    SessionResult adaptive = RunPicks(&selector, difficulties, picks, seed);
+    SessionResult uniform = RunPicks(nullptr, difficulties, picks, seed);
+    printf("SELECTOR: Adaptive %.0f ns per pick, %.1f%% expected correct (target %.0f%%)\n", adaptive.seconds * 1e9 / picks,
+           100.0 * adaptive.expectedCorrect, 100.0 * SELECTOR_TARGET_SUCCESS);
+    printf("SELECTOR: Uniform  %.0f ns per pick, %.1f%% expected correct\n", uniform.seconds * 1e9 / picks, 100.0 * uniform.expectedCorrect);
+    return 0;
+}
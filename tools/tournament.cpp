@@ -0,0 +1,161 @@
+// Runs round-robins or brackets of bots and recorded players through the game rules on every core, to tune the
+// countdown, the starting health and the abilities before an event.
+//
+//   tournament [--format round-robin|bracket] [--mode singleplayer|multiplayer] [--matches N]
+//              [--player easy|medium|hard|replay:FILE[@player]]... [--countdown S] [--health N] [--no-abilities]
+//              [--threads N] [--seed N] [--question-csv FILE]
+//
+// --matches is per pairing in a round-robin and per series in a bracket. Prints the standings, the ability
+// usage, the per-subject answer rates and the hardest and easiest questions.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "tournament.hpp"
+
+static uint64_t NowNs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void PrintUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [--format round-robin|bracket] [--mode singleplayer|multiplayer] [--matches N]\n"
+                    "       [--player easy|medium|hard|replay:FILE[@player]]... [--countdown S] [--health N] [--no-abilities]\n"
+                    "       [--threads N] [--seed N] [--question-csv FILE]\n", program);
+}
+
+static double Rate(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+int main(int argc, char** argv) {
+    TournamentConfig config{FORMAT_ROUND_ROBIN, MODE_SINGLEPLAYER, GetDefaultGameRules(), 1000, NowNs(), 0};
+    std::vector<std::string> playerSpecs;
+    const char* questionCsv = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(argv[i], "--no-abilities") == 0) config.rules.abilities = false;
+        else if (!value) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        else if (strcmp(argv[i], "--format") == 0 && (strcmp(value, "round-robin") == 0 || strcmp(value, "bracket") == 0)) {
+            config.format = (strcmp(value, "bracket") == 0) ? FORMAT_BRACKET : FORMAT_ROUND_ROBIN, i++;
+        }
+        else if (strcmp(argv[i], "--mode") == 0 && (strcmp(value, "singleplayer") == 0 || strcmp(value, "multiplayer") == 0)) {
+            config.mode = (strcmp(value, "multiplayer") == 0) ? MODE_MULTIPLAYER : MODE_SINGLEPLAYER, i++;
+        }
+        else if (strcmp(argv[i], "--matches") == 0) config.matchesPerPairing = std::max(1L, atol(value)), i++;
+        else if (strcmp(argv[i], "--player") == 0) playerSpecs.push_back(value), i++;
+        else if (strcmp(argv[i], "--countdown") == 0) config.rules.countdownSeconds = std::max(1, atoi(value)), i++;
+        else if (strcmp(argv[i], "--health") == 0) config.rules.startHealth = std::max(1, atoi(value)), i++;
+        else if (strcmp(argv[i], "--threads") == 0) config.threadCount = std::max(0, atoi(value)), i++;
+        else if (strcmp(argv[i], "--seed") == 0) config.seed = strtoull(value, nullptr, 10), i++;
+        else if (strcmp(argv[i], "--question-csv") == 0) questionCsv = value, i++;
+        else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (playerSpecs.empty()) playerSpecs = {"easy", "medium", "hard"};
+
+    std::vector<Question> questions = GetQuestionsVector();
+    std::vector<Entrant> entrants;
+    for (const std::string& spec : playerSpecs) {
+        Entrant entrant;
+        std::string error;
+        if (!ParseEntrant(spec, questions, entrant, error)) {
+            fprintf(stderr, "TOURNAMENT: %s\n", error.c_str());
+            return 1;
+        }
+        entrants.push_back(entrant);
+    }
+    if (entrants.size() < 2) {
+        fprintf(stderr, "TOURNAMENT: Needs at least two players\n");
+        return 1;
+    }
+
+    printf("TOURNAMENT: %s, %s rules, %zu players, %ld matches per %s, countdown %i s, health %i, abilities %s, seed %llu\n",
+           config.format == FORMAT_BRACKET ? "bracket" : "round-robin", config.mode == MODE_MULTIPLAYER ? "multiplayer" : "singleplayer",
+           entrants.size(), config.matchesPerPairing, config.format == FORMAT_BRACKET ? "series" : "pairing",
+           config.rules.countdownSeconds, config.rules.startHealth, config.rules.abilities ? "on" : "off", (unsigned long long) config.seed);
+
+    uint64_t startNs = NowNs();
+    TournamentResult result = RunTournament(config, entrants, questions);
+    double seconds = (NowNs() - startNs) / 1e9;
+
+    for (const std::string& line : result.bracketLog) printf("TOURNAMENT: %s\n", line.c_str());
+
+    printf("\n  #  %-16s %9s %9s %9s %7s %10s\n", "Player", "Won", "Drawn", "Lost", "Win %", "Avg score");
+    for (size_t i = 0; i < result.standings.size(); i++) {
+        const Standing& standing = result.standings[i];
+        printf("%3zu  %-16.16s %9ld %9ld %9ld %6.1f%% %10.2f\n", i + 1, entrants[standing.entrant].name.c_str(),
+               standing.wins, standing.draws, standing.losses, Rate(standing.wins, standing.matches),
+               standing.matches ? (double) standing.totalScore / standing.matches : 0.0);
+    }
+
+    if (config.mode == MODE_SINGLEPLAYER && config.rules.abilities) {
+        static const char* abilityNames[ABILITY_COUNT] = {"Remove two", "Skip", "Bonus health", "Remove one"};
+        printf("\n  %-14s %12s %10s\n", "Ability", "Used", "Paid off");
+        for (int i = 0; i < ABILITY_COUNT; i++) {
+            printf("  %-14s %12ld %9.1f%%\n", abilityNames[i], result.abilityUsed[i], Rate(result.abilityPaidOff[i], result.abilityUsed[i]));
+        }
+    }
+
+    uint64_t categoryAsked[CATEGORY_COUNT] = {0}, categoryCorrect[CATEGORY_COUNT] = {0}, categoryTimeouts[CATEGORY_COUNT] = {0};
+    std::vector<int> ranked;
+    for (int i = 0; i < (int) result.questions.size(); i++) {
+        const QuestionStats& stats = result.questions[i];
+        QuestionCategory category = GetQuestionCategory(i);
+        categoryAsked[category] += stats.asked;
+        categoryCorrect[category] += stats.correct;
+        categoryTimeouts[category] += stats.timeouts;
+        if (stats.asked > 0) ranked.push_back(i);
+    }
+
+    printf("\n  %-10s %12s %9s %9s\n", "Subject", "Asked", "Correct", "Timeout");
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        printf("  %-10s %12llu %8.1f%% %8.1f%%\n", GetQuestionCategoryName((QuestionCategory) i), (unsigned long long) categoryAsked[i],
+               Rate(categoryCorrect[i], categoryAsked[i]), Rate(categoryTimeouts[i], categoryAsked[i]));
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+        const QuestionStats& x = result.questions[a];
+        const QuestionStats& y = result.questions[b];
+        return (double) x.correct / x.asked < (double) y.correct / y.asked;
+    });
+    int shown = std::min(5, (int) ranked.size());
+    printf("\n  Hardest questions\n");
+    for (int i = 0; i < shown; i++) {
+        const QuestionStats& stats = result.questions[ranked[i]];
+        printf("  %5.1f%%  #%-5i %.70s\n", Rate(stats.correct, stats.asked), ranked[i], questions[ranked[i]].questionText.c_str());
+    }
+    printf("  Easiest questions\n");
+    for (int i = 0; i < shown; i++) {
+        int index = ranked[ranked.size() - 1 - i];
+        const QuestionStats& stats = result.questions[index];
+        printf("  %5.1f%%  #%-5i %.70s\n", Rate(stats.correct, stats.asked), index, questions[index].questionText.c_str());
+    }
+
+    if (questionCsv) {
+        FILE* file = fopen(questionCsv, "w");
+        if (!file) {
+            fprintf(stderr, "TOURNAMENT: Could not write %s\n", questionCsv);
+            return 1;
+        }
+        fprintf(file, "question,subject,asked,correct,timeouts,avg_correct_seconds\n");
+        for (int i = 0; i < (int) result.questions.size(); i++) {
+            const QuestionStats& stats = result.questions[i];
+            fprintf(file, "%i,%s,%u,%u,%u,%.3f\n", i, GetQuestionCategoryName(GetQuestionCategory(i)), stats.asked, stats.correct,
+                    stats.timeouts, stats.correct ? stats.correctReactionNs / 1e9 / stats.correct : 0.0);
+        }
+        fclose(file);
+    }
+
+    printf("\nTOURNAMENT: %ld matches (%ld rounds) in %.2f s on %i threads, %.0f matches/s, %llu tasks stolen\n",
+           result.matches, result.rounds, seconds, result.threadCount, result.matches / seconds, (unsigned long long) result.steals);
+    return 0;
+}